@@ -134,7 +134,7 @@ static char const* output_fields[] = {
     "raw",
     NULL};
 
-r_device skylink_motion = {
+r_device const skylink_motion = {
     .name = "Skylink HA-434TL motion sensor",
     .modulation = OOK_PULSE_PPM,
     .short_width = 600, // Divide by 4 from DEBUG ouput
@@ -0,0 +1,898 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  bitbuffer_bench - bitbuffer kernels against their former bit-serial versions
+
+  Checks that bitbuffer_search() returns the same position as the former
+  bit at a time search on random rows and patterns, including patterns
+  longer than 32 bits, rows spilling into the next row and starts past the
+  row end. Then times both on rows of TPMS and wireless M-Bus length, with
+  preambles the FSK decoders search for that are absent from the row or
+  found near its end.
+
+  Then slices synthetic PCM ( NRZ FSK at 17.24 kbps ), PWM, PPM and
+  Manchester pulse trains of random bits, checks the bits the decoder gets,
+  and times the slicers and the run and word appends they use against
+  adding the same bits one at a time. Checks each decoder of a slicing group
+  gets the sliced bits when the ones before change their copy, and times
+  slicing once for a group of four decoders against slicing for each, and
+  the copy of the rows in use against a struct copy of the bitbuffer.
+
+  Then checks bitbuffer_find_repeated_row() and _prefix() against the
+  former row by row count of repeats on random bitbuffers, and times both,
+  and the rubicson, nexus and prologue decoders that use them, on rows of
+  their 36 bit messages, repeated or among noise.
+
+  Last checks and times the table driven Manchester and differential
+  Manchester decoding against the former bit at a time decoding, on rows
+  of TPMS length and longer, with and without a symbol violation.
+
+  usage: bitbuffer_bench [-c checks] [-r repeat] [-s seed]
+
+*/
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "bitbuffer.h"
+#include "decode_ctx.h"
+#include "pulse_data.h"
+#include "pulse_slicer.h"
+
+extern r_device const rubicson;
+extern r_device const nexus;
+extern r_device const prologue;
+}
+
+static int failures = 0;
+
+static uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/*----------------------------- Former versions -----------------------------*/
+
+static inline uint8_t bitAt(const uint8_t* bits, unsigned bit) {
+  return (uint8_t)(bits[bit >> 3] >> (7 - (bit & 7)) & 1);
+}
+
+/**
+ * bitbuffer_search() before the word-at-a-time match
+ */
+static unsigned referenceSearch(bitbuffer_t* bitbuffer, unsigned row, unsigned start,
+                                const uint8_t* pattern, unsigned pattern_bits_len) {
+  uint8_t* bits = bitbuffer->bb[row];
+  unsigned len = bitbuffer->bits_per_row[row];
+  unsigned ipos = start;
+  unsigned ppos = 0; // cursor on init pattern
+
+  while (ipos < len && ppos < pattern_bits_len) {
+    if (bitAt(bits, ipos) == bitAt(pattern, ppos)) {
+      ppos++;
+      ipos++;
+      if (ppos == pattern_bits_len)
+        return ipos - pattern_bits_len;
+    } else {
+      ipos -= ppos;
+      ipos++;
+      ppos = 0;
+    }
+  }
+
+  // Not found
+  return len;
+}
+
+/*----------------------------- Rows -----------------------------*/
+
+/**
+ * One row of random bits, optionally with the pattern at the given position
+ */
+static void makeRow(bitbuffer_t* bits, std::mt19937& rng, unsigned length,
+                    const uint8_t* pattern, unsigned patternLength, unsigned at) {
+  bitbuffer_clear(bits);
+  for (unsigned i = 0; i < length; i++) {
+    int bit = rng() & 1;
+    if (pattern && i >= at && i < at + patternLength) {
+      bit = bitAt(pattern, i - at);
+    }
+    bitbuffer_add_bit(bits, bit);
+  }
+}
+
+static bool checkSearch(int checks, unsigned seed) {
+  std::mt19937 rng(seed);
+  bitbuffer_t* bits = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  uint8_t pattern[9];
+  for (int c = 0; c < checks; c++) {
+    // short rows of few distinct bits find many partial matches
+    unsigned length = 1 + rng() % (c % 4 ? 200 : BITBUF_COLS * 8 * 3);
+    unsigned patternLength = rng() % (c % 8 ? 33 : 72);
+    for (size_t i = 0; i < sizeof(pattern); i++) {
+      pattern[i] = c % 2 ? (rng() & 0x11) * 0x0f : rng();
+    }
+    unsigned at = rng() % (length + 8);
+    makeRow(bits, rng, length, pattern, patternLength, at);
+    unsigned start = rng() % (length + 4);
+    unsigned expected = referenceSearch(bits, 0, start, pattern, patternLength);
+    unsigned found = bitbuffer_search(bits, 0, start, pattern, patternLength);
+    if (found != expected) {
+      fprintf(stderr,
+              "bitbuffer_search: row of %u bits, pattern of %u bits from %u: %u, "
+              "expected %u\n",
+              length, patternLength, start, found, expected);
+      if (++failures > 10) {
+        break;
+      }
+    }
+  }
+  free(bits);
+  return failures == 0;
+}
+
+/*----------------------------- Timing -----------------------------*/
+
+struct Preamble {
+  const char* name;
+  uint8_t bytes[4];
+  unsigned length;
+};
+
+static const Preamble preambles[] = {
+    {"aa2dd4/24", {0xaa, 0x2d, 0xd4}, 24}, // FSK sensors with a 2d d4 sync word
+    {"543d/16", {0x54, 0x3d}, 16}, // wireless M-Bus mode C
+    {"333320/20", {0x33, 0x33, 0x20}, 20}, // Manchester coded TPMS
+    {"cccccccd/32", {0xcc, 0xcc, 0xcc, 0xcd}, 32},
+};
+
+static double nanosPerSearch(bitbuffer_t* bits, const Preamble& preamble, int repeat,
+                             bool reference) {
+  unsigned sink = 0;
+  uint64_t t0 = nowNanos();
+  for (int r = 0; r < repeat; r++) {
+    sink += reference ? referenceSearch(bits, 0, 0, preamble.bytes, preamble.length)
+                      : bitbuffer_search(bits, 0, 0, preamble.bytes, preamble.length);
+  }
+  uint64_t nanos = nowNanos() - t0;
+  volatile unsigned keep = sink;
+  (void)keep;
+  return (double)nanos / repeat;
+}
+
+static void timeSearch(int repeat, unsigned seed) {
+  std::mt19937 rng(seed);
+  bitbuffer_t* bits = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  const unsigned lengths[] = {160, 1600};
+  printf("# %-12s %-6s %-6s %-10s %-10s %s\n", "preamble", "bits", "match", "former ns",
+         "word ns", "speedup");
+  for (unsigned length : lengths) {
+    for (const Preamble& preamble : preambles) {
+      for (int late = 0; late < 2; late++) {
+        // random rows that hold the preamble nowhere, or only near the end
+        do {
+          makeRow(bits, rng, length, preamble.bytes, late ? preamble.length : 0,
+                  length - preamble.length - 8);
+        } while (referenceSearch(bits, 0, 0, preamble.bytes, preamble.length) <
+                 (late ? length - preamble.length - 8 : length));
+        double former = nanosPerSearch(bits, preamble, repeat, true);
+        double word = nanosPerSearch(bits, preamble, repeat, false);
+        printf("  %-12s %-6u %-6s %-10.1f %-10.1f %.1fx\n", preamble.name, length,
+               late ? "late" : "none", former, word, former / word);
+      }
+    }
+  }
+  free(bits);
+}
+
+/*----------------------------- Slicers -----------------------------*/
+
+#define TRAIN_BITS  480 // bits of each synthetic message
+#define TRAIN_RESET 20000 // us of silence after a message
+
+struct Train {
+  const char* name;
+  int (*slicer)(decode_ctx_t*, pulse_data_t const*, r_device*);
+  r_device device;
+  std::vector<uint8_t> bits; // the bits the decoder gets first in its first row
+  pulse_data_t* pulses;
+};
+
+static std::vector<uint8_t> randomBits(std::mt19937& rng, size_t count) {
+  std::vector<uint8_t> bits(count);
+  for (uint8_t& bit : bits) {
+    bit = rng() & 1;
+  }
+  return bits;
+}
+
+/**
+ * Pulses from the widths of alternating high and low levels, starting high
+ */
+static pulse_data_t* makePulses(const std::vector<unsigned>& levels) {
+  pulse_data_t* pulses = pulse_data_alloc(levels.size() / 2 + 1);
+  pulses->sample_rate = 1000000;
+  for (size_t i = 0; i < levels.size(); i++) {
+    if (i % 2 == 0) {
+      pulse_data_set_pulse(pulses, i / 2, levels[i]);
+    } else {
+      pulse_data_set_gap(pulses, i / 2, levels[i]);
+    }
+  }
+  pulses->num_pulses = (levels.size() + 1) / 2;
+  return pulses;
+}
+
+static r_device sliceDevice(const char* name, unsigned modulation, float shortWidth,
+                            float longWidth, float tolerance);
+
+static std::vector<Train> makeTrains(std::mt19937& rng) {
+  std::vector<Train> trains;
+  std::vector<unsigned> levels;
+
+  // PCM NRZ, runs of equal bits, starting and ending with a one
+  Train pcm = {"pcm", pulse_slicer_pcm, sliceDevice("pcm", FSK_PULSE_PCM, 58, 58, 0), {},
+               NULL};
+  pcm.bits = randomBits(rng, TRAIN_BITS);
+  pcm.bits.front() = pcm.bits.back() = 1;
+  levels.clear();
+  for (size_t i = 0; i < pcm.bits.size(); i++) {
+    if (levels.empty() || (levels.size() % 2 == 1) != (pcm.bits[i] == 1)) {
+      levels.push_back(0);
+    }
+    levels.back() += 58;
+  }
+  levels.push_back(TRAIN_RESET);
+  pcm.pulses = makePulses(levels);
+  trains.push_back(pcm);
+
+  // PWM, a short pulse is a one and a long pulse a zero
+  Train pwm = {"pwm", pulse_slicer_pwm, sliceDevice("pwm", OOK_PULSE_PWM, 500, 1000, 150), {},
+               NULL};
+  pwm.bits = randomBits(rng, TRAIN_BITS);
+  levels.clear();
+  for (uint8_t bit : pwm.bits) {
+    levels.push_back(bit ? 500 : 1000);
+    levels.push_back(bit ? 1000 : 500);
+  }
+  levels.back() = TRAIN_RESET;
+  pwm.pulses = makePulses(levels);
+  trains.push_back(pwm);
+
+  // PPM, a short gap is a zero and a long gap a one
+  Train ppm = {"ppm", pulse_slicer_ppm, sliceDevice("ppm", OOK_PULSE_PPM, 1000, 2000, 300), {},
+               NULL};
+  ppm.bits = randomBits(rng, TRAIN_BITS);
+  levels.clear();
+  for (uint8_t bit : ppm.bits) {
+    levels.push_back(500);
+    levels.push_back(bit ? 2000 : 1000);
+  }
+  levels.push_back(500);
+  levels.push_back(TRAIN_RESET);
+  ppm.pulses = makePulses(levels);
+  trains.push_back(ppm);
+
+  // Manchester, a rising edge mid bit is a zero and a falling edge a one,
+  // the first bit is a zero
+  Train manchester = {"manchester", pulse_slicer_manchester_zerobit,
+                      sliceDevice("manchester", OOK_PULSE_MANCHESTER_ZEROBIT, 500, 0, 0), {},
+                      NULL};
+  manchester.bits = randomBits(rng, TRAIN_BITS);
+  manchester.bits.front() = 0;
+  manchester.bits.back() = 0;
+  levels.clear();
+  for (size_t i = 0; i < manchester.bits.size(); i++) {
+    for (int half = 0; half < 2; half++) {
+      bool high = manchester.bits[i] ? half == 0 : half == 1;
+      if (levels.empty() && !high) {
+        continue; // the train starts with the first high level
+      }
+      if (levels.empty() || (levels.size() % 2 == 1) != high) {
+        levels.push_back(0);
+      }
+      levels.back() += 500;
+    }
+  }
+  levels.push_back(TRAIN_RESET);
+  manchester.pulses = makePulses(levels);
+  trains.push_back(manchester);
+  return trains;
+}
+
+static bitbuffer_t sliced;
+
+static int captureBits(r_device*, bitbuffer_t* bits) {
+  sliced = *bits;
+  return 0;
+}
+
+static r_device sliceDevice(const char* name, unsigned modulation, float shortWidth,
+                            float longWidth, float tolerance) {
+  r_device device = {};
+  device.name = name;
+  device.modulation = modulation;
+  device.short_width = shortWidth;
+  device.long_width = longWidth;
+  device.reset_limit = TRAIN_RESET / 2;
+  device.tolerance = tolerance;
+  device.decode_fn = captureBits;
+  return device;
+}
+
+static bool checkSlicers(std::vector<Train>& trains, decode_ctx_t* ctx) {
+  bool ok = true;
+  for (Train& train : trains) {
+    bitbuffer_clear(&sliced);
+    train.slicer(ctx, train.pulses, &train.device);
+    bool match = sliced.num_rows >= 1 && sliced.bits_per_row[0] >= train.bits.size();
+    for (size_t i = 0; match && i < train.bits.size(); i++) {
+      match = bitAt(sliced.bb[0], i) == train.bits[i];
+    }
+    if (!match) {
+      fprintf(stderr, "%s slicer: %u rows, %u bits in the first, expected %zu bits\n",
+              train.name, sliced.num_rows, sliced.bits_per_row[0], train.bits.size());
+      failures++;
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+static void timeSlicers(std::vector<Train>& trains, decode_ctx_t* ctx, int repeat) {
+  printf("# %-12s %-7s %-10s %s\n", "slicer", "pulses", "ns/train", "ns/bit");
+  for (Train& train : trains) {
+    uint64_t t0 = nowNanos();
+    for (int r = 0; r < repeat; r++) {
+      train.slicer(ctx, train.pulses, &train.device);
+    }
+    double nanos = (double)(nowNanos() - t0) / repeat;
+    printf("  %-12s %-7u %-10.0f %.2f\n", train.name, train.pulses->num_pulses, nanos,
+           nanos / train.bits.size());
+  }
+}
+
+/**
+ * Runs of the PCM train added a bit at a time and as runs, the bits of the
+ * PWM train a bit at a time and a word at a time
+ */
+static void timeAppends(const std::vector<Train>& trains, int repeat) {
+  const Train& pcm = trains[0];
+  const Train& pwm = trains[1];
+  std::vector<std::pair<int, unsigned>> runs;
+  for (uint8_t bit : pcm.bits) {
+    if (runs.empty() || runs.back().first != bit) {
+      runs.push_back(std::make_pair(bit, 0u));
+    }
+    runs.back().second++;
+  }
+  bitbuffer_t* bits = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  double former[2] = {0}, bulk[2] = {0};
+  for (int bulkAppend = 0; bulkAppend < 2; bulkAppend++) {
+    uint64_t t0 = nowNanos();
+    for (int r = 0; r < repeat; r++) {
+      bitbuffer_clear(bits);
+      for (const std::pair<int, unsigned>& run : runs) {
+        if (bulkAppend) {
+          bitbuffer_add_bits_run(bits, run.first, run.second);
+        } else {
+          for (unsigned i = 0; i < run.second; i++) {
+            bitbuffer_add_bit(bits, run.first);
+          }
+        }
+      }
+    }
+    (bulkAppend ? bulk : former)[0] = (double)(nowNanos() - t0) / repeat;
+
+    t0 = nowNanos();
+    for (int r = 0; r < repeat; r++) {
+      bitbuffer_clear(bits);
+      uint32_t word = 0;
+      for (size_t i = 0; i < pwm.bits.size(); i++) {
+        if (bulkAppend) {
+          word = word << 1 | pwm.bits[i];
+          if (i % 32 == 31 || i == pwm.bits.size() - 1) {
+            bitbuffer_add_bits_word(bits, word, i % 32 + 1);
+          }
+        } else {
+          bitbuffer_add_bit(bits, pwm.bits[i]);
+        }
+      }
+    }
+    (bulkAppend ? bulk : former)[1] = (double)(nowNanos() - t0) / repeat;
+  }
+  free(bits);
+  printf("# %-12s %-10s %-10s %s\n", "append", "former ns", "bulk ns", "speedup");
+  printf("  %-12s %-10.0f %-10.0f %.1fx\n", "runs", former[0], bulk[0], former[0] / bulk[0]);
+  printf("  %-12s %-10.0f %-10.0f %.1fx\n", "words", former[1], bulk[1], former[1] / bulk[1]);
+}
+
+/*----------------------------- Slicing groups -----------------------------*/
+
+#define GROUP_SIZE 4 // decoders with the same timing in a slicing group
+
+static bitbuffer_t expected;
+
+/**
+ * Checks every decoder of a group gets the bits as sliced, then changes them
+ * as decoders do
+ */
+static int checkGroupBits(r_device* device, bitbuffer_t* bits) {
+  if (memcmp(bits, &expected, sizeof(expected)) != 0) {
+    fprintf(stderr, "%s group: a decoder got bits other than the sliced ones\n", device->name);
+    failures++;
+  }
+  bitbuffer_invert(bits);
+  bits->bits_per_row[0] /= 2;
+  bitbuffer_add_row(bits);
+  bitbuffer_add_bits_word(bits, 0xa5a5a5a5, 32);
+  return 0;
+}
+
+static int discardBits(r_device*, bitbuffer_t*) { return 0; }
+
+/**
+ * Links the copies of a device into a slicing group
+ */
+static void makeGroup(r_device* group, const r_device& device,
+                      int (*decode)(r_device*, bitbuffer_t*)) {
+  for (int i = 0; i < GROUP_SIZE; i++) {
+    group[i] = device;
+    group[i].decode_fn = decode;
+    group[i].slice_next = i + 1 < GROUP_SIZE ? &group[i + 1] : NULL;
+    group[i].slice_follower = i > 0;
+  }
+}
+
+/**
+ * Slices each train for a group on the same context, so the copy of the bits
+ * holds those of the train before
+ */
+static bool checkGroups(std::vector<Train>& trains, decode_ctx_t* ctx) {
+  int before = failures;
+  for (Train& train : trains) {
+    train.slicer(ctx, train.pulses, &train.device);
+    expected = sliced;
+    r_device group[GROUP_SIZE];
+    makeGroup(group, train.device, checkGroupBits);
+    train.slicer(ctx, train.pulses, &group[0]);
+  }
+  return failures == before;
+}
+
+/**
+ * Slicing once for a group of decoders against slicing for each, and the copy
+ * of the rows in use against a struct copy of the bitbuffer
+ */
+static void timeGroups(std::vector<Train>& trains, decode_ctx_t* ctx, int repeat) {
+  printf("# %-12s %-10s %-10s %s\n", "group of 4", "slices ns", "group ns", "speedup");
+  for (Train& train : trains) {
+    r_device single[GROUP_SIZE], group[GROUP_SIZE];
+    makeGroup(group, train.device, discardBits);
+    for (int i = 0; i < GROUP_SIZE; i++) {
+      single[i] = group[i];
+      single[i].slice_next = NULL;
+      single[i].slice_follower = 0;
+    }
+    uint64_t t0 = nowNanos();
+    for (int r = 0; r < repeat; r++) {
+      for (int i = 0; i < GROUP_SIZE; i++) {
+        train.slicer(ctx, train.pulses, &single[i]);
+      }
+    }
+    double slices = (double)(nowNanos() - t0) / repeat;
+    t0 = nowNanos();
+    for (int r = 0; r < repeat; r++) {
+      train.slicer(ctx, train.pulses, &group[0]);
+    }
+    double grouped = (double)(nowNanos() - t0) / repeat;
+    printf("  %-12s %-10.0f %-10.0f %.1fx\n", train.name, slices, grouped, slices / grouped);
+  }
+
+  bitbuffer_t* src = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  bitbuffer_t* dst = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  printf("# %-12s %-10s %-10s %s\n", "copy", "struct ns", "used ns", "speedup");
+  for (Train& train : trains) {
+    train.slicer(ctx, train.pulses, &train.device);
+    *src = sliced;
+    unsigned sink = 0;
+    uint64_t t0 = nowNanos();
+    for (int r = 0; r < repeat; r++) {
+      src->bb[0][0] = (uint8_t)r;
+      *dst = *src;
+      sink += dst->bb[0][0];
+    }
+    double full = (double)(nowNanos() - t0) / repeat;
+    t0 = nowNanos();
+    for (int r = 0; r < repeat; r++) {
+      src->bb[0][0] = (uint8_t)r;
+      bitbuffer_copy_used(dst, src);
+      sink += dst->bb[0][0];
+    }
+    double used = (double)(nowNanos() - t0) / repeat;
+    volatile unsigned keep = sink;
+    (void)keep;
+    printf("  %-12s %-10.0f %-10.0f %.1fx\n", train.name, full, used, full / used);
+  }
+  free(src);
+  free(dst);
+}
+
+/*----------------------------- Repeated rows -----------------------------*/
+
+/**
+ * bitbuffer_find_repeated_row() and _prefix() before the row hash index
+ */
+static int referenceFindRepeated(bitbuffer_t* bits, unsigned minRepeats, unsigned minBits,
+                                 bool prefix) {
+  for (int i = 0; i < bits->num_rows; ++i) {
+    if (bits->bits_per_row[i] >= minBits &&
+        bitbuffer_count_repeats(bits, i, prefix ? minBits : 0) >= minRepeats) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * Rows of 36 bit messages, each a copy of one of a few messages, one of them
+ * with other trailing bits, truncated or random noise
+ */
+static void makeRepeats(bitbuffer_t* bits, std::mt19937& rng, unsigned rows,
+                        unsigned noiseRows, unsigned messages) {
+  uint64_t message[4];
+  for (uint64_t& m : message) {
+    m = ((uint64_t)rng() << 32 | rng()) & 0xfffffffffull;
+  }
+  bitbuffer_clear(bits);
+  for (unsigned r = 0; r < rows; r++) {
+    if (r) {
+      bitbuffer_add_row(bits);
+    }
+    uint64_t row = message[rng() % messages];
+    unsigned length = 36;
+    if (r < noiseRows) {
+      row = ((uint64_t)rng() << 32 | rng()) & 0xfffffffffull;
+      length = 1 + rng() % 40;
+    } else if (rng() % 8 == 0) {
+      row ^= rng() % 4; // same prefix, other trailing bits
+    } else if (rng() % 8 == 0) {
+      length = 24 + rng() % 12;
+    }
+    for (unsigned i = length; i > 0; i--) {
+      bitbuffer_add_bit(bits, (int)(row >> (36 - length + i - 1) & 1));
+    }
+  }
+}
+
+static bool checkRepeats(int checks, unsigned seed) {
+  std::mt19937 rng(seed);
+  bitbuffer_t* bits = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  for (int c = 0; c < checks && failures <= 10; c++) {
+    unsigned rows = 1 + rng() % BITBUF_ROWS;
+    makeRepeats(bits, rng, rows, rng() % (rows + 1), 1 + rng() % 4);
+    unsigned minRepeats = rng() % 6;
+    unsigned minBits = rng() % 40;
+    for (int prefix = 0; prefix < 2; prefix++) {
+      int expected = referenceFindRepeated(bits, minRepeats, minBits, prefix);
+      int found = prefix ? bitbuffer_find_repeated_prefix(bits, minRepeats, minBits)
+                         : bitbuffer_find_repeated_row(bits, minRepeats, minBits);
+      if (found != expected) {
+        fprintf(stderr, "bitbuffer_find_repeated_%s: %u rows, %u repeats of %u bits: %d, expected %d\n",
+                prefix ? "prefix" : "row", rows, minRepeats, minBits, found, expected);
+        failures++;
+      }
+    }
+  }
+  free(bits);
+  return failures == 0;
+}
+
+static void discardData(r_device*, data_t* data) { data_free(data); }
+
+static void timeRepeats(int repeat, unsigned seed) {
+  std::mt19937 rng(seed);
+  bitbuffer_t* bits = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  bitbuffer_t* copy = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  struct Case {
+    const char* name;
+    unsigned rows;
+    unsigned noiseRows;
+  };
+  const Case cases[] = {
+      {"12 repeats", 12, 0}, // a sensor message as the slicer passes it
+      {"25 noise", 25, 25}, // the same slicer run on noise
+      {"noise+3", 28, 25}, // the message after noise
+      {"50 noise", BITBUF_ROWS, BITBUF_ROWS},
+  };
+  const r_device* decoders[] = {&rubicson, &nexus, &prologue};
+  r_device devices[3];
+  for (int d = 0; d < 3; d++) {
+    devices[d] = *decoders[d];
+    devices[d].output_fn = discardData;
+  }
+  printf("# %-12s %-10s %-10s %-8s %-11s %-11s %s\n", "rows", "former ns", "hash ns", "speedup",
+         "rubicson ns", "nexus ns", "prologue ns");
+  for (const Case& c : cases) {
+    makeRepeats(bits, rng, c.rows, c.noiseRows, 1);
+    double nanos[2];
+    for (int hashed = 0; hashed < 2; hashed++) {
+      int sink = 0;
+      uint64_t t0 = nowNanos();
+      for (int r = 0; r < repeat; r++) {
+        sink += hashed ? bitbuffer_find_repeated_row(bits, 3, 36)
+                       : referenceFindRepeated(bits, 3, 36, false);
+      }
+      nanos[hashed] = (double)(nowNanos() - t0) / repeat;
+      volatile int keep = sink;
+      (void)keep;
+    }
+    double decoderNanos[3];
+    for (int d = 0; d < 3; d++) {
+      uint64_t spent = 0;
+      for (int r = 0; r < repeat; r++) {
+        *copy = *bits; // the decoders may change the bits
+        uint64_t t0 = nowNanos();
+        devices[d].decode_fn(&devices[d], copy);
+        spent += nowNanos() - t0;
+      }
+      decoderNanos[d] = (double)spent / repeat;
+    }
+    printf("  %-12s %-10.0f %-10.0f %-8.1f %-11.0f %-11.0f %.0f\n", c.name, nanos[0], nanos[1],
+           nanos[0] / nanos[1], decoderNanos[0], decoderNanos[1], decoderNanos[2]);
+  }
+  free(copy);
+  free(bits);
+}
+
+/*----------------------------- Manchester -----------------------------*/
+
+/**
+ * bitbuffer_manchester_decode() before the table
+ */
+static unsigned referenceManchester(bitbuffer_t* inbuf, unsigned start, bitbuffer_t* outbuf,
+                                    unsigned max) {
+  uint8_t* bits = inbuf->bb[0];
+  unsigned len = inbuf->bits_per_row[0];
+  unsigned ipos = start;
+  if (max && len > start + (max * 2))
+    len = start + (max * 2);
+  while (ipos < len) {
+    uint8_t bit1 = bitAt(bits, ipos++);
+    uint8_t bit2 = bitAt(bits, ipos++);
+    if (bit1 == bit2)
+      break;
+    bitbuffer_add_bit(outbuf, bit2);
+  }
+  return ipos;
+}
+
+/**
+ * bitbuffer_differential_manchester_decode() before the table
+ */
+static unsigned referenceDifferential(bitbuffer_t* inbuf, unsigned start, bitbuffer_t* outbuf,
+                                      unsigned max) {
+  uint8_t* bits = inbuf->bb[0];
+  unsigned len = inbuf->bits_per_row[0];
+  unsigned ipos = start;
+  uint8_t bit1, bit2 = 0;
+  if (max && len > start + (max * 2))
+    len = start + (max * 2);
+  // the first long pulse will determine the clock
+  while (ipos < len) {
+    bit1 = bitAt(bits, ipos++);
+    bit2 = bitAt(bits, ipos++);
+    uint8_t bit3 = bitAt(bits, ipos);
+    if (bit1 != bit2) {
+      if (bit2 != bit3) {
+        bitbuffer_add_bit(outbuf, 0);
+      } else {
+        bit2 = bit1;
+        ipos -= 1;
+        break;
+      }
+    } else {
+      bit2 = 1 - bit1;
+      ipos -= 2;
+      break;
+    }
+  }
+  while (ipos < len) {
+    bit1 = bitAt(bits, ipos++);
+    if (bit1 == bit2)
+      break; // clock missing, abort
+    bit2 = bitAt(bits, ipos++);
+    bitbuffer_add_bit(outbuf, bit1 == bit2 ? 1 : 0);
+  }
+  return ipos;
+}
+
+/**
+ * One row of Manchester or differential Manchester coded random bits, a
+ * symbol violation at the given symbol, none if past the end
+ */
+static void makeSymbols(bitbuffer_t* bits, std::mt19937& rng, unsigned symbols,
+                        bool differential, unsigned violation) {
+  bitbuffer_clear(bits);
+  int level = 0;
+  for (unsigned i = 0; i < symbols; i++) {
+    int bit = rng() & 1;
+    if (differential) {
+      level = i == violation ? level : !level; // clock
+      bitbuffer_add_bit(bits, level);
+      level = bit ? level : !level;
+      bitbuffer_add_bit(bits, level);
+    } else {
+      bitbuffer_add_bit(bits, i == violation ? bit : !bit);
+      bitbuffer_add_bit(bits, bit);
+    }
+  }
+}
+
+static unsigned decodeSymbols(bitbuffer_t* in, bitbuffer_t* out, bool differential,
+                              bool reference, unsigned start, unsigned max) {
+  if (differential) {
+    return reference ? referenceDifferential(in, start, out, max)
+                     : bitbuffer_differential_manchester_decode(in, 0, start, out, max);
+  }
+  return reference ? referenceManchester(in, start, out, max)
+                   : bitbuffer_manchester_decode(in, 0, start, out, max);
+}
+
+static bool checkManchester(int checks, unsigned seed) {
+  std::mt19937 rng(seed);
+  bitbuffer_t* in = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  bitbuffer_t* out = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  bitbuffer_t* reference = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  for (int c = 0; c < checks && failures <= 10; c++) {
+    bool differential = c % 2;
+    unsigned symbols = rng() % (c % 8 ? 200 : BITBUF_COLS * 6);
+    makeSymbols(in, rng, symbols, differential, rng() % (symbols * 2 + 1));
+    if (rng() % 4 == 0) {
+      bitbuffer_add_bit(in, rng() & 1); // an odd last bit
+    }
+    unsigned start = rng() % 8;
+    unsigned max = rng() % 3 ? 0 : rng() % (symbols + 1);
+    bitbuffer_clear(out);
+    bitbuffer_clear(reference);
+    unsigned pos = decodeSymbols(in, out, differential, false, start, max);
+    unsigned expected = decodeSymbols(in, reference, differential, true, start, max);
+    if (pos != expected || memcmp(out, reference, sizeof(bitbuffer_t))) {
+      fprintf(stderr, "%s decode of %u symbols from %u: %u bits to %u, expected %u bits to %u\n",
+              differential ? "differential Manchester" : "Manchester", symbols, start,
+              out->bits_per_row[0], pos, reference->bits_per_row[0], expected);
+      failures++;
+    }
+  }
+  free(reference);
+  free(out);
+  free(in);
+  return failures == 0;
+}
+
+static void timeManchester(int repeat, unsigned seed) {
+  std::mt19937 rng(seed);
+  bitbuffer_t* in = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  bitbuffer_t* out = (bitbuffer_t*)calloc(1, sizeof(bitbuffer_t));
+  const unsigned lengths[] = {80, 800};
+  printf("# %-13s %-8s %-10s %-10s %-10s %s\n", "code", "symbols", "violation", "former ns",
+         "table ns", "speedup");
+  for (int differential = 0; differential < 2; differential++) {
+    for (unsigned symbols : lengths) {
+      for (int violation = 0; violation < 2; violation++) {
+        makeSymbols(in, rng, symbols, differential, violation ? symbols / 2 : symbols);
+        double nanos[2];
+        for (int table = 0; table < 2; table++) {
+          uint64_t t0 = nowNanos();
+          for (int r = 0; r < repeat; r++) {
+            out->num_rows = 0;
+            out->free_row = 0;
+            out->bits_per_row[0] = 0;
+            memset(out->bb[0], 0, (symbols + 7) / 8);
+            decodeSymbols(in, out, differential, !table, 0, 0);
+          }
+          nanos[table] = (double)(nowNanos() - t0) / repeat;
+        }
+        printf("  %-13s %-8u %-10s %-10.0f %-10.0f %.1fx\n",
+               differential ? "differential" : "manchester", symbols,
+               violation ? "middle" : "none", nanos[0], nanos[1], nanos[0] / nanos[1]);
+      }
+    }
+  }
+  free(out);
+  free(in);
+}
+
+/*----------------------------- Main -----------------------------*/
+
+static void usage() {
+  fprintf(stderr,
+          "usage: bitbuffer_bench [-c checks] [-r repeat] [-s seed]\n"
+          "  -c  number of random rows checked against the former version (default 100000)\n"
+          "  -r  number of timed searches of each row (default 20000)\n"
+          "  -s  seed of the random rows\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int checks = 100000;
+  int repeat = 20000;
+  unsigned seed = 433;
+  int opt;
+  while ((opt = getopt(argc, argv, "c:r:s:h")) != -1) {
+    switch (opt) {
+      case 'c':
+        checks = atoi(optarg);
+        break;
+      case 'r':
+        repeat = atoi(optarg) > 0 ? atoi(optarg) : 1;
+        break;
+      case 's':
+        seed = strtoul(optarg, NULL, 10);
+        break;
+      default:
+        usage();
+    }
+  }
+
+  if (!checkSearch(checks, seed)) {
+    return 1;
+  }
+  printf("# bitbuffer_search matches the former version on %d rows\n", checks);
+  timeSearch(repeat, seed);
+
+  std::mt19937 rng(seed);
+  std::vector<Train> trains = makeTrains(rng);
+  decode_ctx_t* ctx = decode_ctx_create();
+  if (!checkSlicers(trains, ctx)) {
+    return 1;
+  }
+  printf("# the slicers pass the bits of the synthetic trains\n");
+  timeSlicers(trains, ctx, repeat / 10 + 1);
+  timeAppends(trains, repeat / 10 + 1);
+  if (!checkGroups(trains, ctx)) {
+    return 1;
+  }
+  printf("# every decoder of a slicing group gets the sliced bits\n");
+  timeGroups(trains, ctx, repeat / 10 + 1);
+  decode_ctx_free(ctx);
+  for (Train& train : trains) {
+    free(train.pulses);
+  }
+
+  if (!checkRepeats(checks / 10, seed)) {
+    return 1;
+  }
+  printf("# bitbuffer_find_repeated_row and _prefix match the former version on %d bitbuffers\n",
+         checks / 10);
+  timeRepeats(repeat / 10 + 1, seed);
+
+  if (!checkManchester(checks / 10, seed)) {
+    return 1;
+  }
+  printf("# Manchester and differential Manchester decoding match the former version on %d rows\n",
+         checks / 10);
+  timeManchester(repeat / 10 + 1, seed);
+  return 0;
+}
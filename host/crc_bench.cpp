@@ -0,0 +1,203 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  crc_bench - table-driven CRC and LFSR checks against the bit-serial ones
+
+  Runs every CRC polynomial and LFSR generator and key the device decoders
+  under src/rtl_433/devices use, on random messages of the length the
+  decoders check, through the bit-serial function in util.c and its _table
+  variant in crc_table.c. Fails if they differ, and reports the time of
+  each.
+
+  usage: crc_bench [-r repeat] [-s seed]
+
+*/
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "crc_table.h"
+#include "util.h"
+}
+
+#define MESSAGES 64
+
+static uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+enum Function {
+  CRC4,
+  CRC8,
+  CRC8LE,
+  CRC16,
+  CRC16LSB,
+  LFSR_DIGEST8,
+  LFSR_DIGEST8_REFLECT,
+  LFSR_DIGEST16,
+};
+
+static const char* const functionNames[] = {
+    "crc4", "crc8", "crc8le", "crc16", "crc16lsb", "lfsr_digest8", "lfsr_digest8_reflect",
+    "lfsr_digest16",
+};
+
+struct Check {
+  Function function;
+  uint16_t poly; // or LFSR generator
+  uint16_t init; // or LFSR key
+  unsigned bytes;
+  const char* devices;
+};
+
+// grep -E "crc|lfsr_digest" src/rtl_433/devices/*.c
+static const Check checks[] = {
+    {CRC4, 0x3, 0x0, 4, "esperanza_ews, kedsum, s3318p"},
+    {CRC4, 0x13, 0x0, 4, "infactory"},
+    {CRC4, 0x9, 0x1, 5, "philips_aj3650"},
+    {CRC8, 0x07, 0x00, 8, "archos_tbh, enocean_erp1, hideki, schraeder, tpms_*"},
+    {CRC8, 0x13, 0x00, 8, "tpms_pmv107j"},
+    {CRC8, 0x31, 0x00, 8, "fineoffset*, lacrosse_*, ambientweather_wh31e, ..."},
+    {CRC8, 0x80, 0x00, 3, "calibeur"},
+    {CRC8, 0x01, 0x01, 8, "srsmith_pool_srs_2c_tx"},
+    {CRC8LE, 0x07, 0x00, 6, "acurite"},
+    {CRC8LE, 0x31, 0x00, 8, "cavius, oil_smart, oil_watchman"},
+    {CRC8LE, 0xf5, 0x3d, 5, "dsc"},
+    {CRC16, 0x1021, 0x0000, 10, "ant_antplus, danfoss, efergy_optical, ert_idm, govee, ..."},
+    {CRC16, 0x3d65, 0x0000, 16, "badger_water, m_bus"},
+    {CRC16, 0x6f63, 0x0000, 10, "ert_scm"},
+    {CRC16, 0x8005, 0xffff, 10, "archos_tbh, flowis, honeywell, ikea_sparsnas, ..."},
+    {CRC16, 0x8050, 0x0000, 4, "honeywell"},
+    {CRC16LSB, 0x00b2, 0x00d0, 11, "acurite"},
+    {CRC16LSB, 0x8408, 0xffff, 12, "radiohead_ask, somfy_iohc"},
+    {CRC16LSB, 0xa001, 0xffff, 10, "emontx, inkbird_ith20r"},
+    {LFSR_DIGEST8, 0x98, 0xf1, 3, "acurite"},
+    {LFSR_DIGEST8, 0x98, 0x3e, 5, "ambient_weather"},
+    {LFSR_DIGEST8_REFLECT, 0x31, 0xf4, 4, "lacrosse_tx141x, burnhardbbq, tfa_30_3221, ..."},
+    {LFSR_DIGEST8_REFLECT, 0x31, 0x31, 7, "sharp_spc775, tfa_marbella"},
+    {LFSR_DIGEST8_REFLECT, 0x51, 0x04, 4, "thermopro_tp11, thermopro_tp12"},
+    {LFSR_DIGEST16, 0x8810, 0x5412, 15, "bresser_6in1"},
+    {LFSR_DIGEST16, 0x8810, 0xba95, 23, "bresser_7in1"},
+    {LFSR_DIGEST16, 0x8810, 0xdd38, 3, "maverick_et73x"},
+    {LFSR_DIGEST16, 0x8810, 0x0d42, 3, "maverick_xr30, tfa_14_1504_v2"},
+    {LFSR_DIGEST16, 0x8810, 0x22d0, 4, "tfa_30_3196"},
+};
+
+static unsigned run(const Check& check, const uint8_t* message, bool table) {
+  switch (check.function) {
+    case CRC4:
+      return table ? crc4_table(message, check.bytes, check.poly, check.init)
+                   : crc4(message, check.bytes, check.poly, check.init);
+    case CRC8:
+      return table ? crc8_table(message, check.bytes, check.poly, check.init)
+                   : crc8(message, check.bytes, check.poly, check.init);
+    case CRC8LE:
+      return table ? crc8le_table(message, check.bytes, check.poly, check.init)
+                   : crc8le(message, check.bytes, check.poly, check.init);
+    case CRC16:
+      return table ? crc16_table(message, check.bytes, check.poly, check.init)
+                   : crc16(message, check.bytes, check.poly, check.init);
+    case CRC16LSB:
+      return table ? crc16lsb_table(message, check.bytes, check.poly, check.init)
+                   : crc16lsb(message, check.bytes, check.poly, check.init);
+    case LFSR_DIGEST8:
+      return table ? lfsr_digest8_table(message, check.bytes, check.poly, check.init)
+                   : lfsr_digest8(message, check.bytes, check.poly, check.init);
+    case LFSR_DIGEST8_REFLECT:
+      return table ? lfsr_digest8_reflect_table(message, check.bytes, check.poly, check.init)
+                   : lfsr_digest8_reflect(message, check.bytes, check.poly, check.init);
+    case LFSR_DIGEST16:
+      return table ? lfsr_digest16_table(message, check.bytes, check.poly, check.init)
+                   : lfsr_digest16(message, check.bytes, check.poly, check.init);
+  }
+  return 0;
+}
+
+static double nanosPerCheck(const Check& check, const std::vector<uint8_t>& messages,
+                            int repeat, bool table) {
+  unsigned sink = 0;
+  uint64_t t0 = nowNanos();
+  for (int r = 0; r < repeat; r++) {
+    for (size_t m = 0; m < MESSAGES; m++) {
+      sink += run(check, &messages[m * check.bytes], table);
+    }
+  }
+  uint64_t nanos = nowNanos() - t0;
+  volatile unsigned keep = sink;
+  (void)keep;
+  return (double)nanos / repeat / MESSAGES;
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: crc_bench [-r repeat] [-s seed]\n"
+          "  -r  number of timed runs over the messages of each check (default 2000)\n"
+          "  -s  seed of the random messages\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int repeat = 2000;
+  unsigned seed = 433;
+  int opt;
+  while ((opt = getopt(argc, argv, "r:s:h")) != -1) {
+    switch (opt) {
+      case 'r':
+        repeat = atoi(optarg) > 0 ? atoi(optarg) : 1;
+        break;
+      case 's':
+        seed = strtoul(optarg, NULL, 10);
+        break;
+      default:
+        usage();
+    }
+  }
+
+  std::mt19937 rng(seed);
+  int failures = 0;
+  printf("# %-21s %-6s %-6s %-5s %-10s %-10s %-7s %s\n", "function", "poly", "init", "bytes",
+         "serial ns", "table ns", "speedup", "devices");
+  for (const Check& check : checks) {
+    std::vector<uint8_t> messages(MESSAGES * check.bytes);
+    for (uint8_t& byte : messages) {
+      byte = rng();
+    }
+    for (size_t m = 0; m < MESSAGES; m++) {
+      unsigned serial = run(check, &messages[m * check.bytes], false);
+      unsigned table = run(check, &messages[m * check.bytes], true);
+      if (serial != table) {
+        fprintf(stderr, "%s poly 0x%04x init 0x%04x: 0x%04x by table, expected 0x%04x\n",
+                functionNames[check.function], check.poly, check.init, table, serial);
+        failures++;
+        break;
+      }
+    }
+    double serial = nanosPerCheck(check, messages, repeat, false);
+    double table = nanosPerCheck(check, messages, repeat, true);
+    printf("  %-21s 0x%04x 0x%04x %-5u %-10.1f %-10.1f %-7.1f %s\n",
+           functionNames[check.function], check.poly, check.init, check.bytes, serial, table,
+           serial / table, check.devices);
+  }
+  return failures ? 1 : 0;
+}
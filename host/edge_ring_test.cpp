@@ -0,0 +1,254 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  edge_ring_test - EdgeRing and PulseAssembler on synthetic edge streams
+
+  Checks the ring keeps order and counts drops, and that edges passed
+  through the ring from another thread assemble into the same pulse train
+  as the former interrupt handler built in place. Then reports the cost per
+  edge of the push and of the assembly.
+
+  usage: edge_ring_test [edges]
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "pulseAssembler.h"
+
+#define MIN_PULSE_LENGTH 50
+
+static int failures = 0;
+
+#define CHECK(cond)                                                   \
+  do {                                                                \
+    if (!(cond)) {                                                    \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      failures++;                                                     \
+    }                                                                 \
+  } while (0)
+
+static uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * Edges of a synthetic OOK signal: pulses and gaps of 100 to 2000 us, with
+ * glitches shorter than the minimum pulse length and the odd long gap
+ */
+static std::vector<edge_t> makeEdges(size_t count, uint32_t start, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint32_t> width(100, 2000);
+  std::uniform_int_distribution<uint32_t> glitch(1, MIN_PULSE_LENGTH);
+  std::uniform_int_distribution<int> dice(0, 99);
+  std::vector<edge_t> edges;
+  uint32_t time = start;
+  uint32_t level = 1;
+  while (edges.size() < count) {
+    int roll = dice(rng);
+    if (roll < 10) {
+      // glitch, a pair of edges close together
+      time += glitch(rng);
+      edges.push_back({time, !level});
+      time += glitch(rng);
+      edges.push_back({time, level});
+      continue;
+    }
+    time += roll < 12 ? 70000 : width(rng);
+    edges.push_back({time, level});
+    level = !level;
+  }
+  return edges;
+}
+
+/**
+ * The former interrupt handler, building the train in place
+ */
+static int referenceAssemble(pulse_data_t* train, const std::vector<edge_t>& edges,
+                             uint32_t start) {
+  int nrpulses = 0;
+  uint32_t lastChange = start;
+  train->pulse[0] = 0;
+  train->gap[0] = 0;
+  train->num_long = 0;
+  for (const edge_t& edge : edges) {
+    const unsigned int duration = edge.time - lastChange;
+    if (duration > MIN_PULSE_LENGTH) {
+      if (!edge.level) {
+        pulse_data_set_pulse(train, nrpulses, duration);
+      } else {
+        if (train->pulse[nrpulses] > 0) {
+          pulse_data_set_gap(train, nrpulses, duration);
+          nrpulses = (uint16_t)((nrpulses + 1) % PD_MAX_PULSES);
+          train->pulse[nrpulses] = 0;
+          train->gap[nrpulses] = 0;
+        } else if (nrpulses > 1) {
+          pulse_data_set_gap(train, nrpulses - 1,
+                             pulse_data_gap(train, nrpulses - 1) + duration);
+        } else {
+          pulse_data_set_gap(train, nrpulses, duration);
+          nrpulses = (uint16_t)((nrpulses + 1) % PD_MAX_PULSES);
+          train->pulse[nrpulses] = 0;
+          train->gap[nrpulses] = 0;
+        }
+      }
+      lastChange = edge.time;
+    }
+  }
+  return nrpulses;
+}
+
+static bool sameTrain(const pulse_data_t* a, const pulse_data_t* b, int pulses) {
+  for (int i = 0; i <= pulses; i++) {
+    if (pulse_data_pulse(a, i) != pulse_data_pulse(b, i) ||
+        pulse_data_gap(a, i) != pulse_data_gap(b, i)) {
+      fprintf(stderr, "pulse %d: +%d-%d, expected +%d-%d\n", i,
+              pulse_data_pulse(a, i), pulse_data_gap(a, i),
+              pulse_data_pulse(b, i), pulse_data_gap(b, i));
+      return false;
+    }
+  }
+  return true;
+}
+
+static void testRingOrderAndDrops() {
+  static EdgeRing<16> ring;
+  edge_t edge;
+  CHECK(!ring.pop(edge));
+  for (uint32_t i = 0; i < 20; i++) {
+    CHECK(ring.push(i, i & 1) == (i < 16));
+  }
+  CHECK(ring.size() == 16);
+  CHECK(ring.dropped() == 4);
+  for (uint32_t i = 0; i < 16; i++) {
+    CHECK(ring.pop(edge) && edge.time == i && edge.level == (i & 1));
+  }
+  CHECK(!ring.pop(edge));
+
+  // indices keep running past the size
+  for (uint32_t i = 0; i < 100; i++) {
+    CHECK(ring.push(i, 0));
+    CHECK(ring.pop(edge) && edge.time == i);
+  }
+  ring.push(1, 0);
+  ring.clear();
+  CHECK(ring.size() == 0);
+}
+
+static void testAssembly(size_t count) {
+  const uint32_t start = 0xfffff000; // micros() wraps during the signal
+  std::vector<edge_t> edges = makeEdges(count, start, 433);
+
+  pulse_data_t* expected = pulse_data_alloc(PD_MAX_PULSES);
+  pulse_data_t* train = pulse_data_alloc(PD_MAX_PULSES);
+  if (!expected || !train) {
+    fprintf(stderr, "out of memory\n");
+    exit(2);
+  }
+  int expectedPulses = referenceAssemble(expected, edges, start);
+
+  // single threaded
+  static EdgeRing<256> ring;
+  PulseAssembler assembler(MIN_PULSE_LENGTH);
+  assembler.start(train, start);
+  for (const edge_t& edge : edges) {
+    ring.push(edge.time, edge.level);
+    assembler.drain(ring, -80);
+  }
+  CHECK(assembler.pulses() == expectedPulses);
+  CHECK(sameTrain(train, expected, expectedPulses));
+
+  // producer thread standing in for the interrupt, the consumer drains as the
+  // receiver task does, nothing may be lost while the producer waits for room
+  memset(train->pulse, 0xaa, PD_MAX_PULSES * sizeof(*train->pulse));
+  assembler.start(train, start);
+  std::thread producer([&edges]() {
+    for (const edge_t& edge : edges) {
+      while (ring.size() == ring.capacity()) {
+        std::this_thread::yield();
+      }
+      ring.push(edge.time, edge.level);
+    }
+  });
+  size_t popped = 0;
+  while (popped < edges.size()) {
+    popped += assembler.drain(ring, -80);
+  }
+  producer.join();
+  CHECK(ring.dropped() == 0);
+  CHECK(assembler.pulses() == expectedPulses);
+  CHECK(sameTrain(train, expected, expectedPulses));
+  printf("# %zu edges assembled into %d pulses\n", edges.size(), expectedPulses + 1);
+
+  free(expected);
+  free(train);
+}
+
+static void benchmark(size_t count) {
+  std::vector<edge_t> edges = makeEdges(count, 0, 868);
+  pulse_data_t* train = pulse_data_alloc(PD_MAX_PULSES);
+  if (!train) {
+    fprintf(stderr, "out of memory\n");
+    exit(2);
+  }
+  static EdgeRing<256> ring;
+  PulseAssembler assembler(MIN_PULSE_LENGTH);
+  assembler.start(train, 0);
+
+  // the interrupt side alone, a burst of up to a ring full of edges per tick
+  uint64_t pushNanos = 0;
+  uint64_t drainNanos = 0;
+  for (size_t i = 0; i < edges.size();) {
+    size_t burst = std::min<size_t>(ring.capacity(), edges.size() - i);
+    uint64_t t0 = nowNanos();
+    for (size_t j = 0; j < burst; j++, i++) {
+      ring.push(edges[i].time, edges[i].level);
+    }
+    uint64_t t1 = nowNanos();
+    assembler.drain(ring, -80);
+    drainNanos += nowNanos() - t1;
+    pushNanos += t1 - t0;
+  }
+  printf("# %zu edges: push %.1f ns/edge, assemble %.1f ns/edge\n",
+         edges.size(), (double)pushNanos / edges.size(),
+         (double)drainNanos / edges.size());
+  free(train);
+}
+
+int main(int argc, char** argv) {
+  // stay below PD_MAX_PULSES pulses, the train wraps beyond
+  size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000;
+
+  testRingOrderAndDrops();
+  testAssembly(count);
+  benchmark(100 * count);
+
+  if (failures) {
+    fprintf(stderr, "%d checks failed\n", failures);
+    return 1;
+  }
+  printf("edge ring tests passed\n");
+  return 0;
+}
@@ -0,0 +1,258 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  gate_bench - tune the SignalGate holdover and threshold on RSSI traces
+
+  Replays an RSSI trace, one sample per receiver tick, through SignalGate
+  for every combination of holdover, holdover start and threshold delta,
+  and scores the committed signals against the transmissions marked in the
+  trace. The trace is read from a file or generated: OOK transmissions of
+  repeated packets with carrier off samples inside the packets, signals from
+  other sensors close behind, and short bursts of interference. Before the
+  sweep the gate is checked against the start / end logic the receiver task
+  used before it was factored out.
+
+  The trace format is described in rssi_trace.h.
+
+  usage: gate_bench [-g count] [-s seed] [-w file] [-H holdovers]
+                    [-A holdover starts] [-t deltas] [-m min_length]
+                    [-l tolerance] [file]
+
+*/
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "rssi_trace.h"
+#include "rtl_433_ESP.h"
+
+static uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/*----------------------------- Gate runs -----------------------------*/
+
+/**
+ * The start / end of signal logic of rtl_433_ReceiverTask before SignalGate,
+ * with a pulse train always available
+ */
+struct ReferenceGate {
+  int rssiThreshold;
+  uint32_t holdover;
+  uint32_t holdoverAfter;
+  uint32_t minSignalLength;
+  int minPulses;
+  bool receiveMode;
+  uint32_t signalStart;
+  uint32_t signalEnd;
+
+  SignalGate::Decision update(uint32_t now, int rssi, int pulses) {
+    SignalGate::Decision decision = SignalGate::NONE;
+    if (rssi > rssiThreshold) {
+      if (!receiveMode) {
+        signalStart = now;
+        receiveMode = true;
+        decision = SignalGate::START;
+      }
+      signalEnd = now;
+    } else if (holdoverAfter ? now - signalEnd < holdover && now - signalStart > holdoverAfter
+                             : now - signalEnd < holdover) {
+      // skip over signal drop outs
+    } else if (receiveMode) {
+      receiveMode = false;
+      decision = pulses > minPulses && signalEnd - signalStart > minSignalLength
+                     ? SignalGate::COMMIT
+                     : SignalGate::DISCARD;
+    }
+    return decision;
+  }
+};
+
+static bool checkReference(const Trace& trace, uint32_t holdoverAfter) {
+  const int threshold = meanRssi(trace) + RSSI_THRESHOLD;
+  SignalGate gate(threshold, MINIMUM_SIGNAL_LENGTH, holdoverAfter,
+                  MINIMUM_SIGNAL_LENGTH, PD_MIN_PULSES);
+  ReferenceGate reference = {threshold, MINIMUM_SIGNAL_LENGTH, holdoverAfter,
+                             MINIMUM_SIGNAL_LENGTH, PD_MIN_PULSES, false, 0, 0};
+  uint32_t startPulses = 0;
+  for (const Sample& sample : trace.samples) {
+    int pulses = sample.pulses - startPulses;
+    SignalGate::Decision decision = gate.update(sample.time, sample.rssi, pulses);
+    if (decision != reference.update(sample.time, sample.rssi, pulses)) {
+      fprintf(stderr, "SignalGate differs from the reference at %u us\n", sample.time);
+      return false;
+    }
+    if (decision == SignalGate::START) {
+      startPulses = sample.pulses;
+    }
+  }
+  return true;
+}
+
+static Score runGate(const Trace& trace, SignalGate& gate, uint32_t tolerance,
+                     double& nanosPerTick) {
+  uint64_t t0 = nowNanos();
+  std::vector<Interval> commits = gateCommits(trace, gate, [](const Sample&) {});
+  nanosPerTick = (double)(nowNanos() - t0) / trace.samples.size();
+  return scoreCommits(trace, commits, tolerance);
+}
+
+/*----------------------------- Main -----------------------------*/
+
+static std::vector<uint32_t> parseList(const char* text) {
+  std::vector<uint32_t> values;
+  for (const char* p = text; *p;) {
+    char* end;
+    values.push_back(strtoul(p, &end, 10));
+    if (*end != ',') {
+      break;
+    }
+    p = end + 1;
+  }
+  return values;
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: gate_bench [-g count] [-s seed] [-w file] [-H holdovers]\n"
+          "                  [-A holdover starts] [-t deltas] [-m min_length]\n"
+          "                  [-l tolerance] [file]\n"
+          "  -g  generate a trace of count transmissions (default 1000)\n"
+          "  -s  seed of the generated trace\n"
+          "  -w  write the trace to file\n"
+          "  -H  holdovers in us, comma separated (default 10000,20000,40000,80000,150000)\n"
+          "  -A  holdover starts in us (default 0,30000)\n"
+          "  -t  threshold deltas above the mean RSSI in dB (default 3,6,9,12)\n"
+          "  -m  minimum signal length in us (default MINIMUM_SIGNAL_LENGTH)\n"
+          "  -l  tolerance at the start and end of a complete signal in us (default 5000)\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int count = 1000;
+  unsigned seed = 433;
+  const char* writeFile = nullptr;
+  std::vector<uint32_t> holdovers = {10000, 20000, 40000, 80000, 150000};
+  std::vector<uint32_t> holdoverAfters = {0, 30000};
+  std::vector<uint32_t> deltas = {3, 6, 9, 12};
+  uint32_t minSignalLength = MINIMUM_SIGNAL_LENGTH;
+  uint32_t tolerance = 5000;
+  int opt;
+  while ((opt = getopt(argc, argv, "g:s:w:H:A:t:m:l:h")) != -1) {
+    switch (opt) {
+      case 'g':
+        count = std::max(1, atoi(optarg));
+        break;
+      case 's':
+        seed = strtoul(optarg, NULL, 10);
+        break;
+      case 'w':
+        writeFile = optarg;
+        break;
+      case 'H':
+        holdovers = parseList(optarg);
+        break;
+      case 'A':
+        holdoverAfters = parseList(optarg);
+        break;
+      case 't':
+        deltas = parseList(optarg);
+        break;
+      case 'm':
+        minSignalLength = strtoul(optarg, NULL, 10);
+        break;
+      case 'l':
+        tolerance = strtoul(optarg, NULL, 10);
+        break;
+      default:
+        usage();
+    }
+  }
+
+  Trace trace;
+  if (optind < argc) {
+    FILE* file = fopen(argv[optind], "r");
+    if (!file) {
+      perror(argv[optind]);
+      return 2;
+    }
+    bool read = readTrace(file, trace);
+    fclose(file);
+    if (!read) {
+      return 2;
+    }
+  } else {
+    trace = generateTrace(count, seed, false);
+  }
+  if (trace.samples.empty() || trace.signals.empty()) {
+    fprintf(stderr, "No ticks or no signals in the trace\n");
+    return 2;
+  }
+  if (writeFile) {
+    FILE* file = fopen(writeFile, "w");
+    if (!file) {
+      perror(writeFile);
+      return 2;
+    }
+    writeTrace(file, trace);
+    fclose(file);
+  }
+
+  int mean = meanRssi(trace);
+  printf("# %zu signals, %zu ticks, %.1f s, mean RSSI %d dBm\n", trace.signals.size(),
+         trace.samples.size(), (trace.samples.back().time - trace.samples.front().time) / 1e6,
+         mean);
+
+  if (!checkReference(trace, 0) || !checkReference(trace, 30000)) {
+    return 1;
+  }
+  printf("# SignalGate matches the former receiver task logic\n");
+
+  printf("# %-8s %-8s %-5s %-8s %-7s %-6s %-6s %-5s %-7s %s\n", "holdover", "after",
+         "delta", "complete", "partial", "merged", "missed", "false", "dropped",
+         "ns/tick");
+  double bestDropped = 2;
+  std::string best;
+  for (uint32_t holdover : holdovers) {
+    for (uint32_t holdoverAfter : holdoverAfters) {
+      for (uint32_t delta : deltas) {
+        SignalGate gate(mean + (int)delta, holdover, holdoverAfter, minSignalLength,
+                        PD_MIN_PULSES);
+        double nanosPerTick;
+        Score score = runGate(trace, gate, tolerance, nanosPerTick);
+        double dropped = 1.0 - (double)score.complete / trace.signals.size();
+        char row[160];
+        snprintf(row, sizeof(row), "  %-8u %-8u %-5u %-8d %-7d %-6d %-6d %-5d %5.1f%%   %.1f",
+                 holdover, holdoverAfter, delta, score.complete, score.partial,
+                 score.merged, score.missed, score.falseCommits, 100 * dropped,
+                 nanosPerTick);
+        printf("%s\n", row);
+        if (dropped < bestDropped) {
+          bestDropped = dropped;
+          best = row;
+        }
+      }
+    }
+  }
+  printf("# lowest dropped-signal rate:\n%s\n", best.c_str());
+  return 0;
+}
@@ -0,0 +1,296 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  noise_floor_bench - compare the noise floor estimators on RSSI traces
+
+  Feeds an RSSI trace ( see rssi_trace.h ) to each NoiseFloor estimator as
+  the receiver task does, and compares the estimate with the median of the
+  samples outside the marked transmissions in the surrounding two seconds.
+  Reports the time until the first estimate, the error, the time to settle
+  after the noise floor moves, and the signals the SignalGate receives with
+  the RSSI threshold set from the estimate. Without a trace file a trace
+  with a moving noise floor is generated.
+
+  usage: noise_floor_bench [-g count] [-s seed] [-w file] [-A holdover start]
+                           [-e max_dropped_percent] [file]
+
+*/
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "noiseFloor.h"
+#include "rssi_trace.h"
+#include "rtl_433_ESP.h"
+
+#define REFERENCE_STEP   100 // ms between reference noise floor values
+#define REFERENCE_WINDOW 1000 // ms on either side of a reference value
+#define SETTLED_DB       1.5
+#define STEP_DB          3 // noise floor move within a second counted as a step
+
+static uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * Reference noise floor of every tick, the median of the samples outside the
+ * transmissions within REFERENCE_WINDOW
+ */
+static std::vector<float> referenceFloor(const Trace& trace) {
+  const size_t ticks = trace.samples.size();
+  std::vector<bool> inSignal(ticks, false);
+  size_t s = 0;
+  for (size_t i = 0; i < ticks; i++) {
+    uint32_t time = trace.samples[i].time;
+    while (s < trace.signals.size() && trace.signals[s].end < time) {
+      s++;
+    }
+    inSignal[i] = s < trace.signals.size() && trace.signals[s].start <= time;
+  }
+
+  std::vector<float> reference(ticks, 0);
+  std::vector<int> window;
+  float last = trace.samples[0].rssi;
+  for (size_t step = 0; step < ticks; step += REFERENCE_STEP) {
+    size_t from = step > REFERENCE_WINDOW ? step - REFERENCE_WINDOW : 0;
+    size_t to = std::min(ticks, step + REFERENCE_WINDOW);
+    window.clear();
+    for (size_t i = from; i < to; i++) {
+      if (!inSignal[i]) {
+        window.push_back(trace.samples[i].rssi);
+      }
+    }
+    if (!window.empty()) {
+      std::nth_element(window.begin(), window.begin() + window.size() / 2, window.end());
+      last = window[window.size() / 2];
+    }
+    for (size_t i = step; i < std::min(ticks, step + REFERENCE_STEP); i++) {
+      reference[i] = last;
+    }
+  }
+  return reference;
+}
+
+struct Comparison {
+  double readySeconds; // until the first estimate
+  double meanError; // estimate - reference, dB
+  double meanAbsError;
+  double p95AbsError;
+  double settleSeconds; // average time to settle after the floor moved
+  int steps;
+  double nanosPerSample;
+  Score score;
+};
+
+static Comparison compare(const Trace& trace, const std::vector<float>& reference,
+                          NoiseFloor& estimator, SignalGate& gate,
+                          uint32_t tolerance) {
+  Comparison result = {};
+  // absolute errors in 0.1 dB bins, the last bin holds everything above
+  std::vector<unsigned> histogram(501, 0);
+  unsigned estimates = 0;
+  double totalError = 0;
+  double totalAbsError = 0;
+  double settleTotal = 0;
+  size_t stepStart = 0;
+  bool settling = false;
+  bool stepping = false;
+  size_t i = 0;
+
+  std::vector<Interval> commits = gateCommits(trace, gate, [&](const Sample& sample) {
+    estimator.add(sample.rssi);
+    // the threshold as the receiver task sets it with AUTORSSITHRESHOLD
+    gate.rssiThreshold =
+        estimator.ready() ? estimator.estimate() + RSSI_THRESHOLD : MINRSSI;
+
+    // the noise floor moved within the last second, once per move
+    bool step = i >= 1000 && fabsf(reference[i] - reference[i - 1000]) > STEP_DB;
+    if (step && !stepping) {
+      if (settling) { // not settled before the next move
+        settleTotal += (i - stepStart) * TICK_MICROS / 1e6;
+      }
+      settling = true;
+      stepStart = i;
+      result.steps++;
+    }
+    stepping = step;
+    if (estimator.ready()) {
+      if (!estimates) {
+        result.readySeconds = (sample.time - trace.samples[0].time) / 1e6;
+      }
+      double error = estimator.estimate() - reference[i];
+      estimates++;
+      totalError += error;
+      totalAbsError += fabs(error);
+      histogram[std::min<size_t>(histogram.size() - 1, (size_t)(fabs(error) * 10))]++;
+      if (settling && fabs(error) <= SETTLED_DB) {
+        settling = false;
+        settleTotal += (i - stepStart) * TICK_MICROS / 1e6;
+      }
+    }
+    i++;
+  });
+  if (settling) { // never settled, count until the end
+    settleTotal += (i - stepStart) * TICK_MICROS / 1e6;
+  }
+
+  if (estimates) {
+    result.meanError = totalError / estimates;
+    result.meanAbsError = totalAbsError / estimates;
+    unsigned seen = 0;
+    for (size_t bin = 0; bin < histogram.size(); bin++) {
+      seen += histogram[bin];
+      if (seen >= 0.95 * estimates) {
+        result.p95AbsError = bin / 10.0;
+        break;
+      }
+    }
+  } else {
+    result.readySeconds = -1;
+  }
+  result.settleSeconds = result.steps ? settleTotal / result.steps : 0;
+  result.score = scoreCommits(trace, commits, tolerance);
+  return result;
+}
+
+/**
+ * Cost of adding a sample, the estimator runs on the trace once more
+ */
+static double nanosPerSample(const Trace& trace, NoiseFloor& estimator) {
+  int sink = 0;
+  uint64_t t0 = nowNanos();
+  for (const Sample& sample : trace.samples) {
+    estimator.add(sample.rssi);
+    sink += estimator.estimate();
+  }
+  uint64_t nanos = nowNanos() - t0;
+  volatile int keep = sink;
+  (void)keep;
+  return (double)nanos / trace.samples.size();
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: noise_floor_bench [-g count] [-s seed] [-w file] [-A holdover start]\n"
+          "                         [-e max_dropped_percent] [file]\n"
+          "  -g  generate a trace of count transmissions with a moving noise floor\n"
+          "      (default 1000)\n"
+          "  -s  seed of the generated trace\n"
+          "  -w  write the trace to file\n"
+          "  -A  holdover start of the gate in us (default 0)\n"
+          "  -e  exit with an error if the default estimator drops more signals\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int count = 1000;
+  unsigned seed = 433;
+  const char* writeFile = nullptr;
+  uint32_t holdoverAfter = 0;
+  double maxDropped = -1;
+  int opt;
+  while ((opt = getopt(argc, argv, "g:s:w:A:e:h")) != -1) {
+    switch (opt) {
+      case 'g':
+        count = std::max(1, atoi(optarg));
+        break;
+      case 's':
+        seed = strtoul(optarg, NULL, 10);
+        break;
+      case 'w':
+        writeFile = optarg;
+        break;
+      case 'A':
+        holdoverAfter = strtoul(optarg, NULL, 10);
+        break;
+      case 'e':
+        maxDropped = atof(optarg);
+        break;
+      default:
+        usage();
+    }
+  }
+
+  Trace trace;
+  if (optind < argc) {
+    FILE* file = fopen(argv[optind], "r");
+    if (!file) {
+      perror(argv[optind]);
+      return 2;
+    }
+    bool read = readTrace(file, trace);
+    fclose(file);
+    if (!read) {
+      return 2;
+    }
+  } else {
+    trace = generateTrace(count, seed, true);
+  }
+  if (trace.samples.empty() || trace.signals.empty()) {
+    fprintf(stderr, "No ticks or no signals in the trace\n");
+    return 2;
+  }
+  if (writeFile) {
+    FILE* file = fopen(writeFile, "w");
+    if (!file) {
+      perror(writeFile);
+      return 2;
+    }
+    writeTrace(file, trace);
+    fclose(file);
+  }
+
+  std::vector<float> reference = referenceFloor(trace);
+  printf("# %zu signals, %zu ticks, %.1f s, mean RSSI %d dBm\n", trace.signals.size(),
+         trace.samples.size(), (trace.samples.back().time - trace.samples.front().time) / 1e6,
+         meanRssi(trace));
+
+  std::unique_ptr<NoiseFloor> estimators[] = {
+      std::unique_ptr<NoiseFloor>(new BlockAverageNoiseFloor(RSSI_SAMPLES)),
+      std::unique_ptr<NoiseFloor>(new EwmaNoiseFloor()),
+      std::unique_ptr<NoiseFloor>(new QuantileNoiseFloor()),
+      std::unique_ptr<NoiseFloor>(new MinNoiseFloor()),
+  };
+  printf("# %-9s %-7s %-6s %-6s %-6s %-8s %-8s %-5s %-7s %-6s %-6s %-5s %-7s %s\n",
+         "estimator", "ready", "bias", "mae", "p95", "settle", "complete", "part",
+         "merged", "missed", "false", "", "dropped", "ns/sample");
+  int status = 0;
+  for (size_t e = 0; e < sizeof(estimators) / sizeof(estimators[0]); e++) {
+    NoiseFloor& estimator = *estimators[e];
+    SignalGate gate(MINRSSI, MINIMUM_SIGNAL_LENGTH, holdoverAfter,
+                    MINIMUM_SIGNAL_LENGTH, PD_MIN_PULSES);
+    Comparison result = compare(trace, reference, estimator, gate, 5000);
+    result.nanosPerSample = nanosPerSample(trace, estimator);
+    double dropped = 100.0 * (1.0 - (double)result.score.complete / trace.signals.size());
+    printf("  %-9s %5.1fs %+5.1f  %5.1f  %5.1f  %5.1fs   %-8d %-5d %-7d %-6d %-6d %-5s %5.1f%%  %.1f\n",
+           estimator.name(), result.readySeconds, result.meanError, result.meanAbsError,
+           result.p95AbsError, result.settleSeconds, result.score.complete,
+           result.score.partial, result.score.merged, result.score.missed,
+           result.score.falseCommits, "", dropped, result.nanosPerSample);
+    if (e == NOISE_FLOOR && maxDropped >= 0 && dropped > maxDropped) {
+      fprintf(stderr, "%s drops %.1f%% of the signals, more than %.1f%%\n",
+              estimator.name(), dropped, maxDropped);
+      status = 1;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,212 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  pipeline_bench - the whole receive path on a host, in virtual time
+
+  Plays signals from a ReplayEdgeSource ( RAW logs, see the .md captures in
+  signals/ ) or a SyntheticEdgeSource through receiveEdge, the edge ring, the
+  receiver task gating and pulse assembly, the decoder queue and the decoder
+  task to the message callback. The receiver ticks are driven from here, one
+  tick per millisecond of virtual time.
+
+  By default virtual time waits for the decoder before every tick, so no
+  signal is lost to a busy decoder and the run is repeatable. With -x the
+  ticks are paced at speed times real time and the decoder has to keep up,
+  signals it does not keep up with are shed as the shed policy says. With -m
+  the OOK and FSK decoders are registered and the receiver alternates
+  between OOK and FSK windows, the signals are all OOK so those that start in
+  an FSK window are lost.
+
+  usage: pipeline_bench [-q] [-g count] [-x speed] [-r repeat] [-b trains]
+                        [-d queue_depth] [-p policy] [-m ook_ms,fsk_ms]
+                        [-e min_messages] [file ...]
+
+*/
+
+#include <getopt.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "edgeSource.h"
+#include "signalDecoder.h"
+#include "signalReceiver.h"
+
+static char messageBuffer[2048];
+static bool printMessages = true;
+static volatile int messages = 0;
+
+static void onMessage(char* message) {
+  messages++;
+  if (printMessages) {
+    printf("%s\n", message);
+  }
+}
+
+static bool decoderIdle() {
+  return rtl_433_DecodedSignals + rtl_433_OverwrittenSignals == rtl_433_QueuedSignals;
+}
+
+static const char* policies[] = {"newest", "oldest", "strongest"};
+
+static void usage() {
+  fprintf(stderr,
+          "usage: pipeline_bench [-q] [-g count] [-x speed] [-r repeat] [-b trains]\n"
+          "                      [-d queue_depth] [-p policy] [-m ook_ms,fsk_ms]\n"
+          "                      [-e min_messages] [file ...]\n"
+          "  -q  do not print the decoded messages\n"
+          "  -g  play count synthetic PWM signals instead of RAW logs\n"
+          "  -x  pace virtual time at speed times real time, 0 waits for the\n"
+          "      decoder before every tick (default 0)\n"
+          "  -r  number of times the RAW pulse trains are played (default 1)\n"
+          "  -b  number of pulse trains (default RECEIVER_BUFFER_SIZE)\n"
+          "  -d  depth of the decoder queue (default DECODER_QUEUE_DEPTH)\n"
+          "  -p  shed policy, newest, oldest or strongest (default SHED_POLICY)\n"
+          "  -m  alternate between OOK and FSK windows of the given lengths in ms\n"
+          "  -e  exit with an error if fewer messages are decoded\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int synthetic = 0;
+  double speed = 0;
+  int repeat = 1;
+  int expectMessages = -1;
+  int trains = RECEIVER_BUFFER_SIZE;
+  int queueDepth = DECODER_QUEUE_DEPTH;
+  int policy = SHED_POLICY;
+  unsigned long ookWindow = 0;
+  unsigned long fskWindow = 0;
+  int opt;
+  while ((opt = getopt(argc, argv, "qg:x:r:b:d:p:m:e:h")) != -1) {
+    switch (opt) {
+      case 'q':
+        printMessages = false;
+        break;
+      case 'g':
+        synthetic = std::max(1, atoi(optarg));
+        break;
+      case 'x':
+        speed = std::max(0.0, atof(optarg));
+        break;
+      case 'r':
+        repeat = std::max(1, atoi(optarg));
+        break;
+      case 'b':
+        trains = atoi(optarg);
+        break;
+      case 'd':
+        queueDepth = atoi(optarg);
+        break;
+      case 'p':
+        for (policy = 0; policy < 3 && strcmp(optarg, policies[policy]); policy++) {
+        }
+        if (policy == 3) {
+          usage();
+        }
+        break;
+      case 'm':
+        if (sscanf(optarg, "%lu,%lu", &ookWindow, &fskWindow) != 2) {
+          usage();
+        }
+        rtl_433_ESP::dualModulation = true;
+        break;
+      case 'e':
+        expectMessages = atoi(optarg);
+        break;
+      default:
+        usage();
+    }
+  }
+
+  ReplayEdgeSource replay;
+  SyntheticEdgeSource generator;
+  TimedEdgeSource* source = &replay;
+  if (synthetic) {
+    generator.count = synthetic;
+    source = &generator;
+  } else {
+    if (optind == argc) {
+      replay.load(stdin);
+    }
+    for (int i = optind; i < argc; i++) {
+      FILE* file = fopen(argv[i], "r");
+      if (!file) {
+        perror(argv[i]);
+        return 2;
+      }
+      replay.load(file);
+      fclose(file);
+    }
+    if (replay.trains().empty()) {
+      fprintf(stderr, "No RAW pulse trains found\n");
+      return 2;
+    }
+    replay.repeat = repeat;
+  }
+
+  rtl_433_ESP::setReceiverBuffers(trains, queueDepth);
+  rtl_433_ESP::setShedPolicy(policy);
+  rtlSetup();
+  _setCallback(onMessage, messageBuffer, sizeof(messageBuffer));
+  rtl_433_ESP::setEdgeSource(source);
+  if (rtl_433_ESP::dualModulation) {
+    rtl_433_ESP::setModulationSchedule(ookWindow, fskWindow);
+  }
+  rtl_433_ESP::enableReceiver();
+
+  auto start = std::chrono::steady_clock::now();
+  unsigned long ticks = 0;
+  while (!source->finished()) {
+    if (speed > 0) {
+      std::this_thread::sleep_until(
+          start + std::chrono::microseconds((uint64_t)(ticks * source->tickMicros / speed)));
+    } else {
+      while (!decoderIdle()) {
+        std::this_thread::yield();
+      }
+    }
+    rtl_433_ESP::receiverTick();
+    ticks++;
+  }
+  while (!decoderIdle()) {
+    std::this_thread::yield();
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double virtualSeconds = ticks * (double)source->tickMicros / 1e6;
+
+  printf("# %u signals played, %d received, %d ignored, %lu decoded, %d messages\n",
+         source->signals(), rtl_433_ESP::messageCount, rtl_433_ESP::ignoredSignals,
+         (unsigned long)rtl_433_DecodedSignals, (int)messages);
+  printf("# %d pulse trains, queue depth %d, shed %s: %lu overwritten, %lu dropped\n",
+         rtl_433_ReceiverBuffers, rtl_433_QueueDepth, policies[rtl_433_ShedPolicy],
+         (unsigned long)rtl_433_OverwrittenSignals, (unsigned long)rtl_433_DroppedSignals);
+  if (rtl_433_ESP::dualModulation) {
+    printf("# OOK %lu ms, FSK %lu ms windows: %lu modulation switches\n", ookWindow,
+           fskWindow, modulationSwitches());
+  }
+  printf("# %.1f s of signals in %.3f s: %.1f times real time, %.1f signals/sec\n",
+         virtualSeconds, seconds, virtualSeconds / seconds, source->signals() / seconds);
+
+  if (expectMessages >= 0 && messages < expectMessages) {
+    fprintf(stderr, "Expected at least %d messages, decoded %d\n",
+            expectMessages, (int)messages);
+    return 1;
+  }
+  return 0;
+}
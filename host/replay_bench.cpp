@@ -0,0 +1,323 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  replay_bench - replay RAW pulse trains through the decoder on a host
+
+  Reads the "RAW (duration): +pulse-gap+pulse-gap..." lines printed by
+  RAW_SIGNAL_DEBUG / PUBLISH_UNPARSED (see the .md captures in signals/),
+  decodes each train once printing the JSON (or CBOR as hex), then replays all
+  trains to report decodes/sec, the end of signal to callback latency and the
+  time spent in each registered decoder. replay_bench_parallel is the same with PARALLEL_DECODE.
+
+  usage: replay_bench [-f] [-d] [-c] [-q] [-m] [-o json|cbor] [-s size] [-r repeat]
+                      [-n top] [-k names] [-e min_messages] [file ...]
+
+*/
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "edgeSource.h"
+#include "signalDecoder.h"
+
+static ReplayEdgeSource replay;
+static char messageBuffer[2048];
+static bool printMessages = true;
+static int messages = 0;
+
+static void onMessage(char* message) {
+  messages++;
+  if (printMessages) {
+    printf("%s\n", message);
+  }
+}
+
+static void onBinaryMessage(const uint8_t* message, size_t length) {
+  messages++;
+  if (printMessages) {
+    for (size_t i = 0; i < length; i++) {
+      printf("%02x", message[i]);
+    }
+    printf("\n");
+  }
+}
+
+static uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/*----------------------------- Benchmark -----------------------------*/
+
+struct DecoderCost {
+  r_device* r_dev;
+  uint64_t nanos;
+  int events;
+};
+
+static int runDemods(demod_dispatch_t* dispatch, pulse_data_t* train) {
+  if (!train->fskModulation) {
+    return run_ook_demods(rtl_433_DecodeCtx, dispatch, train);
+  }
+  return run_fsk_demods(rtl_433_DecodeCtx, dispatch, train);
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: replay_bench [-f] [-d] [-c] [-q] [-m] [-o json|cbor] [-s size] [-r repeat]\n"
+          "                    [-n top] [-k names] [-e min_messages] [file ...]\n"
+          "  -f  register the FSK decoders instead of OOK, the trains are FSK\n"
+          "  -d  register the OOK and the FSK decoders, as with DUAL_MODULATION\n"
+          "  -c  run every decoder, without the pulse train pre-classifier\n"
+          "  -q  do not print the decoded messages\n"
+          "  -m  disable all decoders at runtime and enable them again by modulation,\n"
+          "      exit with an error if that does not register the default decoders\n"
+          "  -o  message format, json (default) or cbor printed as hex\n"
+          "  -s  message buffer size (default and max 2048)\n"
+          "  -r  number of timed replays of the whole trace (default 100)\n"
+          "  -n  number of decoders listed in the cost table, 0 for all (default 20)\n"
+          "  -k  keep only the decoders whose name contains one of the comma\n"
+          "      separated names, disabling the others at runtime\n"
+          "  -e  exit with an error if fewer messages are decoded in the first pass\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  int repeat = 100;
+  int top = 20;
+  int expectMessages = -1;
+  bool cbor = false;
+  const char* keep = nullptr;
+  bool byModulation = false;
+  int bufferSize = sizeof(messageBuffer);
+  int opt;
+  while ((opt = getopt(argc, argv, "fdcqmo:s:r:n:k:e:h")) != -1) {
+    switch (opt) {
+      case 'f':
+        rtl_433_ESP::ookModulation = false;
+        break;
+      case 'd':
+        rtl_433_ESP::dualModulation = true;
+        break;
+      case 'c':
+        pulse_classifier_enabled = 0;
+        break;
+      case 'q':
+        printMessages = false;
+        break;
+      case 'm':
+        byModulation = true;
+        break;
+      case 'o':
+        if (!strcmp(optarg, "cbor")) {
+          cbor = true;
+        } else if (strcmp(optarg, "json")) {
+          usage();
+        }
+        break;
+      case 's':
+        bufferSize = std::min(std::max(1, atoi(optarg)), (int)sizeof(messageBuffer));
+        break;
+      case 'r':
+        repeat = std::max(1, atoi(optarg));
+        break;
+      case 'n':
+        top = atoi(optarg);
+        break;
+      case 'k':
+        keep = optarg;
+        break;
+      case 'e':
+        expectMessages = atoi(optarg);
+        break;
+      default:
+        usage();
+    }
+  }
+
+  if (optind == argc) {
+    replay.load(stdin);
+  }
+  for (int i = optind; i < argc; i++) {
+    FILE* file = fopen(argv[i], "r");
+    if (!file) {
+      perror(argv[i]);
+      return 2;
+    }
+    replay.load(file);
+    fclose(file);
+  }
+  const std::vector<pulse_data_t*>& trains = replay.trains();
+  if (trains.empty()) {
+    fprintf(stderr, "No RAW pulse trains found\n");
+    return 2;
+  }
+  for (pulse_data_t* train : trains) {
+    train->fskModulation = !rtl_433_ESP::ookModulation;
+  }
+
+  rtlSetup();
+  if (cbor) {
+    _setCallback(onBinaryMessage, (uint8_t*)messageBuffer, bufferSize);
+  } else {
+    _setCallback(onMessage, messageBuffer, bufferSize);
+  }
+  r_cfg_t* cfg = &g_cfg;
+  if (byModulation) {
+    // decoders disabled by default stay disabled
+    size_t defaults = cfg->demod->r_devs.len;
+    rtl_433_ESP::setDecoders("", false);
+    std::vector<unsigned> modulations;
+    for (int i = 0; i < cfg->num_r_devices; i++) {
+      unsigned modulation = cfg->devices[i]->modulation;
+      if (std::find(modulations.begin(), modulations.end(), modulation) == modulations.end()) {
+        modulations.push_back(modulation);
+        rtl_433_ESP::setModulationDecoders(modulation, true);
+      }
+    }
+    if (cfg->demod->r_devs.len != defaults) {
+      fprintf(stderr, "%zu decoders enabled by modulation, %zu by default\n",
+              cfg->demod->r_devs.len, defaults);
+      return 1;
+    }
+  }
+  if (keep) {
+    rtl_433_ESP::setDecoders("", false);
+    std::string names = keep;
+    for (size_t start = 0; start <= names.size();) {
+      size_t end = std::min(names.find(',', start), names.size());
+      rtl_433_ESP::setDecoders(names.substr(start, end - start).c_str(), true);
+      start = end + 1;
+    }
+  }
+
+  size_t pulses = 0;
+  for (pulse_data_t* train : trains) {
+    pulses += train->num_pulses;
+  }
+  printf("# %zu %s pulse trains, %zu pulses, %zu %s decoders registered\n",
+         trains.size(), rtl_433_ESP::ookModulation ? "OOK" : "FSK", pulses,
+         cfg->demod->r_devs.len,
+         rtl_433_ESP::dualModulation ? "OOK and FSK"
+                                     : rtl_433_ESP::ookModulation ? "OOK" : "FSK");
+
+  // First pass, decoded messages are printed
+  int events = 0;
+  for (pulse_data_t* train : trains) {
+    events += decodeSignal(rtl_433_DecodeCtx, train);
+  }
+  int firstPassMessages = messages;
+  printf("# %d events, %d messages, %d unparsed trains, %u truncated messages\n", events,
+         firstPassMessages, rtl_433_ESP::unparsedSignals, cfg->truncatedMessages);
+  pulse_classifier_stats_t stats;
+  getDecoderStats(&stats);
+  printf("# pre-classifier %s: %u slicer runs, %u skipped (%.1f%%), %u of %u trains unclassified\n",
+         pulse_classifier_enabled ? "on" : "off", stats.runs, stats.skipped,
+         stats.runs + stats.skipped ? 100.0 * stats.skipped / (stats.runs + stats.skipped) : 0.0,
+         stats.unclassified, stats.trains);
+  printf("# slicing groups: %u slicer runs saved\n", stats.shared);
+  data_arena_t& arena = rtl_433_DecodeCtx->arena;
+  printf("# data arena: %zu of %zu bytes peak, %u heap fallbacks\n", arena.peak,
+         arena.size, arena.overflows);
+
+  // Timed replay of the full decoder path, each train handed over as soon as
+  // its signal ends
+  printMessages = false;
+  rtl_433_DecodeLatency = {};
+  uint64_t start = nowNanos();
+  for (int r = 0; r < repeat; r++) {
+    for (pulse_data_t* train : trains) {
+      train->signalEnd = micros();
+      decodeSignal(rtl_433_DecodeCtx, train);
+    }
+  }
+  uint64_t elapsed = nowNanos() - start;
+  double seconds = elapsed / 1e9;
+  size_t decodes = trains.size() * repeat;
+  printf("# %zu decodes in %.3f s: %.1f decodes/sec, %.1f us/decode\n",
+         decodes, seconds, decodes / seconds, elapsed / 1e3 / decodes);
+  if (rtl_433_DecodeLatency.count) {
+    printf("# end of signal to callback latency: %.1f us avg, %lu us max\n",
+           (double)rtl_433_DecodeLatency.total / rtl_433_DecodeLatency.count,
+           rtl_433_DecodeLatency.max);
+  }
+
+  // Per decoder cost, each registered decoder run alone against every train,
+  // the decoders of a slicing group are run and accounted together
+  std::vector<DecoderCost> costs;
+  for (void** iter = cfg->demod->r_devs.elems; iter && *iter; ++iter) {
+    r_device* r_dev = (r_device*)*iter;
+    if (r_dev->slice_follower) {
+      continue;
+    }
+    void* elems[2] = {r_dev, nullptr};
+    list_t single = {elems, 2, 1};
+    demod_dispatch_t dispatch = {};
+    if (demod_dispatch_build(&dispatch, &single))
+      FATAL_CALLOC("main()");
+    DecoderCost cost = {r_dev, 0, 0};
+    for (int r = 0; r < repeat; r++) {
+      for (pulse_data_t* train : trains) {
+        cfg->demod->pulse_data = *train;
+        uint64_t t0 = nowNanos();
+        int found = runDemods(&dispatch, train);
+        cost.nanos += nowNanos() - t0;
+        if (r == 0) {
+          cost.events += found;
+        }
+      }
+    }
+    demod_dispatch_free(&dispatch);
+    costs.push_back(cost);
+  }
+  std::sort(costs.begin(), costs.end(),
+            [](const DecoderCost& a, const DecoderCost& b) {
+              return a.nanos > b.nanos;
+            });
+  uint64_t totalNanos = 0;
+  for (const DecoderCost& cost : costs) {
+    totalNanos += cost.nanos;
+  }
+  printf("# %-8s %-6s %-10s %-6s %s\n", "us/train", "share", "modulation",
+         "events", "decoder");
+  int listed = 0;
+  for (const DecoderCost& cost : costs) {
+    if (top > 0 && listed++ >= top) {
+      break;
+    }
+    printf("  %-8.2f %5.1f%% %-10u %-6d [%u] %s\n",
+           cost.nanos / 1e3 / decodes,
+           totalNanos ? 100.0 * cost.nanos / totalNanos : 0.0,
+           cost.r_dev->modulation, cost.events, cost.r_dev->protocol_num,
+           cost.r_dev->name);
+    for (r_device* follower = cost.r_dev->slice_next; follower; follower = follower->slice_next) {
+      printf("  %-8s %6s %-10s %-6s [%u] %s\n", "", "", "", "+", follower->protocol_num,
+             follower->name);
+    }
+  }
+
+  if (expectMessages >= 0 && firstPassMessages < expectMessages) {
+    fprintf(stderr, "Expected at least %d messages, decoded %d\n",
+            expectMessages, firstPassMessages);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,173 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  rssi_trace - RSSI traces for gate_bench and noise_floor_bench
+
+*/
+
+#include "rssi_trace.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <random>
+
+bool readTrace(FILE* file, Trace& trace) {
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    Interval signal;
+    Sample sample;
+    if (line[0] == '#' || line[0] == '\n') {
+      continue;
+    } else if (sscanf(line, "S %u %u", &signal.start, &signal.end) == 2) {
+      trace.signals.push_back(signal);
+    } else if (sscanf(line, "%u %d %u", &sample.time, &sample.rssi, &sample.pulses) == 3) {
+      trace.samples.push_back(sample);
+    } else {
+      fprintf(stderr, "Not a trace line: %s", line);
+      return false;
+    }
+  }
+  return true;
+}
+
+void writeTrace(FILE* file, const Trace& trace) {
+  fprintf(file, "# rtl_433_ESP RSSI trace, %zu signals, %zu ticks\n",
+          trace.signals.size(), trace.samples.size());
+  for (const Interval& signal : trace.signals) {
+    fprintf(file, "S %u %u\n", signal.start, signal.end);
+  }
+  for (const Sample& sample : trace.samples) {
+    fprintf(file, "%u %d %u\n", sample.time, sample.rssi, sample.pulses);
+  }
+}
+
+/**
+ * Inside a packet a sample sees the carrier off 30% of the time. One in six
+ * transmissions follows the previous one within 40 to 120 ms.
+ */
+Trace generateTrace(int count, unsigned seed, bool drift) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> noise(-95, 2);
+  std::uniform_int_distribution<int> strength(-85, -55);
+  std::uniform_int_distribution<int> packets(1, 6);
+  std::uniform_int_distribution<uint32_t> packetLength(20, 120);
+  std::uniform_int_distribution<uint32_t> packetGap(4, 25);
+  std::uniform_int_distribution<uint32_t> closeGap(40, 120);
+  std::exponential_distribution<double> idle(1 / 1500.0);
+  std::uniform_int_distribution<int> burstLength(1, 8);
+  std::uniform_real_distribution<double> chance(0, 1);
+  std::uniform_int_distribution<int> floorLevel(-100, -86);
+  std::uniform_int_distribution<uint32_t> floorPeriod(20, 120);
+
+  Trace trace;
+  uint32_t time = 0;
+  uint32_t pulses = 0;
+  int noiseFloor = -95;
+  uint32_t floorChange = drift ? floorPeriod(rng) * 1000000 : 0;
+  auto background = [&]() { return (int)lround(noise(rng)) + noiseFloor + 95; };
+  auto tick = [&](int rssi, uint32_t newPulses) {
+    time += TICK_MICROS;
+    pulses += newPulses;
+    trace.samples.push_back({time, rssi, pulses});
+  };
+  auto quiet = [&](uint32_t millis) {
+    for (uint32_t ms = 0; ms < millis; ms++) {
+      if (floorChange && time >= floorChange) {
+        noiseFloor = floorLevel(rng);
+        floorChange += floorPeriod(rng) * 1000000;
+      }
+      if (chance(rng) < 0.002) { // interference
+        for (int i = burstLength(rng); i > 0; i--, ms++) {
+          tick(-70 + (int)(chance(rng) * 8), chance(rng) < 0.5);
+        }
+      } else {
+        tick(background(), 0);
+      }
+    }
+  };
+
+  quiet(500);
+  for (int n = 0; n < count; n++) {
+    int level = strength(rng);
+    Interval signal = {time + TICK_MICROS, 0};
+    for (int p = packets(rng); p > 0; p--) {
+      for (uint32_t ms = packetLength(rng); ms > 0; ms--) {
+        if (chance(rng) < 0.3) { // carrier off during the sample
+          tick(std::max(level - 20, background()), 1);
+        } else {
+          tick(level + (int)lround(noise(rng)) + 95, 1);
+        }
+      }
+      signal.end = time;
+      if (p > 1) {
+        quiet(packetGap(rng));
+      }
+    }
+    trace.signals.push_back(signal);
+    quiet(chance(rng) < 1 / 6.0 ? closeGap(rng) : 20 + (uint32_t)idle(rng));
+  }
+  return trace;
+}
+
+int meanRssi(const Trace& trace) {
+  long total = 0;
+  for (const Sample& sample : trace.samples) {
+    total += sample.rssi;
+  }
+  return trace.samples.empty() ? 0 : (int)(total / (long)trace.samples.size());
+}
+
+Score scoreCommits(const Trace& trace, const std::vector<Interval>& commits,
+                   uint32_t tolerance) {
+  Score score = {};
+  auto overlaps = [](const Interval& a, const Interval& b) {
+    return a.start <= b.end && b.start <= a.end;
+  };
+  std::vector<int> signalsPerCommit(commits.size(), 0);
+  for (const Interval& signal : trace.signals) {
+    for (size_t c = 0; c < commits.size(); c++) {
+      signalsPerCommit[c] += overlaps(commits[c], signal);
+    }
+  }
+  for (size_t c = 0; c < commits.size(); c++) {
+    score.falseCommits += signalsPerCommit[c] == 0;
+  }
+  for (const Interval& signal : trace.signals) {
+    int covering = 0;
+    bool merged = false;
+    bool whole = false;
+    for (size_t c = 0; c < commits.size(); c++) {
+      if (overlaps(commits[c], signal)) {
+        covering++;
+        merged |= signalsPerCommit[c] > 1;
+        whole |= commits[c].start <= signal.start + tolerance &&
+                 commits[c].end + tolerance >= signal.end;
+      }
+    }
+    if (!covering) {
+      score.missed++;
+    } else if (merged) {
+      score.merged++;
+    } else if (covering == 1 && whole) {
+      score.complete++;
+    } else {
+      score.partial++;
+    }
+  }
+  return score;
+}
+
@@ -0,0 +1,111 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  rssi_trace - RSSI traces for gate_bench and noise_floor_bench
+
+  A trace is one RSSI sample per receiver tick with the transmissions it
+  holds marked, read from a file or generated. Trace format, one line each:
+
+    # comment
+    S <start us> <end us>            a transmission, the expected signal
+    <time us> <rssi dBm> <pulses>    a tick, pulses received since startup
+
+*/
+
+#ifndef HOST_RSSI_TRACE_H
+#define HOST_RSSI_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "signalGate.h"
+
+#define TICK_MICROS 1000
+
+struct Sample {
+  uint32_t time;
+  int rssi;
+  uint32_t pulses;
+};
+
+struct Interval {
+  uint32_t start;
+  uint32_t end;
+};
+
+struct Trace {
+  std::vector<Sample> samples;
+  std::vector<Interval> signals;
+};
+
+/**
+ * Committed signals against the transmissions of a trace
+ */
+struct Score {
+  int complete; // one signal committed whole
+  int partial; // start or end missing, or split over several commits
+  int merged; // committed together with another signal
+  int missed; // not committed at all
+  int falseCommits; // commits of interference
+};
+
+bool readTrace(FILE* file, Trace& trace);
+void writeTrace(FILE* file, const Trace& trace);
+
+/**
+ * count transmissions of 1 to 6 OOK packets of 20 to 120 ms, 4 to 25 ms
+ * apart, with short bursts of interference in between. With drift the noise
+ * floor moves to a new level between -100 and -86 dBm every 20 to 120 s.
+ */
+Trace generateTrace(int count, unsigned seed, bool drift);
+
+int meanRssi(const Trace& trace);
+
+/**
+ * A commit is complete when it covers its transmission to within tolerance
+ * at both ends
+ */
+Score scoreCommits(const Trace& trace, const std::vector<Interval>& commits,
+                   uint32_t tolerance);
+
+/**
+ * Play the trace through gate, beforeTick(sample) is called ahead of each
+ * tick, e.g. to adjust the threshold. Returns the committed signals.
+ */
+template <typename BeforeTick>
+std::vector<Interval> gateCommits(const Trace& trace, SignalGate& gate,
+                                  BeforeTick beforeTick) {
+  std::vector<Interval> commits;
+  uint32_t startPulses = 0;
+  for (const Sample& sample : trace.samples) {
+    beforeTick(sample);
+    switch (gate.update(sample.time, sample.rssi, sample.pulses - startPulses)) {
+      case SignalGate::START:
+        startPulses = sample.pulses;
+        break;
+      case SignalGate::COMMIT:
+        commits.push_back({gate.signalStart(), gate.signalEnd()});
+        break;
+      default:
+        break;
+    }
+  }
+  return commits;
+}
+
+#endif
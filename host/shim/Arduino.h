@@ -0,0 +1,48 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  Host shim
+
+  Minimal stand-in for the Arduino-ESP32 core so the decoder side of the
+  library (signalDecoder.cpp and src/rtl_433) can be built and profiled on a
+  Linux host.  Only what the decoder path touches is provided.
+
+*/
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Esp.h"
+#include "esp_heap_caps.h"
+#include "freertos.h"
+#include "pgmspace.h"
+
+#ifndef IRAM_ATTR
+#  define IRAM_ATTR
+#endif
+
+typedef uint8_t byte;
+
+unsigned long micros();
+unsigned long millis();
+
+#endif
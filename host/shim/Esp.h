@@ -0,0 +1,22 @@
+/*
+  rtl_433_ESP - host shim for the Arduino-ESP32 ESP object
+*/
+
+#ifndef HOST_ESP_H
+#define HOST_ESP_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+class EspClass {
+public:
+  /**
+   * Host has no meaningful free heap figure, always 0
+   */
+  uint32_t getFreeHeap() { return 0; }
+  void restart() { abort(); }
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,17 @@
+/*
+  rtl_433_ESP - host shim for the Arduino Print class
+*/
+
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+};
+
+#endif
@@ -0,0 +1,11 @@
+/*
+  rtl_433_ESP - host shim for RadioLib, the decoder path never touches the radio
+*/
+
+#ifndef HOST_RADIOLIB_H
+#define HOST_RADIOLIB_H
+
+#define RADIOLIB_ERR_NONE 0
+#define RADIOLIB_NC       0xFFFFFFFF
+
+#endif
@@ -0,0 +1,52 @@
+/*
+  rtl_433_ESP - host shim for the FreeRTOS task and queue API
+
+  Tasks run as threads and queues / semaphores block like their FreeRTOS
+  counterparts, one tick is one millisecond.  Core affinity and priorities
+  are ignored.  The host tools drive decodeSignal() directly, the decoder
+  task just waits on its empty queue.
+*/
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void*);
+typedef struct HostTask* TaskHandle_t;
+typedef struct HostQueue* QueueHandle_t;
+typedef struct HostQueue* SemaphoreHandle_t;
+
+#define pdTRUE         1
+#define pdFALSE        0
+#define pdPASS         pdTRUE
+#define errQUEUE_FULL  0
+#define portMAX_DELAY  0xffffffffUL
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define portTICK_PERIOD_MS 1
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue,
+                      TickType_t xTicksToWait);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer,
+                         TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode,
+                                   const char* pcName,
+                                   uint32_t usStackDepth, void* pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t* pvCreatedTask,
+                                   BaseType_t xCoreID);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+void vTaskDelay(TickType_t xTicksToDelay);
+
+#endif
@@ -0,0 +1,177 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  Host shim
+
+  Implementation of the Arduino / FreeRTOS stand-ins declared in
+  host/shim, plus the rtl_433_ESP transceiver calls signalReceiver.cpp
+  makes, without a transceiver.
+
+*/
+
+#include <time.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rtl_433_ESP.h"
+
+EspClass ESP;
+
+/*----------------------------- rtl_433_ESP transceiver -----------------------------*/
+
+bool rtl_433_ESP::setOOKModulation() {
+  ookModulation = true;
+  return true;
+}
+
+bool rtl_433_ESP::setFSKModulation() {
+  ookModulation = false;
+  return true;
+}
+
+/*----------------------------- Arduino -----------------------------*/
+
+static uint64_t monotonicMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+unsigned long micros() { return (unsigned long)monotonicMicros(); }
+
+unsigned long millis() { return (unsigned long)(monotonicMicros() / 1000); }
+
+/*----------------------------- FreeRTOS -----------------------------*/
+
+struct HostQueue {
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  std::deque<std::vector<uint8_t> > items;
+  std::mutex lock;
+  std::condition_variable changed;
+};
+
+struct HostTask {
+  TaskFunction_t code;
+  const char* name;
+  uint32_t stackDepth;
+};
+
+/**
+ * Wait on queue->changed until ready() or the ticks expire, with the queue
+ * lock held by the caller
+ */
+template <typename Predicate>
+static bool waitFor(HostQueue* queue, std::unique_lock<std::mutex>& held,
+                    TickType_t ticks, Predicate ready) {
+  if (ticks == portMAX_DELAY) {
+    queue->changed.wait(held, ready);
+    return true;
+  }
+  return queue->changed.wait_for(held, std::chrono::milliseconds(ticks), ready);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+  HostQueue* queue = new HostQueue;
+  queue->length = uxQueueLength;
+  queue->itemSize = uxItemSize;
+  return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue,
+                      TickType_t xTicksToWait) {
+  std::unique_lock<std::mutex> held(xQueue->lock);
+  if (!waitFor(xQueue, held, xTicksToWait,
+               [xQueue] { return xQueue->items.size() < xQueue->length; })) {
+    return errQUEUE_FULL;
+  }
+  const uint8_t* item = (const uint8_t*)pvItemToQueue;
+  xQueue->items.emplace_back(item, item + xQueue->itemSize);
+  xQueue->changed.notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer,
+                         TickType_t xTicksToWait) {
+  std::unique_lock<std::mutex> held(xQueue->lock);
+  if (!waitFor(xQueue, held, xTicksToWait,
+               [xQueue] { return !xQueue->items.empty(); })) {
+    return pdFALSE;
+  }
+  if (pvBuffer) {
+    memcpy(pvBuffer, xQueue->items.front().data(), xQueue->itemSize);
+  }
+  xQueue->items.pop_front();
+  xQueue->changed.notify_all();
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+  std::lock_guard<std::mutex> held(xQueue->lock);
+  return xQueue->items.size();
+}
+
+// A binary semaphore is a queue of length one with empty items, as in FreeRTOS
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return xQueueCreate(1, 0); }
+
+// A mutex is a binary semaphore created given, without priority inheritance
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  SemaphoreHandle_t mutex = xSemaphoreCreateBinary();
+  xSemaphoreGive(mutex);
+  return mutex;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+  return xQueueSend(xSemaphore, nullptr, 0);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore,
+                          TickType_t xTicksToWait) {
+  return xQueueReceive(xSemaphore, nullptr, xTicksToWait);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode,
+                                   const char* pcName,
+                                   uint32_t usStackDepth, void* pvParameters,
+                                   UBaseType_t uxPriority,
+                                   TaskHandle_t* pvCreatedTask,
+                                   BaseType_t xCoreID) {
+  (void)uxPriority;
+  (void)xCoreID;
+  HostTask* task = new HostTask;
+  task->code = pvTaskCode;
+  task->name = pcName;
+  task->stackDepth = usStackDepth;
+  if (pvCreatedTask) {
+    *pvCreatedTask = task;
+  }
+  std::thread(pvTaskCode, pvParameters).detach();
+  return pdPASS;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) {
+  (void)xTask;
+  return 0;
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
+}
@@ -0,0 +1,17 @@
+/*
+  rtl_433_ESP - host shim for pgmspace.h, flash and RAM are the same on host
+*/
+
+#ifndef HOST_PGMSPACE_H
+#define HOST_PGMSPACE_H
+
+#include <stdio.h>
+
+#define PROGMEM
+#define PGM_P              const char*
+#define PSTR(s)            (s)
+#define F(s)               (s)
+#define vsnprintf_P        vsnprintf
+#define pgm_read_byte(addr) (*(const unsigned char*)(addr))
+
+#endif
@@ -41,9 +41,20 @@ typedef struct bitbuffer {
 /// Clear the content of the bitbuffer.
 void bitbuffer_clear(bitbuffer_t *bits);
 
+/// Copy the rows in use of src to dst, the same as a struct copy if the bytes past the rows in use
+/// of both are clear, as bitbuffer_clear() and the add functions leave them.
+void bitbuffer_copy_used(bitbuffer_t *dst, bitbuffer_t const *src);
+
 /// Add a single bit at the end of the bitbuffer (MSB first).
 void bitbuffer_add_bit(bitbuffer_t *bits, int bit);
 
+/// Add count bits of the same value at the end of the bitbuffer, as count bitbuffer_add_bit() calls would.
+void bitbuffer_add_bits_run(bitbuffer_t *bits, int bit, unsigned count);
+
+/// Add the count (up to 32) low bits of word at the end of the bitbuffer, the most significant first,
+/// as count bitbuffer_add_bit() calls would.
+void bitbuffer_add_bits_word(bitbuffer_t *bits, uint32_t word, unsigned count);
+
 /// Add a new row to the bitbuffer.
 void bitbuffer_add_row(bitbuffer_t *bits);
 
@@ -0,0 +1,51 @@
+/** @file
+    Table-driven CRC and LFSR digest kernels.
+
+    Same signatures and results as the bit-serial crc4() to lfsr_digest16()
+    in util.h, but a byte per table lookup. A decoder opts in by calling the
+    _table variant, or every decoder with the CRC_TABLES build flag.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#ifndef INCLUDE_CRC_TABLE_H_
+#define INCLUDE_CRC_TABLE_H_
+
+#include <stdint.h>
+
+/// Number of tables built at runtime for polynomials and LFSR keys without a table in flash.
+#ifndef CRC_TABLE_CACHE
+#define CRC_TABLE_CACHE 4
+#endif
+
+/// CRC-4 by table, see crc4().
+uint8_t crc4_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init);
+
+/// CRC-7 by table, see crc7().
+uint8_t crc7_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init);
+
+/// CRC-8 by table, see crc8().
+uint8_t crc8_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init);
+
+/// CRC-8 LE by table, see crc8le().
+uint8_t crc8le_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init);
+
+/// CRC-16 LSB by table, see crc16lsb().
+uint16_t crc16lsb_table(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init);
+
+/// CRC-16 by table, see crc16().
+uint16_t crc16_table(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init);
+
+/// Digest-8 by "LFSR-based Toeplitz hash" by table, see lfsr_digest8().
+uint8_t lfsr_digest8_table(uint8_t const message[], unsigned bytes, uint8_t gen, uint8_t key);
+
+/// Digest-8 by "LFSR-based Toeplitz hash", byte reflect, bit reflect, by table, see lfsr_digest8_reflect().
+uint8_t lfsr_digest8_reflect_table(uint8_t const message[], int bytes, uint8_t gen, uint8_t key);
+
+/// Digest-16 by "LFSR-based Toeplitz hash" by table, see lfsr_digest16().
+uint16_t lfsr_digest16_table(uint8_t const message[], unsigned bytes, uint16_t gen, uint16_t key);
+
+#endif /* INCLUDE_CRC_TABLE_H_ */
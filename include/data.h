@@ -49,6 +49,7 @@
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
 
 typedef enum {
   DATA_DATA,   /**< pointer to data is stored */
@@ -86,8 +87,49 @@ typedef struct data {
   data_type_t type;
   unsigned retain; /**< incremented on data_retain, data_free only frees if this
                       is zero */
+  unsigned borrowed; /**< DATA_BORROW_* bits, storage data_free must not free */
 } data_t;
 
+#define DATA_BORROW_NODE       0x01 /**< the data_t itself is in an arena */
+#define DATA_BORROW_KEY        0x02
+#define DATA_BORROW_PRETTY_KEY 0x04
+#define DATA_BORROW_FORMAT     0x08
+#define DATA_BORROW_VALUE      0x10 /**< the DATA_STRING value */
+
+/** Bump allocator for the data_t trees built while decoding a pulse train.
+
+    While an arena is in use by a task, data_make() and friends place the
+    data_t nodes and the copies of keys, formats and string values in it,
+    falling back to the heap once it is full. data_free() leaves arena storage
+    alone, the arena is emptied in one step with data_arena_reset() once no
+    data built from it is referenced any more.
+*/
+typedef struct data_arena {
+  char *block;
+  size_t size;
+  size_t used;
+  size_t peak;        /**< highest use since data_arena_init */
+  unsigned overflows; /**< allocations that fell back to the heap */
+} data_arena_t;
+
+/** Setup an arena on the given block of memory. */
+R_API void data_arena_init(data_arena_t *arena, void *block, size_t size);
+
+/** Build the data of the calling task in arena, NULL for the heap.
+
+    @return the arena previously in use by the calling task
+*/
+R_API data_arena_t *data_arena_use(data_arena_t *arena);
+
+/** Release everything allocated from the arena. */
+R_API void data_arena_reset(data_arena_t *arena);
+
+/** Replace the key of a data item with a string that outlives it, e.g. a literal. */
+R_API void data_borrow_key(data_t *data, char const *key);
+
+/** Replace the format of a data item with a string that outlives it, e.g. a literal. */
+R_API void data_borrow_format(data_t *data, char const *format);
+
 /** Constructs a structured data object.
 
     Example:
@@ -203,6 +245,21 @@ R_API void print_value(data_output_t *output, data_type_t type,
 R_API void print_array_value(data_output_t *output, data_array_t *array,
                              char const *format, int idx);
 
+/** Print a structured data object as JSON into dst, always NUL terminated.
+
+    @return the length of the complete JSON, without the terminating NUL,
+   the output was truncated if this is len or more
+*/
 R_API size_t data_print_jsons(data_t *data, char *dst, size_t len);
 
+/** Print a structured data object as CBOR (RFC 8949) into dst.
+
+    Objects are maps, doubles are encoded as single precision floats when
+    that is exact.
+
+    @return the length of the complete CBOR encoding, the output was
+   truncated if this is more than len
+*/
+R_API size_t data_print_cbor(data_t *data, uint8_t *dst, size_t len);
+
 #endif // INCLUDE_DATA_H_
@@ -0,0 +1,54 @@
+/** @file
+    Decode context, the mutable state of one decode worker.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#ifndef INCLUDE_DECODE_CTX_H_
+#define INCLUDE_DECODE_CTX_H_
+
+#include "bitbuffer.h"
+#include "data.h"
+#include "pulse_classifier.h"
+
+/// Bytes of the arena the decoded messages of a pulse train are built in.
+#ifndef DECODE_ARENA_SIZE
+#define DECODE_ARENA_SIZE 2048
+#endif
+
+/// Scratch bitbuffers a decoder can borrow, see decoder_scratch_bitbuffer().
+#define DECODE_SCRATCH_BITBUFFERS 2
+
+/** Scratch state for running decoders against a pulse train.
+
+    The slicers and the demod loops keep everything they modify here, so
+    several workers can decode concurrently, each with its own context, as
+    long as they run disjoint decoder lists.
+*/
+typedef struct decode_ctx {
+    bitbuffer_t bits;                ///< slicer output handed to the decoders
+    bitbuffer_t *slice_bits;         ///< copy of bits for slicing groups, allocated on first use
+    bitbuffer_t *scratch[DECODE_SCRATCH_BITBUFFERS]; ///< lent to the decoders, allocated on first use
+    pulse_fingerprint_t fingerprint; ///< histogram fingerprint of the train being decoded
+    int classify;                    ///< pre-classifier enabled for the train being decoded
+    pulse_classifier_stats_t stats;  ///< slicer runs of this context
+    data_arena_t arena;              ///< data_t storage of the messages of the train being decoded
+    char arena_block[DECODE_ARENA_SIZE];
+} decode_ctx_t;
+
+/// Allocate a decode context, returns NULL if out of memory.
+decode_ctx_t *decode_ctx_create(void);
+
+/// Free a decode context.
+void decode_ctx_free(decode_ctx_t *ctx);
+
+/** Lend the scratch bitbuffers of ctx to the decoders run by the calling task.
+
+    @return the context previously lending to the calling task
+*/
+decode_ctx_t *decode_ctx_use(decode_ctx_t *ctx);
+
+#endif /* INCLUDE_DECODE_CTX_H_ */
@@ -37,6 +37,10 @@ void decoder_output_data(r_device *decoder, data_t *data);
 /// Output log.
 void decoder_output_log(r_device *decoder, int level, data_t *data);
 
+/// Cleared scratch bitbuffer number slot (0 or 1) of the decode context, instead of a bitbuffer_t on the stack.
+/// The bitbuffer stays lent to the decoder until it asks for the same slot again or returns.
+bitbuffer_t *decoder_scratch_bitbuffer(unsigned slot);
+
 // be terse, a maximum msg length of 60 characters is supported on the decoder_log_ functions
 // e.g. "FoobarCorp-XY3000: unexpected type code %02x"
 
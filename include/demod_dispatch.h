@@ -0,0 +1,63 @@
+/** @file
+    Decoder dispatch tables, registered decoders ordered by priority.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#ifndef INCLUDE_DEMOD_DISPATCH_H_
+#define INCLUDE_DEMOD_DISPATCH_H_
+
+#include "list.h"
+#include "pulse_data.h"
+#include "r_device.h"
+
+struct decode_ctx;
+
+/// Slicer of a modulation, see pulse_slicer.h.
+typedef int (*pulse_slicer_fn)(struct decode_ctx *ctx, pulse_data_t const *pulses, r_device *device);
+
+/// A decoder, or the leader of a slicing group, with its slicer.
+typedef struct demod_entry {
+    r_device *r_dev;
+    pulse_slicer_fn slicer;
+    unsigned followers; ///< decoders of the slicing group handed the bits of r_dev
+} demod_entry_t;
+
+/// The contiguous run of entries of one priority.
+typedef struct demod_level {
+    unsigned priority;
+    unsigned first;
+    unsigned count;
+} demod_level_t;
+
+/// Entries of one modulation family, in priority then registration order.
+typedef struct demod_table {
+    demod_entry_t *entries;
+    unsigned num_entries;
+    demod_level_t *levels; ///< in ascending priority
+    unsigned num_levels;
+    unsigned capacity;     ///< entries (and levels) allocated
+} demod_table_t;
+
+/// Dispatch tables of the OOK and FSK decoders.
+typedef struct demod_dispatch {
+    demod_table_t ook;
+    demod_table_t fsk;
+} demod_dispatch_t;
+
+/** Rebuild the dispatch tables from a list of registered decoders.
+
+    Slicing group followers are not entered, their leader hands them the bits.
+    Storage is kept between rebuilds and only grows.
+
+    @return 0 on success, -1 if out of memory (the tables are then empty)
+*/
+int demod_dispatch_build(demod_dispatch_t *dispatch, list_t const *r_devs);
+
+/// Free the storage of the dispatch tables.
+void demod_dispatch_free(demod_dispatch_t *dispatch);
+
+#endif /* INCLUDE_DEMOD_DISPATCH_H_ */
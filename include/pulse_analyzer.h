@@ -14,6 +14,27 @@
 
 #include "pulse_detect.h"
 
+#define MAX_HIST_BINS 16
+
+/// Histogram data for single bin
+typedef struct {
+    unsigned count;
+    int sum;
+    int mean;
+    int min;
+    int max;
+} hist_bin_t;
+
+/// Histogram data for all bins
+typedef struct {
+    unsigned bins_count;
+    hist_bin_t bins[MAX_HIST_BINS];
+} histogram_t;
+
+/// Add data to a histogram (unsorted), values that fit no bin once all
+/// MAX_HIST_BINS are used are not counted.
+void histogram_sum(histogram_t *hist, int const *data, unsigned len, float tolerance);
+
 /// Analyze and print result.
 void pulse_analyzer(pulse_data_t *data, int package_type);
 
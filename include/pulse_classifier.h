@@ -0,0 +1,51 @@
+/** @file
+    Pulse train pre-classifier, prunes decoders before slicing.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#ifndef INCLUDE_PULSE_CLASSIFIER_H_
+#define INCLUDE_PULSE_CLASSIFIER_H_
+
+#include "pulse_analyzer.h"
+#include "r_device.h"
+
+/// Window around a decoder width (fraction of the width) used when the decoder has no tolerance
+#define PULSE_CLASSIFIER_TOLERANCE (0.5f)
+
+/// Histogram fingerprint of a pulse train.
+typedef struct {
+    histogram_t pulses;
+    histogram_t gaps;
+    float samples_per_us;
+    int complete; ///< 0 if some widths did not fit the histogram, every decoder is then run
+} pulse_fingerprint_t;
+
+/// Pre-classifier counters.
+typedef struct {
+    unsigned trains;       ///< pulse trains fingerprinted
+    unsigned unclassified; ///< trains with too many distinct widths to prune on
+    unsigned runs;         ///< slicer runs
+    unsigned skipped;      ///< slicer runs skipped because the decoder timing cannot match
+    unsigned shared;       ///< slicer runs saved by decoding a slicing group on the same bits
+} pulse_classifier_stats_t;
+
+/// Set to 0 to run every decoder against every train.
+extern int pulse_classifier_enabled;
+
+/// Build the pulse and gap histograms of a pulse train, counting it in stats.
+void pulse_fingerprint(pulse_fingerprint_t *fp, pulse_classifier_stats_t *stats, pulse_data_t const *data);
+
+/** Check if the decoder timing can match the fingerprinted train.
+
+    Looks for a pulse or gap width within tolerance of the decoder short_width / long_width,
+    where the modulation places them. Decoders without a fixed symbol set always match.
+
+    @return 0 if no pulse or gap of the train fits the decoder timing, 1 otherwise
+*/
+int pulse_fingerprint_match(pulse_fingerprint_t const *fp, r_device const *r_dev);
+
+#endif /* INCLUDE_PULSE_CLASSIFIER_H_ */
@@ -33,7 +33,20 @@
   100 // Pulse width in ms to exceed to declare End Of Package (e.g. for non OOK
       // packages)
 
+#define PD_DURATION_MAX                                                        \
+  0xfffe // Longest pulse or gap width stored in place, longer widths escape
+#define PD_DURATION_ESCAPE                                                     \
+  0xffff // Width is held in long_width[] (see pulse_data_pulse())
+#define PD_MAX_LONG                                                            \
+  8 // Number of escaped long widths per pulse train, further ones saturate
+
 /// Data for a compact representation of generic pulse train.
+///
+/// rtl_433_ESP: pulse and gap widths are 16 bit, widths above PD_DURATION_MAX
+/// are stored as PD_DURATION_ESCAPE with the real width in long_width[].
+/// Storage is sized for capacity pulses, see pulse_data_alloc() and
+/// pulse_data_attach(), always read widths with pulse_data_pulse() and
+/// pulse_data_gap().
 typedef struct pulse_data {
   uint64_t offset; ///< Offset to first pulse in number of samples from start of
                    ///< stream.
@@ -42,9 +55,14 @@ typedef struct pulse_data {
   unsigned start_ago;   ///< Start of first pulse in number of samples ago.
   unsigned end_ago;     ///< End of last pulse in number of samples ago.
   unsigned int num_pulses;
-  int pulse[PD_MAX_PULSES]; ///< Width of pulses (high) in number of samples.
-  int gap[PD_MAX_PULSES];   ///< Width of gaps between pulses (low) in number of
-                            ///< samples.
+  unsigned int capacity; ///< Number of pulse / gap entries in the storage.
+  uint16_t *pulse; ///< Width of pulses (high) in number of samples.
+  uint16_t *gap;   ///< Width of gaps between pulses (low) in number of
+                   ///< samples.
+  unsigned num_long; ///< Number of escaped widths in long_width[].
+  uint16_t long_index[PD_MAX_LONG]; ///< Entry of escaped width, 2n for pulse n,
+                                    ///< 2n + 1 for gap n.
+  uint32_t long_width[PD_MAX_LONG]; ///< Escaped widths in number of samples.
   int ook_low_estimate;  ///< Estimate for the OOK low level (base noise level)
                          ///< at beginning of package.
   int ook_high_estimate; ///< Estimate for the OOK high level at end of package.
@@ -61,13 +79,76 @@ typedef struct pulse_data {
   // TODO: rtl_433_ESP additions
   //
   int signalRssi;
+  int fskModulation; ///< Received with the radio in FSK mode, OOK when 0.
   unsigned long signalDuration;
+  unsigned long signalEnd; ///< micros() at the end of the signal, for decode latency.
 #ifdef SIGNAL_RSSI
-  int rssi[PD_MAX_PULSES];
+  int8_t *rssi; ///< RSSI in dBm at each pulse.
 #endif
 
 } pulse_data_t;
 
+/// Bytes of pulse / gap (and rssi) storage needed for capacity pulses.
+size_t pulse_data_storage_size(unsigned capacity);
+
+/// Point the pulse / gap (and rssi) arrays of data at storage for capacity
+/// pulses, storage must be pulse_data_storage_size(capacity) bytes.
+void pulse_data_attach(pulse_data_t *data, void *storage, unsigned capacity);
+
+/// Allocate a cleared pulse_data_t with storage for capacity pulses in a
+/// single block, release with free(). Returns NULL on alloc failure.
+pulse_data_t *pulse_data_alloc(unsigned capacity);
+
+/// Escaped width of entry (2n for pulse n, 2n + 1 for gap n).
+int pulse_data_long_width(pulse_data_t const *data, unsigned entry);
+
+/// Store a width, escaping it if longer than PD_DURATION_MAX.
+static inline void pulse_data_set_width(pulse_data_t *data, uint16_t *field, unsigned entry, unsigned width)
+{
+  if (width <= PD_DURATION_MAX) {
+    *field = width;
+    return;
+  }
+  unsigned i = 0;
+  while (i < data->num_long && data->long_index[i] != entry)
+    ++i;
+  if (i == PD_MAX_LONG) {
+    *field = PD_DURATION_MAX; // table full, saturate
+    return;
+  }
+  data->long_index[i] = entry;
+  data->long_width[i] = width;
+  if (i == data->num_long)
+    data->num_long++;
+  *field = PD_DURATION_ESCAPE;
+}
+
+/// Width of pulse n in number of samples.
+static inline int pulse_data_pulse(pulse_data_t const *data, unsigned n)
+{
+  unsigned width = data->pulse[n];
+  return width != PD_DURATION_ESCAPE ? (int)width : pulse_data_long_width(data, 2 * n);
+}
+
+/// Width of gap n in number of samples.
+static inline int pulse_data_gap(pulse_data_t const *data, unsigned n)
+{
+  unsigned width = data->gap[n];
+  return width != PD_DURATION_ESCAPE ? (int)width : pulse_data_long_width(data, 2 * n + 1);
+}
+
+/// Set the width of pulse n in number of samples.
+static inline void pulse_data_set_pulse(pulse_data_t *data, unsigned n, unsigned width)
+{
+  pulse_data_set_width(data, &data->pulse[n], 2 * n, width);
+}
+
+/// Set the width of gap n in number of samples.
+static inline void pulse_data_set_gap(pulse_data_t *data, unsigned n, unsigned width)
+{
+  pulse_data_set_width(data, &data->gap[n], 2 * n + 1, width);
+}
+
 /// Clear the content of a pulse_data_t structure.
 void pulse_data_clear(pulse_data_t *data);
 
@@ -19,6 +19,9 @@ struct r_device;
 struct data;
 struct pulse_data;
 struct list;
+struct decode_ctx;
+struct demod_dispatch;
+struct demod_table;
 struct mg_mgr;
 
 /* general */
@@ -33,7 +36,7 @@ void r_free_cfg(struct r_cfg *cfg);
 
 /* device decoder protocols */
 
-void register_protocol(struct r_cfg *cfg, struct r_device *r_dev, char *arg);
+void register_protocol(struct r_cfg *cfg, struct r_device const *r_dev, unsigned protocol_num, char *arg);
 
 void free_protocol(struct r_device *r_dev);
 
@@ -51,9 +54,17 @@ char const **well_known_output_fields(struct r_cfg *cfg);
 
 char const **determine_csv_fields(struct r_cfg *cfg, char const *const *well_known, int *num_fields);
 
-int run_ook_demods(struct list *r_devs, struct pulse_data *pulse_data);
+int run_ook_demods(struct decode_ctx *ctx, struct demod_dispatch const *dispatch, struct pulse_data *pulse_data);
 
-int run_fsk_demods(struct list *r_devs, struct pulse_data *fsk_pulse_data);
+int run_fsk_demods(struct decode_ctx *ctx, struct demod_dispatch const *dispatch, struct pulse_data *fsk_pulse_data);
+
+/// Prepare ctx for running the demods passes on a new pulse train.
+void start_demods(struct decode_ctx *ctx, struct pulse_data *pulse_data);
+
+/// Run the decoders of one priority, lowers next_priority to the next larger priority of the table.
+/// A full decode runs passes from priority 0 up until a pass produces events.
+int run_demods_pass(struct decode_ctx *ctx, struct demod_table const *table, struct pulse_data *pulse_data,
+        unsigned priority, unsigned *next_priority);
 
 /* handlers */
 
@@ -65,6 +76,10 @@ void log_device_handler(struct r_device *r_dev, int level, struct data *data);
 
 void data_acquired_handler(struct r_device *r_dev, struct data *data);
 
+/// Serialize data into the message buffer in the configured format and pass it to the callback.
+/// A message larger than the buffer is logged and counted in truncatedMessages instead.
+void r_output_message(struct r_cfg *cfg, struct data *data);
+
 struct data *create_report_data(struct r_cfg *cfg, int level);
 
 void flush_report_data(struct r_cfg *cfg);
@@ -54,11 +54,15 @@ enum decode_return_codes {
 struct bitbuffer;
 struct data;
 
-/** Device protocol decoder struct. */
+/** Device protocol decoder struct.
+
+    Each decoder defines a const descriptor that stays in flash, register_protocol()
+    copies the descriptor of an enabled decoder to RAM and the decoder runs on that copy.
+*/
 typedef struct r_device {
-    unsigned protocol_num; ///< fixed sequence number, assigned in main().
+    unsigned protocol_num; ///< fixed sequence number, assigned by register_protocol().
 
-    /* information provided by each decoder */
+    /* information provided by each decoder, constant */
     char const *name;
     unsigned modulation;
     float short_width;
@@ -73,7 +77,7 @@ typedef struct r_device {
     unsigned disabled; ///< 0: default enabled, 1: default disabled, 2: disabled, 3: disabled and hidden
     char const *const *fields; ///< List of fields this decoder produces; required for CSV output. NULL-terminated.
 
-    /* public for each decoder */
+    /* public for each decoder, set on the registered copy */
     int verbose;
     int verbose_bits;
     void (*log_fn)(struct r_device *decoder, int level, struct data *data);
@@ -85,6 +89,10 @@ typedef struct r_device {
     unsigned decode_messages;
     unsigned decode_fails[5];
 
+    /* slicing group, decoders with the same modulation, timing and priority share one slicer run */
+    struct r_device *slice_next; ///< next decoder of the group, decoded on the same bits
+    unsigned slice_follower;     ///< 1 if an earlier decoder of the group runs the slicer
+
     /* private for flex decoder and output callback */
     void *decode_ctx;
     void *output_ctx;
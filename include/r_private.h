@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <time.h>
 #include "list.h"
+#include "demod_dispatch.h"
 // #include "baseband.h"
 #include "pulse_detect.h"
 // #include "fileformat.h"
@@ -52,6 +53,7 @@ struct dm_state {
     */
     /* Protocol states */
     list_t r_devs;
+    demod_dispatch_t dispatch; ///< r_devs by modulation and priority, rebuilt on (un)register
 
     pulse_data_t    pulse_data;
     /*
@@ -7,6 +7,7 @@
 
 #include "list.h"
 #include <signal.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <time.h>
 
@@ -59,6 +60,11 @@ typedef enum {
   DEVICE_STATE_STARTED,
 } device_state_t;
 
+typedef enum {
+  MESSAGE_JSON, ///< NUL terminated JSON text to callback
+  MESSAGE_CBOR, ///< CBOR (RFC 8949) encoding to binaryCallback
+} message_format_t;
+
 typedef struct r_cfg {
   /*
   device_mode_t dev_mode; ///< Input device run mode
@@ -112,7 +118,7 @@ typedef struct r_cfg {
   time_t stats_time;
   int no_default_devices;
   */
-  struct r_device *devices;
+  struct r_device const *const *devices; ///< descriptors of the decoders, in flash
   uint16_t num_r_devices;
 
   // list_t data_tags;
@@ -138,12 +144,18 @@ typedef struct r_cfg {
   //
   char *messageBuffer; // message buffer for message callback
   int bufferSize;      // size of message buffer for message callback
+  message_format_t messageFormat;
+  unsigned truncatedMessages; // messages dropped as larger than the buffer
   /**
    * callback to controlling program to be executed when a message is received.
    * Object point passed is a pointer to a JSON formatted message for
    * publishing.
    */
   void (*callback)(char *message);
+  /**
+   * callback for MESSAGE_CBOR, passed the encoded message and its length.
+   */
+  void (*binaryCallback)(const unsigned char *message, size_t length);
 } r_cfg_t;
 
 #endif /* INCLUDE_RTL_433_H_ */
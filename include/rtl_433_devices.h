@@ -261,7 +261,7 @@
 #  define NUMOF_FSK_DEVICES 0
 #endif
 
-#define DECL(name) extern r_device name;
+#define DECL(name) extern r_device const name;
 DEVICES
 #undef DECL
 
@@ -0,0 +1,30 @@
+/** @file
+    Unit conversion of decoded data to SI or customary units.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#ifndef INCLUDE_UNIT_CONVERT_H_
+#define INCLUDE_UNIT_CONVERT_H_
+
+#include "data.h"
+#include "rtl_433.h"
+
+/** Intern the converted keys of the fields a decoder declares.
+
+    Run on registration so decoding does not allocate, keys that are not
+    declared are interned on first use.
+*/
+void unit_convert_register(conversion_mode_t mode, char const *const *fields);
+
+/** Convert the unit of the double fields of data in place.
+
+    Keys and formats are pointed at interned strings and the values
+    converted, e.g. "temperature_F" becomes "temperature_C" for CONVERT_SI.
+*/
+void unit_convert_data(conversion_mode_t mode, data_t *data);
+
+#endif /* INCLUDE_UNIT_CONVERT_H_ */
@@ -0,0 +1,273 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+*/
+
+#include "edgeSource.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fatal.h"
+
+/*----------------------------- TimedEdgeSource -----------------------------*/
+
+TimedEdgeSource::TimedEdgeSource()
+    : tickMicros(1000),
+      idleMicros(1000000),
+      leadMicros(1000),
+      signalRssi(-60),
+      noiseRssi(-95),
+      _sink(nullptr),
+      _now(0),
+      _next(0),
+      _nextEdge(0),
+      _rssiStart(1),
+      _rssiEnd(0),
+      _signals(0),
+      _finished(false) {}
+
+void TimedEdgeSource::begin(EdgeSink sink) {
+  _sink = sink;
+  if (!_signals && _widths.empty()) {
+    startSignal();
+  }
+}
+
+void TimedEdgeSource::end() { _sink = nullptr; }
+
+int TimedEdgeSource::rssi() {
+  bool inSignal = (int32_t)(_now - _rssiStart) >= 0 &&
+                  (int32_t)(_rssiEnd - _now) >= 0;
+  return inSignal ? signalRssi : noiseRssi;
+}
+
+/**
+ * Schedule the next signal after the idle time, the first edge is the rising
+ * edge of its first pulse, the gap after its last pulse has no edge
+ */
+void TimedEdgeSource::startSignal() {
+  _widths.clear();
+  _next = 0;
+  uint32_t start = (_signals ? _rssiEnd : _now) + idleMicros;
+  if (!nextSignal(_widths) || _widths.empty()) {
+    _widths.clear();
+    _rssiStart = start + 1; // no more signal strength, the idle time runs out
+    _rssiEnd = start;
+    return;
+  }
+  if (_widths.size() % 2 == 0) {
+    _widths.pop_back(); // trailing gap
+  }
+  _signals++;
+  _nextEdge = start + leadMicros;
+  _rssiStart = start;
+  _rssiEnd = _nextEdge;
+  for (uint32_t width : _widths) {
+    _rssiEnd += width;
+  }
+}
+
+void TimedEdgeSource::poll() {
+  if (_finished) {
+    return;
+  }
+  _now += tickMicros;
+  for (;;) {
+    if (_widths.empty()) {
+      _finished = (int32_t)(_now - _rssiEnd) >= 0;
+      return;
+    }
+    if ((int32_t)(_nextEdge - _now) > 0) {
+      return;
+    }
+    // rising edge before each pulse, falling edge after it
+    if (_sink) {
+      _sink(_nextEdge, _next % 2 == 0);
+    }
+    if (_next == _widths.size()) {
+      startSignal();
+      continue;
+    }
+    _nextEdge += _widths[_next++];
+  }
+}
+
+/*----------------------------- ReplayEdgeSource -----------------------------*/
+
+ReplayEdgeSource::ReplayEdgeSource() : repeat(1), _played(0) {}
+
+ReplayEdgeSource::~ReplayEdgeSource() {
+  for (pulse_data_t* train : _trains) {
+    free(train);
+  }
+}
+
+/**
+ * Append "+pulse-gap(rssi)" tokens from text to train, returns false on
+ * anything that is not part of a pulse train
+ */
+static bool parsePulses(const char* text, pulse_data_t* train) {
+  const char* p = text;
+  while (*p) {
+    if (isspace((unsigned char)*p)) {
+      p++;
+    } else if (*p == '+') {
+      if (train->num_pulses >= train->capacity) {
+        return true;
+      }
+      pulse_data_set_pulse(train, train->num_pulses, strtoul(p + 1, (char**)&p, 10));
+      pulse_data_set_gap(train, train->num_pulses, 0);
+      train->num_pulses++;
+    } else if (*p == '-' && train->num_pulses > 0) {
+      pulse_data_set_gap(train, train->num_pulses - 1, strtoul(p + 1, (char**)&p, 10));
+    } else if (*p == '(' && train->num_pulses > 0) {
+#ifdef SIGNAL_RSSI
+      train->rssi[train->num_pulses - 1] = strtol(p + 1, (char**)&p, 10);
+#else
+      strtol(p + 1, (char**)&p, 10);
+#endif
+      if (*p == ')') {
+        p++;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Keep a copy of the parsed train with storage sized to its pulse count
+ */
+void ReplayEdgeSource::keepTrain(pulse_data_t* train) {
+  if (train->num_pulses == 0) {
+    return;
+  }
+  pulse_data_t* sized = pulse_data_alloc(train->num_pulses);
+  if (!sized) {
+    WARN_CALLOC("ReplayEdgeSource::keepTrain()");
+    return;
+  }
+  pulse_data_t header = *train;
+  pulse_data_attach(&header, sized->pulse, train->num_pulses);
+  *sized = header;
+  memcpy(sized->pulse, train->pulse, train->num_pulses * sizeof(*train->pulse));
+  memcpy(sized->gap, train->gap, train->num_pulses * sizeof(*train->gap));
+#ifdef SIGNAL_RSSI
+  memcpy(sized->rssi, train->rssi, train->num_pulses * sizeof(*train->rssi));
+#endif
+  _trains.push_back(sized);
+}
+
+void ReplayEdgeSource::load(FILE* file) {
+  const int lineSize = 16384;
+  char* line = (char*)malloc(lineSize);
+  pulse_data_t* parsed = pulse_data_alloc(PD_MAX_PULSES);
+  if (!line || !parsed) {
+    WARN_MALLOC("ReplayEdgeSource::load()");
+    free(line);
+    free(parsed);
+    return;
+  }
+  pulse_data_t* train = nullptr;
+  while (fgets(line, lineSize, file)) {
+    const char* raw = strstr(line, "RAW (");
+    if (raw) {
+      if (train) {
+        keepTrain(train);
+      }
+      train = parsed;
+      pulse_data_clear(train);
+      char* end;
+      train->signalDuration = strtoul(raw + 5, &end, 10);
+      const char* pulses = strstr(end, "):");
+      if (!pulses || !parsePulses(pulses + 2, train)) {
+        keepTrain(train);
+        train = nullptr;
+      }
+    } else if (train && !parsePulses(line, train)) {
+      keepTrain(train);
+      train = nullptr;
+    }
+  }
+  if (train) {
+    keepTrain(train);
+  }
+  free(parsed);
+  free(line);
+}
+
+bool ReplayEdgeSource::nextSignal(std::vector<uint32_t>& widths) {
+  if (_trains.empty() || _played >= _trains.size() * repeat) {
+    return false;
+  }
+  const pulse_data_t* train = _trains[_played++ % _trains.size()];
+  for (unsigned i = 0; i < train->num_pulses; i++) {
+    widths.push_back(pulse_data_pulse(train, i));
+    widths.push_back(pulse_data_gap(train, i));
+  }
+  return true;
+}
+
+/*----------------------------- SyntheticEdgeSource -----------------------------*/
+
+SyntheticEdgeSource::SyntheticEdgeSource(unsigned seed)
+    : count(100),
+      shortWidth(500),
+      longWidth(1000),
+      gapWidth(500),
+      resetWidth(4000),
+      bits(36),
+      repeats(6),
+      jitterPercent(5),
+      glitchPercent(2),
+      _rng(seed),
+      _generated(0) {}
+
+bool SyntheticEdgeSource::nextSignal(std::vector<uint32_t>& widths) {
+  if (count && _generated >= count) {
+    return false;
+  }
+  _generated++;
+  std::uniform_int_distribution<int> jitter(-(int)jitterPercent, jitterPercent);
+  std::uniform_int_distribution<unsigned> percent(0, 99);
+  std::uniform_int_distribution<uint32_t> glitch(5, 40);
+  auto jittered = [&](uint32_t width) {
+    return (uint32_t)(width + (int)width * jitter(_rng) / 100);
+  };
+
+  std::vector<bool> payload(bits);
+  for (unsigned b = 0; b < bits; b++) {
+    payload[b] = _rng() & 1;
+  }
+  for (unsigned r = 0; r < repeats; r++) {
+    for (unsigned b = 0; b < bits; b++) {
+      widths.push_back(jittered(payload[b] ? longWidth : shortWidth));
+      uint32_t gap = jittered(b + 1 < bits ? gapWidth : resetWidth);
+      if (gap > 100 && percent(_rng) < glitchPercent) {
+        // a glitch splits the gap, the receiver filters it
+        uint32_t first = gap / 2;
+        uint32_t width = glitch(_rng);
+        widths.push_back(first);
+        widths.push_back(width);
+        gap -= first + width;
+      }
+      widths.push_back(gap);
+    }
+  }
+  return true;
+}
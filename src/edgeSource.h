@@ -0,0 +1,206 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  edgeSource - where the receiver gets its edges and signal strength from
+
+  The receiver consumes an EdgeSource: the receiver GPIO with the radio RSSI
+  ( GpioEdgeSource, see receiver.h ), or a source playing signals in virtual
+  time, replayed from RAW logs ( ReplayEdgeSource ) or generated
+  ( SyntheticEdgeSource ). The timed sources do not depend on the Arduino core
+  and run the receiver faster than real time on a host, see
+  host/pipeline_bench.cpp.
+
+*/
+
+#ifndef rtl_433_EDGESOURCE_H
+#define rtl_433_EDGESOURCE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "pulse_data.h"
+}
+
+/**
+ * Receives an edge, the time in the time base of the source and the level
+ * after the edge
+ */
+typedef void (*EdgeSink)(uint32_t time, bool level);
+
+class EdgeSource {
+public:
+  virtual ~EdgeSource() {}
+
+  /**
+   * Start delivering edges to sink, from an interrupt or from poll()
+   */
+  virtual void begin(EdgeSink sink) = 0;
+
+  /**
+   * Stop delivering edges
+   */
+  virtual void end() = 0;
+
+  /**
+   * Time base of the edges in microseconds
+   */
+  virtual uint32_t now() = 0;
+
+  /**
+   * Signal strength at now() in dBm
+   */
+  virtual int rssi() = 0;
+
+  /**
+   * Called by the receiver task every tick, a source without interrupt
+   * delivers the edges that are due
+   */
+  virtual void poll() {}
+};
+
+/**
+ * Plays a sequence of signals in virtual time. Every poll() advances the time
+ * by one tick and delivers the edges up to it, the RSSI is the strength of the
+ * signal while it plays and the noise floor in the idle time between signals.
+ */
+class TimedEdgeSource : public EdgeSource {
+public:
+  TimedEdgeSource();
+
+  void begin(EdgeSink sink);
+  void end();
+  uint32_t now() { return _now; }
+  int rssi();
+  void poll();
+
+  /**
+   * True once the last signal and the idle time after it are played
+   */
+  bool finished() const { return _finished; }
+
+  /**
+   * Signals played so far
+   */
+  unsigned signals() const { return _signals; }
+
+  /**
+   * Time advanced by each poll(), 1000 us for one FreeRTOS tick
+   */
+  uint32_t tickMicros;
+  /**
+   * Idle time before each signal, longer than MINIMUM_SIGNAL_LENGTH so the
+   * receiver ends the previous signal
+   */
+  uint32_t idleMicros;
+  /**
+   * Time the RSSI rises ahead of the first edge of a signal
+   */
+  uint32_t leadMicros;
+  int signalRssi;
+  int noiseRssi;
+
+protected:
+  /**
+   * Widths of the next signal, alternating pulse (high) and gap (low),
+   * starting with a pulse. False when there are no more signals.
+   */
+  virtual bool nextSignal(std::vector<uint32_t>& widths) = 0;
+
+private:
+  void startSignal();
+
+  EdgeSink _sink;
+  uint32_t _now;
+  std::vector<uint32_t> _widths;
+  size_t _next;         // index of the width ended by the next edge
+  uint32_t _nextEdge;   // time of the next edge
+  uint32_t _rssiStart;  // signal strength from _rssiStart to _rssiEnd
+  uint32_t _rssiEnd;
+  unsigned _signals;
+  bool _finished;
+};
+
+/**
+ * Replays the pulse trains of RAW logs, the "RAW (duration): +pulse-gap..."
+ * lines printed by RAW_SIGNAL_DEBUG and PUBLISH_UNPARSED ( see the .md
+ * captures in signals/ )
+ */
+class ReplayEdgeSource : public TimedEdgeSource {
+public:
+  ReplayEdgeSource();
+  ~ReplayEdgeSource();
+
+  /**
+   * Add the pulse trains of a RAW log, pulses may continue on the following
+   * lines until a line that is not part of the train
+   */
+  void load(FILE* file);
+
+  /**
+   * The loaded pulse trains, sized to their pulse count
+   */
+  const std::vector<pulse_data_t*>& trains() const { return _trains; }
+
+  /**
+   * Times the loaded trains are played, 1 by default
+   */
+  unsigned repeat;
+
+protected:
+  bool nextSignal(std::vector<uint32_t>& widths);
+
+private:
+  void keepTrain(pulse_data_t* train);
+
+  std::vector<pulse_data_t*> _trains;
+  size_t _played;
+};
+
+/**
+ * Generates OOK PWM signals with random payloads: each bit is a short or a
+ * long pulse followed by a gap, the message is repeated. Widths are jittered
+ * and short glitches, filtered by the receiver, are added to the gaps.
+ */
+class SyntheticEdgeSource : public TimedEdgeSource {
+public:
+  explicit SyntheticEdgeSource(unsigned seed = 433);
+
+  /**
+   * Number of signals generated, 0 for no limit
+   */
+  unsigned count;
+  uint32_t shortWidth;
+  uint32_t longWidth;
+  uint32_t gapWidth;
+  uint32_t resetWidth; ///< gap between the repeats of the message
+  unsigned bits;
+  unsigned repeats;
+  unsigned jitterPercent;
+  unsigned glitchPercent; ///< chance of a glitch in a gap
+
+protected:
+  bool nextSignal(std::vector<uint32_t>& widths);
+
+private:
+  std::mt19937 _rng;
+  unsigned _generated;
+};
+
+#endif
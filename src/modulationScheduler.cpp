@@ -0,0 +1,45 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+*/
+
+#include "modulationScheduler.h"
+
+ModulationScheduler::ModulationScheduler(uint32_t ookWindow, uint32_t fskWindow)
+    : ookWindow(ookWindow),
+      fskWindow(fskWindow),
+      _ook(true),
+      _windowStart(0),
+      _switches(0) {}
+
+void ModulationScheduler::reset(uint32_t time, bool ook) {
+  _ook = ook;
+  _windowStart = time;
+}
+
+bool ModulationScheduler::update(uint32_t time, bool receiving) {
+  if (receiving) {
+    return false; // extend the window to the end of the signal
+  }
+  const uint32_t window = _ook ? ookWindow : fskWindow;
+  const uint32_t next = _ook ? fskWindow : ookWindow;
+  if (!next || (window && time - _windowStart < window)) {
+    return false;
+  }
+  _ook = !_ook;
+  _windowStart = time;
+  _switches++;
+  return true;
+}
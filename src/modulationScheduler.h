@@ -0,0 +1,61 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  modulationScheduler - time slices of OOK and FSK reception
+
+  With both decoder sets registered ( DUAL_MODULATION ) the receiver task
+  asks the scheduler on every tick whether to retune the radio. The windows
+  alternate, a window is extended while a signal is being received so no
+  signal is cut by a retune.
+
+*/
+
+#ifndef rtl_433_MODULATIONSCHEDULER_H
+#define rtl_433_MODULATIONSCHEDULER_H
+
+#include <stdint.h>
+
+class ModulationScheduler {
+public:
+  /**
+   * Window lengths in microseconds. A modulation with a window of 0 is not
+   * scheduled, with both 0 the radio stays as it is.
+   */
+  ModulationScheduler(uint32_t ookWindow, uint32_t fskWindow);
+
+  /**
+   * Start a window of modulation ook at time
+   */
+  void reset(uint32_t time, bool ook);
+
+  /**
+   * One receiver tick, true when the radio is to be retuned to ook()
+   */
+  bool update(uint32_t time, bool receiving);
+
+  bool ook() const { return _ook; }
+  unsigned long switches() const { return _switches; }
+
+  uint32_t ookWindow;
+  uint32_t fskWindow;
+
+private:
+  bool _ook;
+  uint32_t _windowStart;
+  unsigned long _switches;
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+*/
+
+#include "noiseFloor.h"
+
+#include <math.h>
+
+/**
+ * 1/256 dB to dB, rounded to nearest
+ */
+static int fromQ8(int32_t value) {
+  return value >= 0 ? (value + 128) / 256 : -((128 - value) / 256);
+}
+
+/*----------------------------- BlockAverageNoiseFloor -----------------------------*/
+
+BlockAverageNoiseFloor::BlockAverageNoiseFloor(unsigned samples)
+    : _samples(samples), _count(0), _total(0), _estimate(0), _ready(false) {}
+
+void BlockAverageNoiseFloor::add(int rssi) {
+  _count++;
+  _total += rssi;
+  if (_count > _samples) {
+    _estimate = _total / (long)_count;
+    _total = 0;
+    _count = 0;
+    _ready = true;
+  }
+}
+
+/*----------------------------- EwmaNoiseFloor -----------------------------*/
+
+EwmaNoiseFloor::EwmaNoiseFloor(unsigned shift, int clip)
+    : _shift(shift), _clip(clip * 65536), _value(0), _count(0) {}
+
+void EwmaNoiseFloor::add(int rssi) {
+  int32_t sample = rssi * 65536;
+  if (!_count) {
+    _value = sample;
+  } else if (sample > _value + _clip) {
+    sample = _value + _clip;
+  }
+  _value += (sample - _value) / (1 << _shift);
+  if (_count < (1u << _shift)) {
+    _count++;
+  }
+}
+
+int EwmaNoiseFloor::estimate() const { return fromQ8(_value / 256); }
+
+/*----------------------------- QuantileNoiseFloor -----------------------------*/
+
+QuantileNoiseFloor::QuantileNoiseFloor(float quantile, unsigned window)
+    : _quantile(quantile),
+      _window(window < 5 ? 5 : window),
+      _count(0),
+      _estimate(0),
+      _ready(false) {}
+
+void QuantileNoiseFloor::add(int rssi) {
+  const float x = rssi;
+  if (_count < 5) { // the first five samples are the markers, in order
+    int i = _count++;
+    for (; i > 0 && _height[i - 1] > x; i--) {
+      _height[i] = _height[i - 1];
+    }
+    _height[i] = x;
+    if (_count == 5) {
+      for (int m = 0; m < 5; m++) {
+        _position[m] = m;
+      }
+      _desired[0] = 0;
+      _desired[1] = 2 * _quantile;
+      _desired[2] = 4 * _quantile;
+      _desired[3] = 2 + 2 * _quantile;
+      _desired[4] = 4;
+    }
+    return;
+  }
+
+  // cell of x, the extreme markers follow the minimum and maximum
+  int k;
+  if (x < _height[0]) {
+    _height[0] = x;
+    k = 0;
+  } else if (x >= _height[4]) {
+    _height[4] = x;
+    k = 3;
+  } else {
+    for (k = 0; x >= _height[k + 1]; k++) {
+    }
+  }
+  for (int m = k + 1; m < 5; m++) {
+    _position[m]++;
+  }
+  const float increment[5] = {0, _quantile / 2, _quantile, (1 + _quantile) / 2, 1};
+  for (int m = 0; m < 5; m++) {
+    _desired[m] += increment[m];
+  }
+
+  // move the middle markers towards their desired positions, along a
+  // parabola through the neighbours, or linearly if that leaves them
+  for (int m = 1; m < 4; m++) {
+    float d = _desired[m] - _position[m];
+    if ((d >= 1 && _position[m + 1] - _position[m] > 1) ||
+        (d <= -1 && _position[m - 1] - _position[m] < -1)) {
+      int s = d > 0 ? 1 : -1;
+      float parabolic =
+          _height[m] +
+          (float)s / (_position[m + 1] - _position[m - 1]) *
+              ((_position[m] - _position[m - 1] + s) * (_height[m + 1] - _height[m]) /
+                   (_position[m + 1] - _position[m]) +
+               (_position[m + 1] - _position[m] - s) * (_height[m] - _height[m - 1]) /
+                   (_position[m] - _position[m - 1]));
+      if (_height[m - 1] < parabolic && parabolic < _height[m + 1]) {
+        _height[m] = parabolic;
+      } else {
+        _height[m] += s * (_height[m + s] - _height[m]) / (_position[m + s] - _position[m]);
+      }
+      _position[m] += s;
+    }
+  }
+
+  if (++_count >= _window) { // start over, the estimate follows the noise floor
+    _estimate = (int)lroundf(_height[2]);
+    _ready = true;
+    _count = 0;
+  }
+}
+
+/*----------------------------- MinNoiseFloor -----------------------------*/
+
+MinNoiseFloor::MinNoiseFloor(unsigned block, unsigned riseTicks)
+    : _block(block ? block : 1),
+      _rise(0),
+      _count(0),
+      _total(0),
+      _value(0),
+      _ready(false) {
+  _rise = (int32_t)(256 * _block / (riseTicks ? riseTicks : 1));
+  if (_rise < 1) {
+    _rise = 1;
+  }
+}
+
+void MinNoiseFloor::add(int rssi) {
+  _total += rssi;
+  if (++_count < _block) {
+    return;
+  }
+  int32_t mean = _total * 256 / (int32_t)_block;
+  _total = 0;
+  _count = 0;
+  if (!_ready || mean < _value) {
+    _value = mean;
+    _ready = true;
+  } else {
+    _value += _rise;
+  }
+}
+
+int MinNoiseFloor::estimate() const { return fromQ8(_value); }
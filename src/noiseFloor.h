@@ -0,0 +1,142 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  noiseFloor - estimates of the RSSI noise floor for the signal threshold
+
+  The receiver task adds the RSSI of every tick, with AUTORSSITHRESHOLD the
+  RSSI threshold is the estimate plus RSSI_THRESHOLD. Every estimator uses a
+  fixed amount of memory. Signals are part of the samples, the estimators
+  other than the block average are built to ignore them. See
+  host/noise_floor_bench.cpp for a comparison on RSSI traces.
+
+*/
+
+#ifndef rtl_433_NOISEFLOOR_H
+#define rtl_433_NOISEFLOOR_H
+
+#include <stdint.h>
+
+class NoiseFloor {
+public:
+  virtual ~NoiseFloor() {}
+
+  /**
+   * Add the RSSI of one receiver tick
+   */
+  virtual void add(int rssi) = 0;
+
+  /**
+   * Noise floor in dBm, valid once ready()
+   */
+  virtual int estimate() const = 0;
+
+  virtual bool ready() const = 0;
+
+  virtual const char* name() const = 0;
+};
+
+/**
+ * Mean of blocks of samples, updated at the end of each block. Slow to
+ * adapt and raised by every signal in the block.
+ */
+class BlockAverageNoiseFloor : public NoiseFloor {
+public:
+  explicit BlockAverageNoiseFloor(unsigned samples);
+
+  void add(int rssi);
+  int estimate() const { return _estimate; }
+  bool ready() const { return _ready; }
+  const char* name() const { return "block"; }
+
+private:
+  unsigned _samples;
+  unsigned _count;
+  long _total;
+  int _estimate;
+  bool _ready;
+};
+
+/**
+ * Exponentially weighted moving average with a time constant of 2^shift
+ * samples. Samples more than clip dB above the estimate are clipped to it,
+ * so a signal raises the estimate by at most clip / 2^shift per sample.
+ */
+class EwmaNoiseFloor : public NoiseFloor {
+public:
+  explicit EwmaNoiseFloor(unsigned shift = 10, int clip = 3);
+
+  void add(int rssi);
+  int estimate() const;
+  bool ready() const { return _count >= (1u << _shift); }
+  const char* name() const { return "ewma"; }
+
+private:
+  unsigned _shift;
+  int32_t _clip; // 1/65536 dB
+  int32_t _value; // 1/65536 dB, fine enough for a step of 2^-shift
+  unsigned _count;
+};
+
+/**
+ * Quantile of the samples of a window, estimated with the P² algorithm
+ * ( Jain and Chlamtac, 1985 ) in five markers. The estimate is the quantile
+ * of the most recent complete window. A quantile below the share of samples
+ * taken by signals ignores them.
+ */
+class QuantileNoiseFloor : public NoiseFloor {
+public:
+  explicit QuantileNoiseFloor(float quantile = 0.3f, unsigned window = 2000);
+
+  void add(int rssi);
+  int estimate() const { return _estimate; }
+  bool ready() const { return _ready; }
+  const char* name() const { return "quantile"; }
+
+private:
+  float _quantile;
+  unsigned _window;
+  unsigned _count;
+  float _height[5]; // marker heights
+  int _position[5]; // marker positions
+  float _desired[5]; // desired marker positions
+  int _estimate;
+  bool _ready;
+};
+
+/**
+ * Minimum of the means of blocks of samples. The estimate follows a lower
+ * block mean at once and rises by 1 dB every riseTicks samples otherwise, so
+ * signals and interference hardly move it.
+ */
+class MinNoiseFloor : public NoiseFloor {
+public:
+  explicit MinNoiseFloor(unsigned block = 16, unsigned riseTicks = 1000);
+
+  void add(int rssi);
+  int estimate() const;
+  bool ready() const { return _ready; }
+  const char* name() const { return "min"; }
+
+private:
+  unsigned _block;
+  int32_t _rise; // 1/256 dB per block
+  unsigned _count;
+  int32_t _total;
+  int32_t _value; // 1/256 dB
+  bool _ready;
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+*/
+
+#include "pulseAssembler.h"
+
+PulseAssembler::PulseAssembler(unsigned minPulseLength)
+    : _minPulseLength(minPulseLength), _train(nullptr), _lastChange(0),
+      _nrpulses(0) {}
+
+void PulseAssembler::start(pulse_data_t* train, uint32_t now) {
+  _train = train;
+  _train->pulse[0] = 0;
+  _train->gap[0] = 0;
+  _train->num_long = 0;
+  _lastChange = now;
+  _nrpulses = 0;
+}
+
+void PulseAssembler::addEdge(uint32_t time, bool level, int rssi) {
+  const uint32_t duration = time - _lastChange;
+
+  /* We first do some filtering (same as pilight BPF) */
+
+  if (!_train || duration <= _minPulseLength) {
+    return;
+  }
+#ifdef SIGNAL_RSSI
+  _train->rssi[_nrpulses] = rssi;
+#else
+  (void)rssi;
+#endif
+  if (!level) {
+    pulse_data_set_pulse(_train, _nrpulses, duration);
+  } else if (_train->pulse[_nrpulses] > 0) { // Did we collect a + pulse ?
+    pulse_data_set_gap(_train, _nrpulses, duration);
+    _nrpulses = (_nrpulses + 1) % PD_MAX_PULSES;
+    _train->pulse[_nrpulses] = 0; // Slots are recycled without clearing
+    _train->gap[_nrpulses] = 0;
+  } else if (_nrpulses > 1) { // Have we received any data ?
+    // We received a random positive blib
+    pulse_data_set_gap(_train, _nrpulses - 1,
+                       pulse_data_gap(_train, _nrpulses - 1) + duration);
+  } else {
+    pulse_data_set_gap(_train, _nrpulses, duration);
+    _nrpulses = (_nrpulses + 1) % PD_MAX_PULSES;
+    _train->pulse[_nrpulses] = 0;
+    _train->gap[_nrpulses] = 0;
+  }
+  _lastChange = time;
+}
@@ -0,0 +1,183 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  pulseAssembler - receiver edges to pulse train, outside of the interrupt
+
+  The receiver interrupt only pushes the time and new level of each edge
+  into an EdgeRing. The receiver task drains the ring into a PulseAssembler,
+  which filters the edges and builds the pulse / gap widths of the train.
+  Neither depends on the Arduino core, see host/edge_ring_test.cpp.
+
+*/
+
+#ifndef rtl_433_PULSEASSEMBLER_H
+#define rtl_433_PULSEASSEMBLER_H
+
+#include <stdint.h>
+
+#include <atomic>
+
+extern "C" {
+#include "pulse_data.h"
+}
+
+/**
+ * Edges are stored inline so the push is part of the IRAM interrupt handler
+ */
+#define EDGE_RING_INLINE inline __attribute__((always_inline))
+
+/**
+ * A receiver edge, micros() when it happened and the level after it
+ */
+typedef struct {
+  uint32_t time;
+  uint32_t level;
+} edge_t;
+
+/**
+ * Single producer, single consumer ring of edges, the interrupt handler
+ * pushes and the receiver task pops. Lock free: each side only writes its own
+ * index, the indices run freely and are masked on access. Size must be a
+ * power of two.
+ */
+template <unsigned Size>
+class EdgeRing {
+  static_assert(Size && (Size & (Size - 1)) == 0, "Size must be a power of two");
+
+public:
+  EdgeRing() : _head(0), _tail(0), _dropped(0) {}
+
+  /**
+   * Producer side, false and counted as dropped if the ring is full
+   */
+  EDGE_RING_INLINE bool push(uint32_t time, uint32_t level) {
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == Size) {
+      _dropped.store(_dropped.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+      return false;
+    }
+    edge_t& edge = _edges[head & (Size - 1)];
+    edge.time = time;
+    edge.level = level;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumer side, false if the ring is empty
+   */
+  EDGE_RING_INLINE bool pop(edge_t& edge) {
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    edge = _edges[tail & (Size - 1)];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Consumer side, discard the pending edges
+   */
+  void clear() {
+    _tail.store(_head.load(std::memory_order_acquire),
+                std::memory_order_release);
+  }
+
+  /**
+   * Edges waiting to be popped
+   */
+  unsigned size() const {
+    return _head.load(std::memory_order_acquire) -
+           _tail.load(std::memory_order_acquire);
+  }
+
+  static unsigned capacity() { return Size; }
+
+  /**
+   * Edges lost to a full ring since construction
+   */
+  uint32_t dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  edge_t _edges[Size];
+  std::atomic<uint32_t> _head; // written by the producer
+  std::atomic<uint32_t> _tail; // written by the consumer
+  std::atomic<uint32_t> _dropped;
+};
+
+/**
+ * Builds a pulse train from edges, as the interrupt handler used to.
+ *
+ * Edges closer than minPulseLength to the previous accepted edge are ignored,
+ * their time is added to the next width. A high level ends a gap, a low level
+ * a pulse. A gap that does not follow a pulse (a short positive blip that was
+ * filtered) is added to the previous gap.
+ */
+class PulseAssembler {
+public:
+  explicit PulseAssembler(unsigned minPulseLength);
+
+  /**
+   * Start receiving into train, now is the time of the start of the signal
+   */
+  void start(pulse_data_t* train, uint32_t now);
+
+  /**
+   * Add one edge, rssi is stored with the pulse when SIGNAL_RSSI is defined
+   */
+  void addEdge(uint32_t time, bool level, int rssi);
+
+  /**
+   * Add all pending edges of ring, returns the number of edges popped.
+   * When accept is false the edges are consumed but not added.
+   */
+  template <unsigned Size>
+  unsigned drain(EdgeRing<Size>& ring, int rssi, bool accept = true) {
+    unsigned count = 0;
+    edge_t edge;
+    while (ring.pop(edge)) {
+      if (accept) {
+        addEdge(edge.time, edge.level, rssi);
+      }
+      count++;
+    }
+    return count;
+  }
+
+  /**
+   * Index of the pulse being received, the train holds pulses() + 1 entries
+   */
+  int pulses() const { return _nrpulses; }
+
+  pulse_data_t* train() const { return _train; }
+
+  /**
+   * Shortest pulse or gap kept, it depends on the modulation
+   */
+  void setMinPulseLength(unsigned minPulseLength) { _minPulseLength = minPulseLength; }
+
+private:
+  unsigned _minPulseLength;
+  pulse_data_t* _train;
+  uint32_t _lastChange; // time of the previous accepted edge
+  int _nrpulses;
+};
+
+#endif
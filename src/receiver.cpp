@@ -29,3 +29,27 @@ int totalRssi = 0;
 int rssiCount = 0;
 
 void _loop() {}
+
+byte GpioEdgeSource::_gpio;
+EdgeSink GpioEdgeSource::_sink;
+
+GpioEdgeSource::GpioEdgeSource(byte gpio, int (*readRssi)())
+    : _readRssi(readRssi) {
+  _gpio = gpio;
+}
+
+void GpioEdgeSource::begin(EdgeSink sink) {
+  _sink = sink;
+  pinMode(_gpio, INPUT);
+  attachInterrupt(_gpio, interruptHandler, CHANGE);
+}
+
+void GpioEdgeSource::end() { detachInterrupt(_gpio); }
+
+/**
+ * @brief Called on every change of the receiver data output
+ * 
+ */
+void IRAM_ATTR GpioEdgeSource::interruptHandler() {
+  _sink(micros(), digitalRead(_gpio));
+}
@@ -26,7 +26,31 @@
 #ifndef rtl_433_RECEIVER_H
 #define rtl_433_RECEIVER_H
 
+#include <Arduino.h>
+
+#include "edgeSource.h"
 #include "log.h"
 #include "tools/aprintf.h"
 
+/**
+ * Edges from the data output of the transceiver on a GPIO, signal strength
+ * read from the transceiver
+ */
+class GpioEdgeSource : public EdgeSource {
+public:
+  GpioEdgeSource(byte gpio, int (*readRssi)());
+
+  void begin(EdgeSink sink);
+  void end();
+  uint32_t now() { return micros(); }
+  int rssi() { return _readRssi(); }
+
+private:
+  static void interruptHandler();
+
+  static byte _gpio;
+  static EdgeSink _sink;
+  int (*_readRssi)();
+};
+
 #endif
\ No newline at end of file
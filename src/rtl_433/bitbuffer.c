@@ -19,6 +19,33 @@ void bitbuffer_clear(bitbuffer_t *bits)
     memset(bits, 0, sizeof(*bits));
 }
 
+/// Bytes in use from the start of a row, with the rows a long row spills into.
+static unsigned bitbuffer_row_bytes(bitbuffer_t const *bits, unsigned row)
+{
+    unsigned bytes = (bits->bits_per_row[row] + 7) / 8;
+    unsigned room  = (BITBUF_ROWS - row) * BITBUF_COLS;
+    return bytes < room ? bytes : room;
+}
+
+void bitbuffer_copy_used(bitbuffer_t *dst, bitbuffer_t const *src)
+{
+    unsigned rows = dst->num_rows > src->num_rows ? dst->num_rows : src->num_rows;
+    if (rows > BITBUF_ROWS)
+        rows = BITBUF_ROWS;
+
+    // clear all rows of dst before the copy, a spilled row may cover the rows after it
+    for (unsigned row = 0; row < dst->num_rows && row < BITBUF_ROWS; ++row) {
+        memset(dst->bb[row], 0, bitbuffer_row_bytes(dst, row));
+    }
+    for (unsigned row = 0; row < src->num_rows && row < BITBUF_ROWS; ++row) {
+        memcpy(dst->bb[row], src->bb[row], bitbuffer_row_bytes(src, row));
+    }
+    memcpy(dst->bits_per_row, src->bits_per_row, rows * sizeof(*dst->bits_per_row));
+    memcpy(dst->syncs_before_row, src->syncs_before_row, rows * sizeof(*dst->syncs_before_row));
+    dst->num_rows = src->num_rows;
+    dst->free_row = src->free_row;
+}
+
 void bitbuffer_add_bit(bitbuffer_t *bits, int bit)
 {
     if (bits->num_rows == 0)
@@ -101,6 +128,92 @@ static void bitbuffer_set_width(bitbuffer_t *bits, uint16_t width)
     bits->free_row = bits->num_rows + extra_rows;
 }
 
+/// Bits that can be added to the last row before bitbuffer_add_bit() would check the
+/// row again, taking the next row to spill into if needed, 0 if no more bits fit.
+static unsigned add_bits_room(bitbuffer_t *bits)
+{
+    if (bits->num_rows == 0)
+        bits->free_row = bits->num_rows = 1; // Add first row automatically
+
+    unsigned len = bits->bits_per_row[bits->num_rows - 1];
+    if (len == UINT16_MAX) {
+        return 0;
+    }
+    if (len == UINT16_MAX - 1) {
+        fprintf(stderr, "%s: Warning: row length limit (%u bits) reached\n", __func__, UINT16_MAX);
+        return 1;
+    }
+    if (len > 0 && len % (BITBUF_COLS * 8) == 0) {
+        // spill into next row
+        if (bits->free_row == BITBUF_ROWS - 1) {
+            fprintf(stderr, "%s: Warning: row count limit (%d rows) reached\n", __func__, BITBUF_ROWS);
+        }
+        if (bits->free_row < BITBUF_ROWS) {
+            bits->free_row++;
+        }
+        else {
+            return 0;
+        }
+    }
+    unsigned room = BITBUF_COLS * 8 - len % (BITBUF_COLS * 8);
+    return room < UINT16_MAX - 1 - len ? room : UINT16_MAX - 1 - len;
+}
+
+void bitbuffer_add_bits_run(bitbuffer_t *bits, int bit, unsigned count)
+{
+    while (count > 0) {
+        unsigned room = add_bits_room(bits);
+        if (!room) {
+            return;
+        }
+        unsigned n    = count < room ? count : room;
+        uint16_t *len = &bits->bits_per_row[bits->num_rows - 1];
+        // zeros are already there, the buffer is cleared and only ever or-ed
+        if (bit) {
+            uint8_t *b     = bits->bb[bits->num_rows - 1];
+            unsigned first = *len / 8;
+            unsigned last  = (*len + n - 1) / 8;
+            uint8_t head   = 0xff >> (*len % 8);
+            uint8_t tail   = 0xff << (7 - (*len + n - 1) % 8);
+            if (first == last) {
+                b[first] |= head & tail;
+            }
+            else {
+                b[first] |= head;
+                memset(&b[first + 1], 0xff, last - first - 1);
+                b[last] |= tail;
+            }
+        }
+        *len += n;
+        count -= n;
+    }
+}
+
+void bitbuffer_add_bits_word(bitbuffer_t *bits, uint32_t word, unsigned count)
+{
+    while (count > 0) {
+        unsigned room = add_bits_room(bits);
+        if (!room) {
+            return;
+        }
+        unsigned n    = count < room ? count : room;
+        uint16_t *len = &bits->bits_per_row[bits->num_rows - 1];
+        uint8_t *b    = bits->bb[bits->num_rows - 1];
+        unsigned pos  = *len;
+        // the next n bits of the word, up to a byte at a time
+        for (unsigned left = n; left > 0;) {
+            unsigned free = 8 - pos % 8;
+            unsigned k    = left < free ? left : free;
+            uint8_t value = (word >> (count - n + left - k)) & ((1u << k) - 1);
+            b[pos / 8] |= value << (free - k);
+            pos += k;
+            left -= k;
+        }
+        *len += n;
+        count -= n;
+    }
+}
+
 void bitbuffer_add_row(bitbuffer_t *bits)
 {
     if (bits->num_rows == 0)
@@ -219,32 +332,100 @@ static inline uint8_t bit_at(const uint8_t *bytes, unsigned bit)
     return (uint8_t)(bytes[bit >> 3] >> (7 - (bit & 7)) & 1);
 }
 
+/// First match of the leading prefix_len (1 to 32) bits of pattern at or after start,
+/// ending at or before len, or len. The row is shifted into a 64 bit window a byte
+/// at a time and the prefix is compared at each of the 8 new bit positions.
+static unsigned search_prefix(uint8_t const *bits, unsigned len, unsigned start,
+        uint8_t const *pattern, unsigned prefix_len)
+{
+    uint32_t value = 0;
+    for (unsigned i = 0; i < (prefix_len + 7) / 8; ++i)
+        value = value << 8 | pattern[i];
+    value >>= (8 - prefix_len % 8) % 8;
+    uint64_t const mask = ((uint64_t)1 << prefix_len) - 1;
+
+    unsigned first_end = start + prefix_len; // end of the first candidate
+    uint64_t window    = 0;
+    for (unsigned byte = start / 8; byte * 8 < len; ++byte) {
+        window = window << 8 | bits[byte];
+        unsigned window_end = byte * 8 + 8; // bit position after the window
+        unsigned end        = window_end - 7;
+        if (end < first_end)
+            end = first_end;
+        unsigned last = window_end < len ? window_end : len;
+        for (; end <= last; ++end) {
+            if (((window >> (window_end - end)) & mask) == value)
+                return end - prefix_len;
+        }
+    }
+    return len;
+}
+
 unsigned bitbuffer_search(bitbuffer_t *bitbuffer, unsigned row, unsigned start,
         const uint8_t *pattern, unsigned pattern_bits_len)
 {
     uint8_t *bits = bitbuffer->bb[row];
     unsigned len  = bitbuffer->bits_per_row[row];
-    unsigned ipos = start;
-    unsigned ppos = 0; // cursor on init pattern
 
-    while (ipos < len && ppos < pattern_bits_len) {
-        if (bit_at(bits, ipos) == bit_at(pattern, ppos)) {
+    if (pattern_bits_len == 0 || start >= len || pattern_bits_len > len - start)
+        return len; // Not found
+
+    // match the first 32 bits a word at a time, the rest of a longer pattern a bit at a time
+    unsigned prefix_len = pattern_bits_len < 32 ? pattern_bits_len : 32;
+    for (unsigned ipos = search_prefix(bits, len, start, pattern, prefix_len);
+            ipos + pattern_bits_len <= len;
+            ipos = search_prefix(bits, len, ipos + 1, pattern, prefix_len)) {
+        unsigned ppos = prefix_len;
+        while (ppos < pattern_bits_len && bit_at(bits, ipos + ppos) == bit_at(pattern, ppos))
             ppos++;
-            ipos++;
-            if (ppos == pattern_bits_len)
-                return ipos - pattern_bits_len;
-        }
-        else {
-            ipos -= ppos;
-            ipos++;
-            ppos = 0;
-        }
+        if (ppos == pattern_bits_len)
+            return ipos;
     }
 
     // Not found
     return len;
 }
 
+/// The 8 bits of bytes from bit on, all in the row.
+static inline uint8_t byte_at(uint8_t const *bytes, unsigned bit)
+{
+    unsigned shift = bit & 7;
+    if (!shift)
+        return bytes[bit >> 3];
+    return (uint8_t)(bytes[bit >> 3] << shift | bytes[(bit >> 3) + 1] >> (8 - shift));
+}
+
+// bits 6, 4, 2, 0 set for each of the 4 symbols of x with two equal bits
+#define SAME_BITS(x) (~((x) ^ (x) >> 1) & 0x55)
+
+/// Manchester decoding of 4 symbols: the second bit of each symbol in the low nibble,
+/// a symbol violation ( two equal bits ) in the high nibble, first symbol in the top bit.
+#define MANCHESTER_ENTRY(x) \
+    (uint8_t)(((x) >> 3 & 8) | ((x) >> 2 & 4) | ((x) >> 1 & 2) | ((x) & 1) \
+            | (SAME_BITS(x) & 0x40) << 1 | (SAME_BITS(x) & 0x10) << 2 | (SAME_BITS(x) & 0x04) << 3 | (SAME_BITS(x) & 0x01) << 4)
+
+/// Differential Manchester decoding of 4 symbols after the bit x >> 8: a 1 for a symbol of two
+/// equal bits in the low nibble, a missing clock ( first bit equal to the bit before ) in the high nibble.
+#define DIFFERENTIAL_ENTRY(x) \
+    (uint8_t)((SAME_BITS(x) >> 3 & 8) | (SAME_BITS(x) >> 2 & 4) | (SAME_BITS(x) >> 1 & 2) | (SAME_BITS(x) & 1) \
+            | (SAME_BITS((x) >> 1) & 0x40) << 1 | (SAME_BITS((x) >> 1) & 0x10) << 2 | (SAME_BITS((x) >> 1) & 0x04) << 3 | (SAME_BITS((x) >> 1) & 0x01) << 4)
+
+#define TABLE_4(f, x)   f(x), f((x) + 1), f((x) + 2), f((x) + 3)
+#define TABLE_16(f, x)  TABLE_4(f, x), TABLE_4(f, (x) + 4), TABLE_4(f, (x) + 8), TABLE_4(f, (x) + 12)
+#define TABLE_64(f, x)  TABLE_16(f, x), TABLE_16(f, (x) + 16), TABLE_16(f, (x) + 32), TABLE_16(f, (x) + 48)
+#define TABLE_256(f, x) TABLE_64(f, x), TABLE_64(f, (x) + 64), TABLE_64(f, (x) + 128), TABLE_64(f, (x) + 192)
+
+static uint8_t const manchester_table[256] = {TABLE_256(MANCHESTER_ENTRY, 0)};
+
+/// Indexed by the bit before the byte and the byte.
+static uint8_t const differential_table[512] = {TABLE_256(DIFFERENTIAL_ENTRY, 0), TABLE_256(DIFFERENTIAL_ENTRY, 256)};
+
+/// Symbols before the first violation of a table entry with violations.
+static inline unsigned symbols_before(uint8_t entry)
+{
+    return entry & 0x80 ? 0 : entry & 0x40 ? 1 : entry & 0x20 ? 2 : 3;
+}
+
 unsigned bitbuffer_manchester_decode(bitbuffer_t *inbuf, unsigned row, unsigned start,
         bitbuffer_t *outbuf, unsigned max)
 {
@@ -255,6 +436,26 @@ unsigned bitbuffer_manchester_decode(bitbuffer_t *inbuf, unsigned row, unsigned
     if (max && len > start + (max * 2))
         len = start + (max * 2);
 
+    // 4 symbols a byte, the decoded bits are added 32 at a time
+    uint32_t word  = 0;
+    unsigned count = 0;
+    while (ipos + 8 <= len) {
+        uint8_t entry = manchester_table[byte_at(bits, ipos)];
+        if (entry & 0xf0) {
+            unsigned n = symbols_before(entry);
+            bitbuffer_add_bits_word(outbuf, word << n | (entry & 0xf) >> (4 - n), count + n);
+            return ipos + 2 * n + 2;
+        }
+        word = word << 4 | entry;
+        ipos += 8;
+        if ((count += 4) == 32) {
+            bitbuffer_add_bits_word(outbuf, word, 32);
+            count = 0;
+        }
+    }
+    bitbuffer_add_bits_word(outbuf, word, count);
+
+    // the last symbols, an odd last bit is decoded with the bit after it as before
     while (ipos < len) {
         uint8_t bit1, bit2;
 
@@ -305,6 +506,27 @@ unsigned bitbuffer_differential_manchester_decode(bitbuffer_t *inbuf, unsigned r
         }
     }
 
+    // 4 symbols a byte, the decoded bits are added 32 at a time
+    uint32_t word  = 0;
+    unsigned count = 0;
+    while (ipos + 8 <= len) {
+        uint8_t byte  = byte_at(bits, ipos);
+        uint8_t entry = differential_table[bit2 << 8 | byte];
+        if (entry & 0xf0) {
+            unsigned n = symbols_before(entry);
+            bitbuffer_add_bits_word(outbuf, word << n | (entry & 0xf) >> (4 - n), count + n);
+            return ipos + 2 * n + 1; // clock missing, abort
+        }
+        word = word << 4 | entry;
+        ipos += 8;
+        bit2 = byte & 1;
+        if ((count += 4) == 32) {
+            bitbuffer_add_bits_word(outbuf, word, 32);
+            count = 0;
+        }
+    }
+    bitbuffer_add_bits_word(outbuf, word, count);
+
     while (ipos < len) {
         bit1 = bit_at(bits, ipos++);
         if (bit1 == bit2)
@@ -498,28 +720,84 @@ unsigned bitbuffer_count_repeats(bitbuffer_t *bits, unsigned row, unsigned max_b
     return cnt;
 }
 
-int bitbuffer_find_repeated_row(bitbuffer_t *bits, unsigned min_repeats, unsigned min_bits)
+#define REPEAT_BUCKETS 128 // power of two, over twice BITBUF_ROWS
+#if REPEAT_BUCKETS < 2 * BITBUF_ROWS
+#error "REPEAT_BUCKETS needs to be larger than twice BITBUF_ROWS"
+#endif
+
+/// FNV-1a hash of what bitbuffer_compare_rows() compares, the first max_bits of the row or all of it.
+static uint32_t row_hash(bitbuffer_t *bits, unsigned row, unsigned max_bits)
 {
-    for (int i = 0; i < bits->num_rows; ++i) {
-        if (bits->bits_per_row[i] >= min_bits &&
-                bitbuffer_count_repeats(bits, i, 0) >= min_repeats) {
-            return i;
-        }
+    uint8_t const *b = bits->bb[row];
+    unsigned len     = bits->bits_per_row[row];
+    uint32_t hash    = 2166136261u ^ len;
+    unsigned bytes   = (len + 7) / 8;
+    if (max_bits) {
+        hash  = 2166136261u;
+        bytes = max_bits / 8;
     }
-    return -1;
+    for (unsigned i = 0; i < bytes; ++i) {
+        hash = (hash ^ b[i]) * 16777619u;
+    }
+    if (max_bits & 7) {
+        hash = (hash ^ (b[bytes] & (0xff00 >> (max_bits & 7)))) * 16777619u;
+    }
+    return hash;
 }
 
-int bitbuffer_find_repeated_prefix(bitbuffer_t *bits, unsigned min_repeats, unsigned min_bits)
+/// First row of at least min_bits bits with min_repeats rows comparing equal by bitbuffer_compare_rows(),
+/// rows are grouped by hash in one pass, with an exact compare against the first row of the group.
+static int find_repeated(bitbuffer_t *bits, unsigned min_repeats, unsigned min_bits, unsigned max_bits)
 {
-    for (int i = 0; i < bits->num_rows; ++i) {
-        if (bits->bits_per_row[i] >= min_bits &&
-                bitbuffer_count_repeats(bits, i, min_bits) >= min_repeats) {
+    int8_t bucket[REPEAT_BUCKETS];   // first row of each group, by hash
+    uint32_t hash[BITBUF_ROWS];      // of the first row of each group
+    int8_t group[BITBUF_ROWS];       // first row of the group of each row
+    uint8_t count[BITBUF_ROWS] = {0}; // rows in the group, at the first row of the group
+    unsigned rows = bits->num_rows;
+    int first     = -1; // first row looked for
+
+    memset(bucket, -1, sizeof(bucket));
+    for (unsigned i = 0; i < rows; ++i) {
+        group[i] = -1;
+        // shorter rows only compare equal to rows of the same length, which are not looked for either
+        if (bits->bits_per_row[i] < min_bits)
+            continue;
+        hash[i]     = row_hash(bits, i, max_bits);
+        unsigned at = hash[i] & (REPEAT_BUCKETS - 1);
+        // linear probing, groups with other rows of the same hash bucket are skipped
+        while (bucket[at] >= 0
+                && (hash[bucket[at]] != hash[i] || !bitbuffer_compare_rows(bits, bucket[at], i, max_bits))) {
+            at = (at + 1) & (REPEAT_BUCKETS - 1);
+        }
+        if (bucket[at] < 0)
+            bucket[at] = i;
+        group[i] = bucket[at];
+        count[group[i]]++;
+        if (first < 0)
+            first = i;
+        // no earlier row to find, e.g. the usual repeats of one message
+        if (group[i] == first && count[first] >= min_repeats)
+            return first;
+    }
+
+    for (unsigned i = 0; i < rows; ++i) {
+        if (group[i] >= 0 && count[group[i]] >= min_repeats) {
             return i;
         }
     }
     return -1;
 }
 
+int bitbuffer_find_repeated_row(bitbuffer_t *bits, unsigned min_repeats, unsigned min_bits)
+{
+    return find_repeated(bits, min_repeats, min_bits, 0);
+}
+
+int bitbuffer_find_repeated_prefix(bitbuffer_t *bits, unsigned min_repeats, unsigned min_bits)
+{
+    return find_repeated(bits, min_repeats, min_bits, min_bits);
+}
+
 // Unit testing
 #ifdef _TEST
 
@@ -533,6 +811,81 @@ int bitbuffer_find_repeated_prefix(bitbuffer_t *bits, unsigned min_repeats, unsi
         } \
     } while (0)
 
+// bitbuffer_manchester_decode() before the table
+static unsigned reference_manchester_decode(bitbuffer_t *inbuf, unsigned row, unsigned start,
+        bitbuffer_t *outbuf, unsigned max)
+{
+    uint8_t *bits     = inbuf->bb[row];
+    unsigned int len  = inbuf->bits_per_row[row];
+    unsigned int ipos = start;
+
+    if (max && len > start + (max * 2))
+        len = start + (max * 2);
+
+    while (ipos < len) {
+        uint8_t bit1, bit2;
+
+        bit1 = bit_at(bits, ipos++);
+        bit2 = bit_at(bits, ipos++);
+
+        if (bit1 == bit2)
+            break;
+
+        bitbuffer_add_bit(outbuf, bit2);
+    }
+
+    return ipos;
+}
+
+// bitbuffer_differential_manchester_decode() before the table
+static unsigned reference_differential_manchester_decode(bitbuffer_t *inbuf, unsigned row, unsigned start,
+        bitbuffer_t *outbuf, unsigned max)
+{
+    uint8_t *bits     = inbuf->bb[row];
+    unsigned int len  = inbuf->bits_per_row[row];
+    unsigned int ipos = start;
+    uint8_t bit1, bit2 = 0;
+
+    if (max && len > start + (max * 2))
+        len = start + (max * 2);
+
+    while (ipos < len) {
+        bit1 = bit_at(bits, ipos++);
+        bit2 = bit_at(bits, ipos++);
+        uint8_t bit3 = bit_at(bits, ipos);
+
+        if (bit1 != bit2) {
+            if (bit2 != bit3) {
+                bitbuffer_add_bit(outbuf, 0);
+            }
+            else {
+                bit2 = bit1;
+                ipos -= 1;
+                break;
+            }
+        }
+        else {
+            bit2 = 1 - bit1;
+            ipos -= 2;
+            break;
+        }
+    }
+
+    while (ipos < len) {
+        bit1 = bit_at(bits, ipos++);
+        if (bit1 == bit2)
+            break; // clock missing, abort
+        bit2 = bit_at(bits, ipos++);
+
+        if (bit1 == bit2)
+            bitbuffer_add_bit(outbuf, 1);
+        else
+            bitbuffer_add_bit(outbuf, 0);
+    }
+
+    return ipos;
+}
+
 int main(void)
 {
     unsigned passed = 0;
@@ -585,6 +938,135 @@ int main(void)
     ASSERT(bits.bb[0][0] == 0xB1);
     ASSERT(bits.bb[0][1] == 0xA0);
 
+    fprintf(stderr, "TEST: bitbuffer:: search\n");
+    bitbuffer_clear(&bits);
+    for (int i = 0; i < 20; ++i) {
+        bitbuffer_add_bit(&bits, 0);
+    }
+    uint8_t const preamble[] = {0xAA, 0x2D, 0xD4, 0x5C, 0x3B};
+    for (int i = 0; i < 40; ++i) {
+        bitbuffer_add_bit(&bits, (preamble[i / 8] >> (7 - i % 8)) & 1);
+    }
+    ASSERT(bitbuffer_search(&bits, 0, 0, preamble, 24) == 20);
+    ASSERT(bitbuffer_search(&bits, 0, 20, preamble, 24) == 20);
+    ASSERT(bitbuffer_search(&bits, 0, 21, preamble, 24) == 60);
+    ASSERT(bitbuffer_search(&bits, 0, 0, preamble, 40) == 20);
+    ASSERT(bitbuffer_search(&bits, 0, 0, &preamble[3], 16) == 44);
+    ASSERT(bitbuffer_search(&bits, 0, 0, preamble, 1) == 20);
+    ASSERT(bitbuffer_search(&bits, 0, 0, preamble, 0) == 60);
+    bits.bits_per_row[0] = 59; // the pattern at the row end, less a bit
+    ASSERT(bitbuffer_search(&bits, 0, 0, preamble, 40) == 59);
+    ASSERT(bitbuffer_search(&bits, 0, 0, preamble, 39) == 20);
+    uint8_t const absent[] = {0x54, 0x3D};
+    ASSERT(bitbuffer_search(&bits, 0, 0, absent, 16) == 59);
+
+    fprintf(stderr, "TEST: bitbuffer:: add runs and words\n");
+    static bitbuffer_t bulk;
+    srand(433);
+    for (int round = 0; round < 20; ++round) {
+        bitbuffer_clear(&bits);
+        bitbuffer_clear(&bulk);
+        // up to twice the bits that fit, rows spilling and running out
+        for (int added = 0; added < BITBUF_MAX_ROW_BITS * 2;) {
+            int op = rand() % 16;
+            if (op == 0) {
+                bitbuffer_add_row(&bits);
+                bitbuffer_add_row(&bulk);
+            }
+            else if (op < 8) {
+                int bit        = rand() & 1;
+                unsigned count = rand() % (round % 2 ? 20 : BITBUF_COLS * 8 * 2);
+                for (unsigned i = 0; i < count; ++i)
+                    bitbuffer_add_bit(&bits, bit);
+                bitbuffer_add_bits_run(&bulk, bit, count);
+                added += count;
+            }
+            else {
+                uint32_t word  = (uint32_t)rand() << 16 ^ rand();
+                unsigned count = rand() % 33;
+                for (unsigned i = count; i > 0; --i)
+                    bitbuffer_add_bit(&bits, (word >> (i - 1)) & 1);
+                bitbuffer_add_bits_word(&bulk, word, count);
+                added += count;
+            }
+        }
+        ASSERT(memcmp(&bits, &bulk, sizeof(bits)) == 0);
+    }
+
+    fprintf(stderr, "TEST: bitbuffer:: find repeated rows and prefixes\n");
+    for (int round = 0; round < 200; ++round) {
+        // rows of few distinct lengths and contents, some sharing a prefix
+        bitbuffer_clear(&bits);
+        unsigned rows = 1 + rand() % BITBUF_ROWS;
+        for (unsigned r = 0; r < rows; ++r) {
+            unsigned len = 30 + rand() % 3 * 4 + (round % 2 ? rand() % 3 : 0);
+            unsigned variant = rand() % 3;
+            for (unsigned i = 0; i < len; ++i)
+                bitbuffer_add_bit(&bits, (i * 7 + (i > 24 ? variant : 0)) % 5 < 2);
+            if (r + 1 < rows)
+                bitbuffer_add_row(&bits);
+        }
+        for (unsigned min_repeats = 0; min_repeats < 8; ++min_repeats) {
+            for (unsigned min_bits = 0; min_bits < 40; min_bits += 3) {
+                int row = -1, prefix = -1;
+                for (int i = bits.num_rows - 1; i >= 0; --i) {
+                    if (bits.bits_per_row[i] >= min_bits && bitbuffer_count_repeats(&bits, i, 0) >= min_repeats)
+                        row = i;
+                    if (bits.bits_per_row[i] >= min_bits && bitbuffer_count_repeats(&bits, i, min_bits) >= min_repeats)
+                        prefix = i;
+                }
+                ASSERT(bitbuffer_find_repeated_row(&bits, min_repeats, min_bits) == row);
+                ASSERT(bitbuffer_find_repeated_prefix(&bits, min_repeats, min_bits) == prefix);
+            }
+        }
+    }
+
+    fprintf(stderr, "TEST: bitbuffer:: Manchester and differential Manchester decode\n");
+    static bitbuffer_t in, out, reference;
+    for (int round = 0; round < 2000; ++round) {
+        // valid symbols with a violation now and then, both codes, in rows spilling into the next
+        bitbuffer_clear(&in);
+        int differential = round % 2;
+        unsigned symbols = rand() % (round % 10 ? 80 : BITBUF_COLS * 6);
+        unsigned odds    = 2 + rand() % 200;
+        int level        = 0;
+        for (unsigned i = 0; i < symbols; ++i) {
+            int bit = rand() & 1;
+            if (differential) {
+                level = rand() % odds ? !level : level; // clock
+                bitbuffer_add_bit(&in, level);
+                level = bit ? level : !level;
+                bitbuffer_add_bit(&in, level);
+            }
+            else {
+                bitbuffer_add_bit(&in, rand() % odds ? !bit : bit);
+                bitbuffer_add_bit(&in, bit);
+            }
+        }
+        if (rand() % 4 == 0)
+            bitbuffer_add_bit(&in, rand() & 1); // an odd last bit
+        // into a fresh bitbuffer or after other rows
+        bitbuffer_clear(&out);
+        for (int rows = rand() % 4; rows > 0; --rows) {
+            bitbuffer_add_bits_run(&out, 1, rand() % 300);
+            bitbuffer_add_row(&out);
+        }
+        reference = out;
+        unsigned start = in.bits_per_row[0] ? rand() % (in.bits_per_row[0] / 4 + 1) : 0;
+        unsigned max   = rand() % 3 ? 0 : rand() % (symbols + 1);
+        unsigned pos, reference_pos;
+        if (differential) {
+            pos           = bitbuffer_differential_manchester_decode(&in, 0, start, &out, max);
+            reference_pos = reference_differential_manchester_decode(&in, 0, start, &reference, max);
+        }
+        else {
+            pos           = bitbuffer_manchester_decode(&in, 0, start, &out, max);
+            reference_pos = reference_manchester_decode(&in, 0, start, &reference, max);
+        }
+        ASSERT(pos == reference_pos);
+        ASSERT(memcmp(&out, &reference, sizeof(out)) == 0);
+    }
+
     fprintf(stderr, "TEST: bitbuffer:: Clear\n");
     bitbuffer_clear(&bits);
     ASSERT(bits.num_rows == 0);
@@ -0,0 +1,456 @@
+/** @file
+    Table-driven CRC and LFSR digest kernels.
+
+    A CRC table holds the remainder of each byte value shifted through the
+    register, so each message byte is a lookup instead of eight shifts.
+
+    The LFSR digests are linear in the key: the digest of a message is the
+    sum over its bytes of the key rolled to the byte, times the byte. With a
+    table of each byte value times the initial key, the bytes are summed
+    from the last rolling the sum a byte each step (Horner), and rolling a
+    value by a byte is a CRC table lookup with the generator as polynomial.
+
+    The tables for the polynomials and LFSR keys the device decoders use are
+    built by the preprocessor into flash. Others are built on first use into
+    CRC_TABLE_CACHE slots in RAM, once those are taken the entries are
+    computed a byte at a time.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "crc_table.h"
+#include "util.h"
+#include <stdlib.h>
+
+enum table_kind {
+    CRC_MSB8,     ///< crc8(), crc4() and crc7() with a shifted polynomial, reflected LFSR digest roll
+    CRC_LSB8,     ///< crc8le() with a reflected polynomial, LFSR digest-8 roll
+    CRC_MSB16,    ///< crc16()
+    CRC_LSB16,    ///< crc16lsb(), LFSR digest-16 roll
+    LFSR_RIGHT8,  ///< lfsr_digest8() byte times key
+    LFSR_RIGHT16, ///< lfsr_digest16() byte times key
+    LFSR_LEFT8,   ///< lfsr_digest8_reflect() byte times key
+};
+
+typedef struct {
+    uint8_t kind;
+    uint16_t poly; ///< polynomial or LFSR generator
+    uint16_t key;  ///< LFSR key, 0 for a CRC
+    void const *table;
+} crc_table_t;
+
+/*----------------------------- Tables in flash -----------------------------*/
+
+#define MSB_STEP(w, p, v) ((((v) << 1) ^ (((v) >> ((w) - 1)) & 1 ? (p) : 0)) & ((1L << (w)) - 1))
+#define LSB_STEP(p, v)    (((v) >> 1) ^ ((v) & 1 ? (p) : 0))
+
+// constants a##_0 to a##_7, each one step on from the one before
+#define BASIS_MSB(a, w, p, v) \
+    enum { a##_0 = (v), a##_1 = MSB_STEP(w, p, a##_0), a##_2 = MSB_STEP(w, p, a##_1), \
+        a##_3 = MSB_STEP(w, p, a##_2), a##_4 = MSB_STEP(w, p, a##_3), a##_5 = MSB_STEP(w, p, a##_4), \
+        a##_6 = MSB_STEP(w, p, a##_5), a##_7 = MSB_STEP(w, p, a##_6) };
+#define BASIS_LSB(a, p, v) \
+    enum { a##_0 = (v), a##_1 = LSB_STEP(p, a##_0), a##_2 = LSB_STEP(p, a##_1), \
+        a##_3 = LSB_STEP(p, a##_2), a##_4 = LSB_STEP(p, a##_3), a##_5 = LSB_STEP(p, a##_4), \
+        a##_6 = LSB_STEP(p, a##_5), a##_7 = LSB_STEP(p, a##_6) };
+
+// table entry of byte x, the sum of a##_i over the bits i set ( bits 7 - i if reflected )
+#define ENTRY(a, x) \
+    (((x) & 0x01 ? a##_0 : 0) ^ ((x) & 0x02 ? a##_1 : 0) ^ ((x) & 0x04 ? a##_2 : 0) ^ \
+     ((x) & 0x08 ? a##_3 : 0) ^ ((x) & 0x10 ? a##_4 : 0) ^ ((x) & 0x20 ? a##_5 : 0) ^ \
+     ((x) & 0x40 ? a##_6 : 0) ^ ((x) & 0x80 ? a##_7 : 0))
+#define ENTRY_REFLECTED(a, x) \
+    (((x) & 0x80 ? a##_0 : 0) ^ ((x) & 0x40 ? a##_1 : 0) ^ ((x) & 0x20 ? a##_2 : 0) ^ \
+     ((x) & 0x10 ? a##_3 : 0) ^ ((x) & 0x08 ? a##_4 : 0) ^ ((x) & 0x04 ? a##_5 : 0) ^ \
+     ((x) & 0x02 ? a##_6 : 0) ^ ((x) & 0x01 ? a##_7 : 0))
+
+#define ENTRIES_4(f, a, x)  f(a, (x)), f(a, (x) + 1), f(a, (x) + 2), f(a, (x) + 3)
+#define ENTRIES_16(f, a, x) ENTRIES_4(f, a, (x)), ENTRIES_4(f, a, (x) + 4), ENTRIES_4(f, a, (x) + 8), ENTRIES_4(f, a, (x) + 12)
+#define ENTRIES_64(f, a, x) ENTRIES_16(f, a, (x)), ENTRIES_16(f, a, (x) + 16), ENTRIES_16(f, a, (x) + 32), ENTRIES_16(f, a, (x) + 48)
+#define ENTRIES_256(f, a)   {ENTRIES_64(f, a, 0), ENTRIES_64(f, a, 64), ENTRIES_64(f, a, 128), ENTRIES_64(f, a, 192)}
+
+// MSB first CRC: the entry of bit i is the polynomial shifted i times
+#define CRC_MSB_TABLE(a, w, poly) \
+    BASIS_MSB(a, w, poly, poly) \
+    static uint##w##_t const a[256] = ENTRIES_256(ENTRY, a);
+// LSB first CRC: the entry of bit 7 - i is the polynomial shifted i times
+#define CRC_LSB_TABLE(a, w, poly) \
+    BASIS_LSB(a, poly, poly) \
+    static uint##w##_t const a[256] = ENTRIES_256(ENTRY_REFLECTED, a);
+// LFSR rolled right: the entry of bit 7 - i is the key rolled i times
+#define LFSR_RIGHT_TABLE(a, w, gen, key) \
+    BASIS_LSB(a, gen, key) \
+    static uint##w##_t const a[256] = ENTRIES_256(ENTRY_REFLECTED, a);
+// LFSR rolled left, reflected: the entry of bit i is the key rolled i times
+#define LFSR_LEFT_TABLE(a, gen, key) \
+    BASIS_MSB(a, 8, gen, key) \
+    static uint8_t const a[256] = ENTRIES_256(ENTRY, a);
+
+// polynomials of the device decoders
+CRC_MSB_TABLE(crc8_07, 8, 0x07)
+CRC_MSB_TABLE(crc8_31, 8, 0x31) // also rolls the reflected LFSR with generator 0x31
+CRC_MSB_TABLE(crc8_30, 8, 0x30) // crc4() 0x3 and 0x13
+CRC_MSB_TABLE(crc8_90, 8, 0x90) // crc4() 0x9
+CRC_MSB_TABLE(crc8_51, 8, 0x51) // rolls the reflected LFSR with generator 0x51
+CRC_MSB_TABLE(crc8_13, 8, 0x13)
+CRC_MSB_TABLE(crc8_80, 8, 0x80)
+CRC_MSB_TABLE(crc8_01, 8, 0x01)
+CRC_LSB_TABLE(crc8le_e0, 8, 0xe0) // crc8le() 0x07
+CRC_LSB_TABLE(crc8le_8c, 8, 0x8c) // crc8le() 0x31
+CRC_LSB_TABLE(crc8le_98, 8, 0x98) // rolls the LFSR with generator 0x98
+CRC_LSB_TABLE(crc8le_af, 8, 0xaf) // crc8le() 0xf5
+CRC_MSB_TABLE(crc16_1021, 16, 0x1021)
+CRC_MSB_TABLE(crc16_8005, 16, 0x8005)
+CRC_MSB_TABLE(crc16_3d65, 16, 0x3d65)
+CRC_MSB_TABLE(crc16_6f63, 16, 0x6f63)
+CRC_MSB_TABLE(crc16_8050, 16, 0x8050)
+CRC_LSB_TABLE(crc16lsb_8408, 16, 0x8408)
+CRC_LSB_TABLE(crc16lsb_a001, 16, 0xa001)
+CRC_LSB_TABLE(crc16lsb_00b2, 16, 0x00b2)
+CRC_LSB_TABLE(crc16lsb_8810, 16, 0x8810) // rolls the LFSR with generator 0x8810
+
+// LFSR generators and keys of the device decoders
+LFSR_RIGHT_TABLE(lfsr8_98_f1, 8, 0x98, 0xf1)
+LFSR_RIGHT_TABLE(lfsr8_98_3e, 8, 0x98, 0x3e)
+LFSR_RIGHT_TABLE(lfsr16_8810_5412, 16, 0x8810, 0x5412)
+LFSR_RIGHT_TABLE(lfsr16_8810_ba95, 16, 0x8810, 0xba95)
+LFSR_RIGHT_TABLE(lfsr16_8810_dd38, 16, 0x8810, 0xdd38)
+LFSR_RIGHT_TABLE(lfsr16_8810_0d42, 16, 0x8810, 0x0d42)
+LFSR_RIGHT_TABLE(lfsr16_8810_22d0, 16, 0x8810, 0x22d0)
+LFSR_LEFT_TABLE(lfsr8r_31_f4, 0x31, 0xf4)
+LFSR_LEFT_TABLE(lfsr8r_31_31, 0x31, 0x31)
+LFSR_LEFT_TABLE(lfsr8r_51_04, 0x51, 0x04)
+
+static crc_table_t const flash_tables[] = {
+        {CRC_MSB8, 0x07, 0, crc8_07},
+        {CRC_MSB8, 0x31, 0, crc8_31},
+        {CRC_MSB8, 0x30, 0, crc8_30},
+        {CRC_MSB8, 0x90, 0, crc8_90},
+        {CRC_MSB8, 0x51, 0, crc8_51},
+        {CRC_MSB8, 0x13, 0, crc8_13},
+        {CRC_MSB8, 0x80, 0, crc8_80},
+        {CRC_MSB8, 0x01, 0, crc8_01},
+        {CRC_LSB8, 0xe0, 0, crc8le_e0},
+        {CRC_LSB8, 0x8c, 0, crc8le_8c},
+        {CRC_LSB8, 0x98, 0, crc8le_98},
+        {CRC_LSB8, 0xaf, 0, crc8le_af},
+        {CRC_MSB16, 0x1021, 0, crc16_1021},
+        {CRC_MSB16, 0x8005, 0, crc16_8005},
+        {CRC_MSB16, 0x3d65, 0, crc16_3d65},
+        {CRC_MSB16, 0x6f63, 0, crc16_6f63},
+        {CRC_MSB16, 0x8050, 0, crc16_8050},
+        {CRC_LSB16, 0x8408, 0, crc16lsb_8408},
+        {CRC_LSB16, 0xa001, 0, crc16lsb_a001},
+        {CRC_LSB16, 0x00b2, 0, crc16lsb_00b2},
+        {CRC_LSB16, 0x8810, 0, crc16lsb_8810},
+        {LFSR_RIGHT8, 0x98, 0xf1, lfsr8_98_f1},
+        {LFSR_RIGHT8, 0x98, 0x3e, lfsr8_98_3e},
+        {LFSR_RIGHT16, 0x8810, 0x5412, lfsr16_8810_5412},
+        {LFSR_RIGHT16, 0x8810, 0xba95, lfsr16_8810_ba95},
+        {LFSR_RIGHT16, 0x8810, 0xdd38, lfsr16_8810_dd38},
+        {LFSR_RIGHT16, 0x8810, 0x0d42, lfsr16_8810_0d42},
+        {LFSR_RIGHT16, 0x8810, 0x22d0, lfsr16_8810_22d0},
+        {LFSR_LEFT8, 0x31, 0xf4, lfsr8r_31_f4},
+        {LFSR_LEFT8, 0x31, 0x31, lfsr8r_31_31},
+        {LFSR_LEFT8, 0x51, 0x04, lfsr8r_51_04},
+};
+
+/*----------------------------- Tables in RAM -----------------------------*/
+
+/// Table entry of byte x, computed a bit at a time.
+static unsigned table_entry(int kind, unsigned poly, unsigned key, unsigned x)
+{
+    unsigned value = 0;
+    switch (kind) {
+    case CRC_MSB8:
+        value = x;
+        for (int bit = 0; bit < 8; ++bit)
+            value = MSB_STEP(8, poly, value);
+        break;
+    case CRC_MSB16:
+        value = x << 8;
+        for (int bit = 0; bit < 8; ++bit)
+            value = MSB_STEP(16, poly, value);
+        break;
+    case CRC_LSB8:
+    case CRC_LSB16:
+        value = x;
+        for (int bit = 0; bit < 8; ++bit)
+            value = LSB_STEP(poly, value);
+        break;
+    case LFSR_RIGHT8:
+    case LFSR_RIGHT16:
+        for (int bit = 7; bit >= 0; --bit) {
+            if ((x >> bit) & 1)
+                value ^= key;
+            key = LSB_STEP(poly, key);
+        }
+        break;
+    case LFSR_LEFT8:
+        for (int bit = 0; bit < 8; ++bit) {
+            if ((x >> bit) & 1)
+                value ^= key;
+            key = MSB_STEP(8, poly, key);
+        }
+        break;
+    }
+    return value;
+}
+
+enum { SLOT_FREE, SLOT_FILLING, SLOT_READY };
+
+typedef struct {
+    int state;
+    crc_table_t table;
+} cache_slot_t;
+
+static cache_slot_t cache[CRC_TABLE_CACHE];
+
+static crc_table_t const *cache_table(int kind, unsigned poly, unsigned key)
+{
+    for (int i = 0; i < CRC_TABLE_CACHE; ++i) {
+        cache_slot_t *slot = &cache[i];
+        int state          = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+        if (state == SLOT_READY) {
+            if (slot->table.kind == kind && slot->table.poly == poly && slot->table.key == key)
+                return &slot->table;
+            continue;
+        }
+        // a decoder task on another core may claim the slot first, both can build the same table
+        int expected = SLOT_FREE;
+        if (state != SLOT_FREE
+                || !__atomic_compare_exchange_n(&slot->state, &expected, SLOT_FILLING, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            continue;
+
+        int wide = kind == CRC_MSB16 || kind == CRC_LSB16 || kind == LFSR_RIGHT16;
+        void *table = malloc(wide ? 256 * sizeof(uint16_t) : 256);
+        if (table) {
+            for (unsigned x = 0; x < 256; ++x) {
+                if (wide)
+                    ((uint16_t *)table)[x] = (uint16_t)table_entry(kind, poly, key, x);
+                else
+                    ((uint8_t *)table)[x] = (uint8_t)table_entry(kind, poly, key, x);
+            }
+        }
+        // without memory the slot stays taken, the entries are then computed a byte at a time
+        slot->table.kind  = kind;
+        slot->table.poly  = poly;
+        slot->table.key   = key;
+        slot->table.table = table;
+        __atomic_store_n(&slot->state, SLOT_READY, __ATOMIC_RELEASE);
+        return &slot->table;
+    }
+    return NULL;
+}
+
+/*----------------------------- Lookup -----------------------------*/
+
+#define RECENT_TABLES 32
+
+/// Last table found by hash of kind, polynomial and key, saves the search for repeated checks.
+static crc_table_t const *recent[RECENT_TABLES];
+
+/// Table of the kind for the polynomial and key, NULL to compute the entries.
+static void const *find_table(int kind, unsigned poly, unsigned key)
+{
+    unsigned hash = (kind * 7 + poly * 5 + key * 3 + (poly >> 8) + (key >> 8)) % RECENT_TABLES;
+    crc_table_t const *table = __atomic_load_n(&recent[hash], __ATOMIC_ACQUIRE);
+    if (table && table->kind == kind && table->poly == poly && table->key == key)
+        return table->table;
+
+    table = NULL;
+    for (unsigned i = 0; i < sizeof(flash_tables) / sizeof(*flash_tables); ++i) {
+        if (flash_tables[i].kind == kind && flash_tables[i].poly == poly && flash_tables[i].key == key) {
+            table = &flash_tables[i];
+            break;
+        }
+    }
+    if (!table)
+        table = cache_table(kind, poly, key);
+    if (!table)
+        return NULL;
+    __atomic_store_n(&recent[hash], table, __ATOMIC_RELEASE);
+    return table->table;
+}
+
+/*----------------------------- Kernels -----------------------------*/
+
+#define LOOKUP(table, kind, poly, key, x) ((table) ? (table)[x] : table_entry(kind, poly, key, x))
+
+static uint8_t crc8_msb(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
+{
+    uint8_t const *table = find_table(CRC_MSB8, polynomial, 0);
+    uint8_t remainder    = init;
+
+    for (unsigned byte = 0; byte < nBytes; ++byte) {
+        remainder = LOOKUP(table, CRC_MSB8, polynomial, 0, remainder ^ message[byte]);
+    }
+    return remainder;
+}
+
+uint8_t crc4_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
+{
+    // the 4 bit register in the upper bits of a byte, the lower bits are unused
+    return crc8_msb(message, nBytes, polynomial << 4, init << 4) >> 4;
+}
+
+uint8_t crc7_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
+{
+    return crc8_msb(message, nBytes, polynomial << 1, init << 1) >> 1;
+}
+
+uint8_t crc8_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
+{
+    return crc8_msb(message, nBytes, polynomial, init);
+}
+
+uint8_t crc8le_table(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
+{
+    polynomial           = reverse8(polynomial);
+    uint8_t const *table = find_table(CRC_LSB8, polynomial, 0);
+    uint8_t remainder    = reverse8(init);
+
+    for (unsigned byte = 0; byte < nBytes; ++byte) {
+        remainder = LOOKUP(table, CRC_LSB8, polynomial, 0, remainder ^ message[byte]);
+    }
+    return remainder;
+}
+
+uint16_t crc16lsb_table(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
+{
+    uint16_t const *table = find_table(CRC_LSB16, polynomial, 0);
+    uint16_t remainder    = init;
+
+    for (unsigned byte = 0; byte < nBytes; ++byte) {
+        remainder = (remainder >> 8) ^ LOOKUP(table, CRC_LSB16, polynomial, 0, (remainder ^ message[byte]) & 0xff);
+    }
+    return remainder;
+}
+
+uint16_t crc16_table(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
+{
+    uint16_t const *table = find_table(CRC_MSB16, polynomial, 0);
+    uint16_t remainder    = init;
+
+    for (unsigned byte = 0; byte < nBytes; ++byte) {
+        remainder = (remainder << 8) ^ LOOKUP(table, CRC_MSB16, polynomial, 0, (remainder >> 8) ^ message[byte]);
+    }
+    return remainder;
+}
+
+uint8_t lfsr_digest8_table(uint8_t const message[], unsigned bytes, uint8_t gen, uint8_t key)
+{
+    uint8_t const *times = find_table(LFSR_RIGHT8, gen, key);
+    uint8_t const *roll  = find_table(CRC_LSB8, gen, 0);
+    uint8_t sum          = 0;
+
+    // from the last byte, rolling the sum by a byte for each byte before
+    for (unsigned k = bytes; k-- > 0;) {
+        sum = LOOKUP(roll, CRC_LSB8, gen, 0, sum) ^ LOOKUP(times, LFSR_RIGHT8, gen, key, message[k]);
+    }
+    return sum;
+}
+
+uint8_t lfsr_digest8_reflect_table(uint8_t const message[], int bytes, uint8_t gen, uint8_t key)
+{
+    uint8_t const *times = find_table(LFSR_LEFT8, gen, key);
+    uint8_t const *roll  = find_table(CRC_MSB8, gen, 0);
+    uint8_t sum          = 0;
+
+    // the message is digested from the last byte, so the sum starts at the first
+    for (int k = 0; k < bytes; ++k) {
+        sum = LOOKUP(roll, CRC_MSB8, gen, 0, sum) ^ LOOKUP(times, LFSR_LEFT8, gen, key, message[k]);
+    }
+    return sum;
+}
+
+uint16_t lfsr_digest16_table(uint8_t const message[], unsigned bytes, uint16_t gen, uint16_t key)
+{
+    uint16_t const *times = find_table(LFSR_RIGHT16, gen, key);
+    uint16_t const *roll  = find_table(CRC_LSB16, gen, 0);
+    uint16_t sum          = 0;
+
+    for (unsigned k = bytes; k-- > 0;) {
+        sum = (sum >> 8) ^ LOOKUP(roll, CRC_LSB16, gen, 0, sum & 0xff)
+                ^ LOOKUP(times, LFSR_RIGHT16, gen, key, message[k]);
+    }
+    return sum;
+}
+
+// Unit testing
+#ifdef _TEST
+#include <stdio.h>
+
+#define ASSERT_EQUALS(a, b) \
+    do { \
+        if ((a) == (b)) \
+            ++passed; \
+        else { \
+            ++failed; \
+            fprintf(stderr, "FAIL: line %d: %d <> %d\n", __LINE__, (a), (b)); \
+        } \
+    } while (0)
+
+int main(void)
+{
+    unsigned passed = 0;
+    unsigned failed = 0;
+
+    fprintf(stderr, "crc_table:: test\n");
+
+    fprintf(stderr, "crc_table:: tables in flash\n");
+    for (unsigned i = 0; i < sizeof(flash_tables) / sizeof(*flash_tables); ++i) {
+        crc_table_t const *t = &flash_tables[i];
+        int wide = t->kind == CRC_MSB16 || t->kind == CRC_LSB16 || t->kind == LFSR_RIGHT16;
+        unsigned wrong = 0;
+        for (unsigned x = 0; x < 256; ++x) {
+            unsigned entry = wide ? ((uint16_t const *)t->table)[x] : ((uint8_t const *)t->table)[x];
+            wrong += entry != table_entry(t->kind, t->poly, t->key, x);
+        }
+        ASSERT_EQUALS(wrong, 0);
+    }
+
+    fprintf(stderr, "crc_table:: against the bit-serial checks\n");
+    uint8_t msg[32];
+    srand(433);
+    // more distinct polynomials than CRC_TABLE_CACHE, the last are computed a byte at a time
+    for (int round = 0; round < 64; ++round) {
+        for (unsigned i = 0; i < sizeof(msg); ++i)
+            msg[i] = rand();
+        unsigned len  = rand() % sizeof(msg);
+        uint8_t p8    = round < 32 ? rand() : 0x31;
+        uint8_t i8    = rand();
+        uint16_t p16  = round < 32 ? rand() : 0x8810;
+        uint16_t i16  = rand();
+        ASSERT_EQUALS(crc4_table(msg, len, p8 & 0xf, i8 & 0xf), crc4(msg, len, p8 & 0xf, i8 & 0xf));
+        ASSERT_EQUALS(crc7_table(msg, len, p8 & 0x7f, i8 & 0x7f), crc7(msg, len, p8 & 0x7f, i8 & 0x7f));
+        ASSERT_EQUALS(crc8_table(msg, len, p8, i8), crc8(msg, len, p8, i8));
+        ASSERT_EQUALS(crc8le_table(msg, len, p8, i8), crc8le(msg, len, p8, i8));
+        ASSERT_EQUALS(crc16lsb_table(msg, len, p16, i16), crc16lsb(msg, len, p16, i16));
+        ASSERT_EQUALS(crc16_table(msg, len, p16, i16), crc16(msg, len, p16, i16));
+        ASSERT_EQUALS(lfsr_digest8_table(msg, len, p8, i8), lfsr_digest8(msg, len, p8, i8));
+        ASSERT_EQUALS(lfsr_digest8_reflect_table(msg, len, p8, i8), lfsr_digest8_reflect(msg, len, p8, i8));
+        ASSERT_EQUALS(lfsr_digest16_table(msg, len, p16, i16), lfsr_digest16(msg, len, p16, i16));
+    }
+
+    fprintf(stderr, "crc_table:: LFSR keys of the device decoders\n");
+    for (unsigned i = 0; i < sizeof(flash_tables) / sizeof(*flash_tables); ++i) {
+        crc_table_t const *t = &flash_tables[i];
+        for (unsigned len = 0; len <= 24; len += 3) {
+            if (t->kind == LFSR_RIGHT8)
+                ASSERT_EQUALS(lfsr_digest8_table(msg, len, t->poly, t->key), lfsr_digest8(msg, len, t->poly, t->key));
+            if (t->kind == LFSR_RIGHT16)
+                ASSERT_EQUALS(lfsr_digest16_table(msg, len, t->poly, t->key), lfsr_digest16(msg, len, t->poly, t->key));
+            if (t->kind == LFSR_LEFT8)
+                ASSERT_EQUALS(lfsr_digest8_reflect_table(msg, len, t->poly, t->key), lfsr_digest8_reflect(msg, len, t->poly, t->key));
+        }
+    }
+
+    fprintf(stderr, "crc_table:: test (%u/%u) passed, (%u) failed.\n", passed, passed + failed, failed);
+
+    return failed;
+}
+#endif /* _TEST */
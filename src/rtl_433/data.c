@@ -12,7 +12,6 @@
 
 #include "data.h"
 
-#include "abuf.h"
 #include "fatal.h"
 
 #include <stdarg.h>
@@ -21,6 +20,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 // Macro to prevent unused variables (passed into a function)
 // from generating a warning.
@@ -115,6 +115,85 @@ static bool import_values(void *dst, void const *src, int num_values, data_type_
     return true; // error is returned early
 }
 
+/* arena */
+
+#if defined(__GNUC__)
+#define DATA_THREAD_LOCAL __thread
+#else
+#define DATA_THREAD_LOCAL
+#endif
+
+#define DATA_ARENA_ALIGN sizeof(double)
+
+static DATA_THREAD_LOCAL data_arena_t *data_arena_current;
+
+R_API void data_arena_init(data_arena_t *arena, void *block, size_t size)
+{
+    memset(arena, 0, sizeof(*arena));
+    arena->block = block;
+    arena->size  = size;
+}
+
+R_API data_arena_t *data_arena_use(data_arena_t *arena)
+{
+    data_arena_t *previous = data_arena_current;
+    data_arena_current     = arena;
+    return previous;
+}
+
+R_API void data_arena_reset(data_arena_t *arena)
+{
+    arena->used = 0;
+}
+
+/// Allocate from the arena in use, NULL if there is none or it is full.
+static void *arena_alloc(size_t size)
+{
+    data_arena_t *arena = data_arena_current;
+    if (!arena)
+        return NULL;
+    size_t start = (arena->used + DATA_ARENA_ALIGN - 1) & ~(DATA_ARENA_ALIGN - 1);
+    if (start + size > arena->size) {
+        arena->overflows++;
+        return NULL;
+    }
+    arena->used = start + size;
+    if (arena->used > arena->peak)
+        arena->peak = arena->used;
+    return arena->block + start;
+}
+
+/// Copy a string to the arena in use setting the borrow bit, or to the heap.
+static char *arena_strdup(char const *str, unsigned *borrowed, unsigned bit)
+{
+    size_t size = strlen(str) + 1;
+    char *copy  = arena_alloc(size);
+    if (copy) {
+        *borrowed |= bit;
+        return memcpy(copy, str, size);
+    }
+    copy = strdup(str);
+    if (!copy)
+        WARN_STRDUP("vdata_make()");
+    return copy;
+}
+
+R_API void data_borrow_key(data_t *data, char const *key)
+{
+    if (!(data->borrowed & DATA_BORROW_KEY))
+        free(data->key);
+    data->key = (char *)key;
+    data->borrowed |= DATA_BORROW_KEY;
+}
+
+R_API void data_borrow_format(data_t *data, char const *format)
+{
+    if (!(data->borrowed & DATA_BORROW_FORMAT))
+        free(data->format);
+    data->format = (char *)format;
+    data->borrowed |= DATA_BORROW_FORMAT;
+}
+
 /* data */
 
 R_API data_array_t *data_array(int num_values, data_type_t type, void const *values)
@@ -158,6 +237,7 @@ static data_t *vdata_make(data_t *first, const char *key, const char *pretty_key
     while (prev && prev->next)
         prev = prev->next;
     char *format = NULL;
+    unsigned borrowed = 0; // DATA_BORROW_* of format and value
     int skip = 0; // skip the data item if this is set
     type = va_arg(ap, data_type_t);
     do {
@@ -176,9 +256,8 @@ static data_t *vdata_make(data_t *first, const char *key, const char *pretty_key
                 fprintf(stderr, "vdata_make() format type used twice\n");
                 goto alloc_error;
             }
-            format = strdup(va_arg(ap, char *));
+            format = arena_strdup(va_arg(ap, char *), &borrowed, DATA_BORROW_FORMAT);
             if (!format) {
-                WARN_STRDUP("vdata_make()");
                 goto alloc_error;
             }
             type = va_arg(ap, data_type_t);
@@ -197,10 +276,9 @@ static data_t *vdata_make(data_t *first, const char *key, const char *pretty_key
             value.v_dbl = va_arg(ap, double);
             break;
         case DATA_STRING:
-            value_release = (value_release_fn)free; // appease CSA checker
-            value.v_ptr = strdup(va_arg(ap, char *));
-            if (!value.v_ptr)
-                WARN_STRDUP("vdata_make()");
+            value.v_ptr = arena_strdup(va_arg(ap, char *), &borrowed, DATA_BORROW_VALUE);
+            if (!(borrowed & DATA_BORROW_VALUE))
+                value_release = (value_release_fn)free; // appease CSA checker
             break;
         case DATA_ARRAY:
             value_release = (value_release_fn)data_array_free; // appease CSA checker
@@ -214,23 +292,34 @@ static data_t *vdata_make(data_t *first, const char *key, const char *pretty_key
         if (skip) {
             if (value_release) // could use dmt[type].value_release
                 value_release(value.v_ptr);
-            free(format);
+            if (!(borrowed & DATA_BORROW_FORMAT))
+                free(format);
             format = NULL;
+            borrowed = 0;
             skip = 0;
         }
         else {
-            current = calloc(1, sizeof(*current));
+            current = arena_alloc(sizeof(*current));
+            if (current) {
+                memset(current, 0, sizeof(*current));
+                borrowed |= DATA_BORROW_NODE;
+            }
+            else {
+                current = calloc(1, sizeof(*current));
+            }
             if (!current) {
                 WARN_CALLOC("vdata_make()");
                 if (value_release) // could use dmt[type].value_release
                     value_release(value.v_ptr);
                 goto alloc_error;
             }
-            current->type   = type;
-            current->format = format;
-            format          = NULL; // consumed
-            current->value  = value;
-            current->next   = NULL;
+            current->type     = type;
+            current->format   = format;
+            format            = NULL; // consumed
+            current->value    = value;
+            current->next     = NULL;
+            current->borrowed = borrowed;
+            borrowed          = 0;
 
             if (prev)
                 prev->next = current;
@@ -238,14 +327,12 @@ static data_t *vdata_make(data_t *first, const char *key, const char *pretty_key
             if (!first)
                 first = current;
 
-            current->key = strdup(key);
+            current->key = arena_strdup(key, &current->borrowed, DATA_BORROW_KEY);
             if (!current->key) {
-                WARN_STRDUP("vdata_make()");
                 goto alloc_error;
             }
-            current->pretty_key = strdup(pretty_key ? pretty_key : key);
+            current->pretty_key = arena_strdup(pretty_key ? pretty_key : key, &current->borrowed, DATA_BORROW_PRETTY_KEY);
             if (!current->pretty_key) {
-                WARN_STRDUP("vdata_make()");
                 goto alloc_error;
             }
         }
@@ -266,7 +353,8 @@ static data_t *vdata_make(data_t *first, const char *key, const char *pretty_key
     return first;
 
 alloc_error:
-    free(format); // if not consumed
+    if (!(borrowed & DATA_BORROW_FORMAT))
+        free(format); // if not consumed
     data_free(first);
     return NULL;
 }
@@ -334,13 +422,18 @@ R_API void data_free(data_t *data)
     }
     while (data) {
         data_t *prev_data = data;
-        if (dmt[data->type].value_release)
+        unsigned borrowed = data->borrowed;
+        if (dmt[data->type].value_release && !(borrowed & DATA_BORROW_VALUE))
             dmt[data->type].value_release(data->value.v_ptr);
-        free(data->format);
-        free(data->pretty_key);
-        free(data->key);
+        if (!(borrowed & DATA_BORROW_FORMAT))
+            free(data->format);
+        if (!(borrowed & DATA_BORROW_PRETTY_KEY))
+            free(data->pretty_key);
+        if (!(borrowed & DATA_BORROW_KEY))
+            free(data->key);
         data = data->next;
-        free(prev_data);
+        if (!(borrowed & DATA_BORROW_NODE))
+            free(prev_data);
     }
 }
 
@@ -417,144 +510,303 @@ R_API void print_array_value(data_output_t *output, data_array_t *array, char co
 
 /* JSON string printer */
 
+/*
+    The message serializers write straight into the caller's buffer in one
+    walk of the data. Once the buffer is full they keep counting, so the
+    return value is always the size the complete message needs.
+*/
+
 typedef struct {
-    struct data_output output;
-    abuf_t msg;
-} data_print_jsons_t;
+    uint8_t *dst;
+    size_t len; ///< usable bytes of dst
+    size_t pos; ///< bytes of the complete output so far
+} msg_writer_t;
 
-static void R_API_CALLCONV format_jsons_array(data_output_t *output, data_array_t *array, char const *format)
+static void msg_write(msg_writer_t *w, void const *src, size_t n)
 {
-    data_print_jsons_t *jsons = (data_print_jsons_t *)output;
-
-    abuf_cat(&jsons->msg, "[");
-    for (int c = 0; c < array->num_values; ++c) {
-        if (c)
-            abuf_cat(&jsons->msg, ",");
-        print_array_value(output, array, format, c);
+    if (w->pos < w->len) {
+        size_t room = w->len - w->pos;
+        memcpy(w->dst + w->pos, src, n < room ? n : room);
     }
-    abuf_cat(&jsons->msg, "]");
+    w->pos += n;
 }
 
-static void R_API_CALLCONV format_jsons_object(data_output_t *output, data_t *data, char const *format)
+static void msg_putc(msg_writer_t *w, uint8_t c)
 {
-    UNUSED(format);
-    data_print_jsons_t *jsons = (data_print_jsons_t *)output;
-
-    bool separator = false;
-    abuf_cat(&jsons->msg, "{");
-    while (data) {
-        if (separator)
-            abuf_cat(&jsons->msg, ",");
-        output->print_string(output, data->key, NULL);
-        abuf_cat(&jsons->msg, ":");
-        print_value(output, data->type, data->value, data->format);
-        separator = true;
-        data      = data->next;
-    }
-    abuf_cat(&jsons->msg, "}");
+    if (w->pos < w->len)
+        w->dst[w->pos] = c;
+    w->pos++;
 }
 
-static void R_API_CALLCONV format_jsons_string(data_output_t *output, const char *str, char const *format)
-{
-    UNUSED(format);
-    data_print_jsons_t *jsons = (data_print_jsons_t *)output;
-
-    char *buf   = jsons->msg.tail;
-    size_t size = jsons->msg.left;
+static void json_write_value(msg_writer_t *w, data_type_t type, data_value_t value);
 
+static void json_write_string(msg_writer_t *w, char const *str)
+{
     size_t str_len = strlen(str);
-    if (size < str_len + 3) {
-        return;
-    }
-
-    if (str[0] == '{' && str[str_len - 1] == '}') {
+    if (str_len >= 2 && str[0] == '{' && str[str_len - 1] == '}') {
         // Print embedded JSON object verbatim
-        abuf_cat(&jsons->msg, str);
+        msg_write(w, str, str_len);
         return;
     }
 
-    *buf++ = '"';
-    size--;
-    for (; *str && size >= 3; ++str) {
-        if (*str == '\r') {
-            *buf++ = '\\';
-            size--;
-            *buf++ = 'r';
-            size--;
-            continue;
+    msg_putc(w, '"');
+    for (char const *run = str; *str; ++str) {
+        char esc = 0;
+        switch (*str) {
+        case '\r': esc = 'r'; break;
+        case '\n': esc = 'n'; break;
+        case '\t': esc = 't'; break;
+        case '"':  esc = '"'; break;
+        case '\\': esc = '\\'; break;
         }
-        if (*str == '\n') {
-            *buf++ = '\\';
-            size--;
-            *buf++ = 'n';
-            size--;
-            continue;
+        if (esc) {
+            msg_write(w, run, str - run);
+            msg_putc(w, '\\');
+            msg_putc(w, esc);
+            run = str + 1;
         }
-        if (*str == '\t') {
-            *buf++ = '\\';
-            size--;
-            *buf++ = 't';
-            size--;
-            continue;
-        }
-        if (*str == '"' || *str == '\\') {
-            *buf++ = '\\';
-            size--;
-        }
-        *buf++ = *str;
-        size--;
-    }
-    if (size >= 2) {
-        *buf++ = '"';
-        size--;
+        if (!str[1])
+            msg_write(w, run, str + 1 - run);
     }
-    *buf = '\0';
+    msg_putc(w, '"');
+}
 
-    jsons->msg.tail = buf;
-    jsons->msg.left = size;
+static void json_write_int(msg_writer_t *w, int data)
+{
+    char buf[12];
+    char *p = buf + sizeof(buf);
+    unsigned u = data < 0 ? -(unsigned)data : (unsigned)data;
+    do {
+        *--p = '0' + u % 10;
+        u /= 10;
+    } while (u);
+    if (data < 0)
+        *--p = '-';
+    msg_write(w, p, buf + sizeof(buf) - p);
 }
 
-static void R_API_CALLCONV format_jsons_double(data_output_t *output, double data, char const *format)
+static void json_write_double(msg_writer_t *w, double data)
 {
-    UNUSED(format);
-    data_print_jsons_t *jsons = (data_print_jsons_t *)output;
+    char buf[32];
+    int len;
     // use scientific notation for very big/small values
     if (data > 1e7 || data < 1e-4) {
-        abuf_printf(&jsons->msg, "%g", data);
+        len = snprintf(buf, sizeof(buf), "%g", data);
     }
     else {
-        abuf_printf(&jsons->msg, "%.5f", data);
+        len = snprintf(buf, sizeof(buf), "%.5f", data);
         // remove trailing zeros, always keep one digit after the decimal point
-        while (jsons->msg.left > 0 && *(jsons->msg.tail - 1) == '0' && *(jsons->msg.tail - 2) != '.') {
-            jsons->msg.tail--;
-            jsons->msg.left++;
-            *jsons->msg.tail = '\0';
-        }
+        while (len > 2 && buf[len - 1] == '0' && buf[len - 2] != '.')
+            len--;
     }
+    msg_write(w, buf, len);
 }
 
-static void R_API_CALLCONV format_jsons_int(data_output_t *output, int data, char const *format)
+static void json_write_object(msg_writer_t *w, data_t const *data)
 {
-    UNUSED(format);
-    data_print_jsons_t *jsons = (data_print_jsons_t *)output;
-    abuf_printf(&jsons->msg, "%d", data);
+    msg_putc(w, '{');
+    for (bool separator = false; data; data = data->next, separator = true) {
+        if (separator)
+            msg_putc(w, ',');
+        json_write_string(w, data->key);
+        msg_putc(w, ':');
+        json_write_value(w, data->type, data->value);
+    }
+    msg_putc(w, '}');
+}
+
+static void json_write_array(msg_writer_t *w, data_array_t const *array)
+{
+    int element_size = dmt[array->type].array_element_size;
+    msg_putc(w, '[');
+    for (int c = 0; c < array->num_values; ++c) {
+        data_value_t value = {0};
+        void const *element = (char const *)array->values + element_size * c;
+        if (dmt[array->type].array_is_boxed)
+            value.v_ptr = *(void *const *)element;
+        else
+            memcpy(&value, element, element_size);
+        if (c)
+            msg_putc(w, ',');
+        json_write_value(w, array->type, value);
+    }
+    msg_putc(w, ']');
+}
+
+static void json_write_value(msg_writer_t *w, data_type_t type, data_value_t value)
+{
+    switch (type) {
+    case DATA_DATA:
+        json_write_object(w, value.v_ptr);
+        break;
+    case DATA_INT:
+        json_write_int(w, value.v_int);
+        break;
+    case DATA_DOUBLE:
+        json_write_double(w, value.v_dbl);
+        break;
+    case DATA_STRING:
+        json_write_string(w, value.v_ptr);
+        break;
+    case DATA_ARRAY:
+        json_write_array(w, value.v_ptr);
+        break;
+    default:
+        assert(0);
+        break;
+    }
 }
 
 R_API size_t data_print_jsons(data_t *data, char *dst, size_t len)
 {
-    data_print_jsons_t jsons = {
-            .output = {
-                    .print_data   = format_jsons_object,
-                    .print_array  = format_jsons_array,
-                    .print_string = format_jsons_string,
-                    .print_double = format_jsons_double,
-                    .print_int    = format_jsons_int,
-            },
-    };
+    msg_writer_t w = {(uint8_t *)dst, len ? len - 1 : 0, 0};
+
+    json_write_object(&w, data);
+
+    if (len)
+        dst[w.pos < w.len ? w.pos : w.len] = '\0';
+    return w.pos;
+}
+
+/* CBOR printer (RFC 8949) */
+
+enum {
+    CBOR_UINT   = 0,
+    CBOR_NINT   = 1,
+    CBOR_TEXT   = 3,
+    CBOR_ARRAY  = 4,
+    CBOR_MAP    = 5,
+    CBOR_SIMPLE = 7,
+};
+
+static void cbor_write_value(msg_writer_t *w, data_type_t type, data_value_t value);
+
+static void cbor_write_head(msg_writer_t *w, unsigned major, uint32_t arg)
+{
+    uint8_t head[5];
+    size_t n;
+    if (arg < 24) {
+        head[0] = (major << 5) | arg;
+        n       = 1;
+    }
+    else if (arg <= 0xff) {
+        head[0] = (major << 5) | 24;
+        head[1] = arg;
+        n       = 2;
+    }
+    else if (arg <= 0xffff) {
+        head[0] = (major << 5) | 25;
+        head[1] = arg >> 8;
+        head[2] = arg;
+        n       = 3;
+    }
+    else {
+        head[0] = (major << 5) | 26;
+        head[1] = arg >> 24;
+        head[2] = arg >> 16;
+        head[3] = arg >> 8;
+        head[4] = arg;
+        n       = 5;
+    }
+    msg_write(w, head, n);
+}
+
+static void cbor_write_string(msg_writer_t *w, char const *str)
+{
+    size_t len = strlen(str);
+    cbor_write_head(w, CBOR_TEXT, len);
+    msg_write(w, str, len);
+}
+
+static void cbor_write_int(msg_writer_t *w, int data)
+{
+    if (data < 0)
+        cbor_write_head(w, CBOR_NINT, -1 - (int64_t)data);
+    else
+        cbor_write_head(w, CBOR_UINT, data);
+}
+
+static void cbor_write_double(msg_writer_t *w, double data)
+{
+    uint8_t buf[9];
+    size_t n;
+    float single = (float)data;
+    // half the size when single precision holds the value exactly
+    if ((double)single == data) {
+        uint32_t bits;
+        memcpy(&bits, &single, sizeof(bits));
+        buf[0] = (CBOR_SIMPLE << 5) | 26;
+        for (int i = 0; i < 4; ++i)
+            buf[1 + i] = bits >> (24 - 8 * i);
+        n = 5;
+    }
+    else {
+        uint64_t bits;
+        memcpy(&bits, &data, sizeof(bits));
+        buf[0] = (CBOR_SIMPLE << 5) | 27;
+        for (int i = 0; i < 8; ++i)
+            buf[1 + i] = bits >> (56 - 8 * i);
+        n = 9;
+    }
+    msg_write(w, buf, n);
+}
+
+static void cbor_write_object(msg_writer_t *w, data_t const *data)
+{
+    unsigned count = 0;
+    for (data_t const *d = data; d; d = d->next)
+        count++;
+    cbor_write_head(w, CBOR_MAP, count);
+    for (; data; data = data->next) {
+        cbor_write_string(w, data->key);
+        cbor_write_value(w, data->type, data->value);
+    }
+}
+
+static void cbor_write_array(msg_writer_t *w, data_array_t const *array)
+{
+    int element_size = dmt[array->type].array_element_size;
+    cbor_write_head(w, CBOR_ARRAY, array->num_values);
+    for (int c = 0; c < array->num_values; ++c) {
+        data_value_t value = {0};
+        void const *element = (char const *)array->values + element_size * c;
+        if (dmt[array->type].array_is_boxed)
+            value.v_ptr = *(void *const *)element;
+        else
+            memcpy(&value, element, element_size);
+        cbor_write_value(w, array->type, value);
+    }
+}
 
-    abuf_init(&jsons.msg, dst, len);
+static void cbor_write_value(msg_writer_t *w, data_type_t type, data_value_t value)
+{
+    switch (type) {
+    case DATA_DATA:
+        cbor_write_object(w, value.v_ptr);
+        break;
+    case DATA_INT:
+        cbor_write_int(w, value.v_int);
+        break;
+    case DATA_DOUBLE:
+        cbor_write_double(w, value.v_dbl);
+        break;
+    case DATA_STRING:
+        cbor_write_string(w, value.v_ptr);
+        break;
+    case DATA_ARRAY:
+        cbor_write_array(w, value.v_ptr);
+        break;
+    default:
+        assert(0);
+        break;
+    }
+}
+
+R_API size_t data_print_cbor(data_t *data, uint8_t *dst, size_t len)
+{
+    msg_writer_t w = {dst, len, 0};
 
-    format_jsons_object(&jsons.output, data, NULL);
+    cbor_write_object(&w, data);
 
-    return len - jsons.msg.left;
+    return w.pos;
 }
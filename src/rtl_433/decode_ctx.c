@@ -0,0 +1,147 @@
+/** @file
+    Decode context, the mutable state of one decode worker.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "decode_ctx.h"
+#include "decoder_util.h"
+#include "fatal.h"
+#include "logger.h"
+#include <stdlib.h>
+
+#if defined(__GNUC__)
+#define DECODE_THREAD_LOCAL __thread
+#else
+#define DECODE_THREAD_LOCAL
+#endif
+
+static DECODE_THREAD_LOCAL decode_ctx_t *decode_ctx_current;
+
+decode_ctx_t *decode_ctx_create(void)
+{
+    decode_ctx_t *ctx = calloc(1, sizeof(decode_ctx_t));
+    if (ctx)
+        data_arena_init(&ctx->arena, ctx->arena_block, sizeof(ctx->arena_block));
+    return ctx;
+}
+
+void decode_ctx_free(decode_ctx_t *ctx)
+{
+    if (!ctx)
+        return;
+    free(ctx->slice_bits);
+    for (int i = 0; i < DECODE_SCRATCH_BITBUFFERS; ++i)
+        free(ctx->scratch[i]);
+    free(ctx);
+}
+
+decode_ctx_t *decode_ctx_use(decode_ctx_t *ctx)
+{
+    decode_ctx_t *previous = decode_ctx_current;
+    decode_ctx_current     = ctx;
+    return previous;
+}
+
+bitbuffer_t *decoder_scratch_bitbuffer(unsigned slot)
+{
+    decode_ctx_t *ctx = decode_ctx_current;
+    if (!ctx || slot >= DECODE_SCRATCH_BITBUFFERS) {
+        print_logf(LOG_ERROR, __func__, "No scratch bitbuffer %u outside a decoder or past %d: notify maintainer", slot, DECODE_SCRATCH_BITBUFFERS);
+        exit(1);
+    }
+    if (!ctx->scratch[slot]) {
+        ctx->scratch[slot] = malloc(sizeof(*ctx->scratch[slot]));
+        if (!ctx->scratch[slot])
+            FATAL_CALLOC("decoder_scratch_bitbuffer()");
+    }
+    bitbuffer_clear(ctx->scratch[slot]);
+    return ctx->scratch[slot];
+}
+
+// Unit testing
+#ifdef _TEST
+#include "pulse_slicer.h"
+#include <stdio.h>
+
+#define ASSERT(expr) \
+    do { \
+        if (expr) { \
+            ++passed; \
+        } else { \
+            ++failed; \
+            fprintf(stderr, "FAIL: line %d: %s\n", __LINE__, #expr); \
+        } \
+    } while (0)
+
+static bitbuffer_t *borrowed[2];
+static int cleared;
+static uint8_t sliced;
+
+// borrows both scratch bitbuffers, the first twice, and leaves a bit in the second
+static int scratch_decode(r_device *decoder, bitbuffer_t *bitbuffer)
+{
+    (void)decoder;
+    borrowed[0] = decoder_scratch_bitbuffer(0);
+    bitbuffer_add_bit(borrowed[0], 1);
+    borrowed[1] = decoder_scratch_bitbuffer(1);
+    bitbuffer_add_bit(borrowed[1], 1);
+    cleared     = decoder_scratch_bitbuffer(0) == borrowed[0] && borrowed[0]->num_rows == 0 && borrowed[0]->bb[0][0] == 0;
+    sliced      = bitbuffer->bb[0][0];
+    return 0;
+}
+
+int main(void)
+{
+    unsigned passed = 0;
+    unsigned failed = 0;
+
+    fprintf(stderr, "decode_ctx:: test\n");
+
+    decode_ctx_t *ctx = decode_ctx_create();
+    ASSERT(ctx && !ctx->scratch[0] && !ctx->scratch[1]);
+
+    // one 8 bit message at 100 us a bit, 1 0 1 1 0 0 1 1
+    pulse_data_t *pulses = pulse_data_alloc(8);
+    unsigned levels[]    = {100, 100, 200, 200, 200, 20000};
+    for (unsigned i = 0; i < 3; ++i) {
+        pulse_data_set_pulse(pulses, i, levels[2 * i]);
+        pulse_data_set_gap(pulses, i, levels[2 * i + 1]);
+    }
+    pulses->num_pulses  = 3;
+    pulses->sample_rate = 1000000;
+    r_device device     = {0};
+    device.name         = "scratch";
+    device.modulation   = OOK_PULSE_PCM;
+    device.short_width  = 100;
+    device.long_width   = 100;
+    device.reset_limit  = 10000;
+    device.decode_fn    = scratch_decode;
+
+    fprintf(stderr, "TEST: decode_ctx:: a decoder borrows the scratch bitbuffers of the slicing context\n");
+    pulse_slicer_pcm(ctx, pulses, &device);
+    ASSERT(borrowed[0] == ctx->scratch[0] && borrowed[1] == ctx->scratch[1]);
+    ASSERT(borrowed[0] && borrowed[1] && borrowed[0] != borrowed[1]);
+    ASSERT(cleared);
+    ASSERT(sliced == 0xb3);
+    ASSERT(borrowed[1]->num_rows == 1 && borrowed[1]->bb[0][0] == 0x80);
+
+    fprintf(stderr, "TEST: decode_ctx:: the context lends only while the decoder runs\n");
+    ASSERT(decode_ctx_use(NULL) == NULL);
+
+    fprintf(stderr, "TEST: decode_ctx:: the scratch bitbuffers are kept for the next train\n");
+    bitbuffer_t *first[2] = {borrowed[0], borrowed[1]};
+    pulse_slicer_pcm(ctx, pulses, &device);
+    ASSERT(borrowed[0] == first[0] && borrowed[1] == first[1]);
+
+    free(pulses);
+    decode_ctx_free(ctx);
+
+    fprintf(stderr, "decode_ctx:: test (%u/%u) passed, (%u) failed.\n", passed, passed + failed, failed);
+
+    return failed;
+}
+#endif /* _TEST */
@@ -0,0 +1,147 @@
+/** @file
+    Decoder dispatch tables, registered decoders ordered by priority.
+
+    The demod loops used to rescan every registered decoder once per
+    priority and switch on the modulation of each. The tables are built
+    when the decoder list changes instead: per modulation family, the
+    decoders sorted by priority with their slicer, and the index range of
+    each priority level.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "demod_dispatch.h"
+#include "pulse_slicer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Slicer for a modulation, NULL if unknown.
+static pulse_slicer_fn modulation_slicer(unsigned modulation)
+{
+    switch (modulation) {
+    case OOK_PULSE_PCM:
+    // case OOK_PULSE_RZ:
+    case FSK_PULSE_PCM:
+        return pulse_slicer_pcm;
+    case OOK_PULSE_PPM:
+        return pulse_slicer_ppm;
+    case OOK_PULSE_PWM:
+    case FSK_PULSE_PWM:
+        return pulse_slicer_pwm;
+    case OOK_PULSE_MANCHESTER_ZEROBIT:
+    case FSK_PULSE_MANCHESTER_ZEROBIT:
+        return pulse_slicer_manchester_zerobit;
+    case OOK_PULSE_PIWM_RAW:
+        return pulse_slicer_piwm_raw;
+    case OOK_PULSE_PIWM_DC:
+        return pulse_slicer_piwm_dc;
+    case OOK_PULSE_DMC:
+        return pulse_slicer_dmc;
+    case OOK_PULSE_PWM_OSV1:
+        return pulse_slicer_osv1;
+    case OOK_PULSE_NRZS:
+        return pulse_slicer_nrzs;
+    default:
+        return NULL;
+    }
+}
+
+/// Grow the table to at least capacity entries, doubling to keep rebuilds on each registration cheap.
+static int table_reserve(demod_table_t *table, unsigned capacity)
+{
+    if (capacity == 0 || capacity <= table->capacity)
+        return 0;
+    if (capacity < 2 * table->capacity)
+        capacity = 2 * table->capacity;
+    demod_entry_t *entries = realloc(table->entries, capacity * sizeof(*entries));
+    if (entries)
+        table->entries = entries;
+    demod_level_t *levels = realloc(table->levels, capacity * sizeof(*levels));
+    if (levels)
+        table->levels = levels;
+    if (!entries || !levels)
+        return -1;
+    table->capacity = capacity;
+    return 0;
+}
+
+/// Insert keeping the entries stable sorted by priority, the list is mostly in order already.
+static void table_insert(demod_table_t *table, demod_entry_t const *entry)
+{
+    unsigned pos = table->num_entries++;
+    while (pos > 0 && table->entries[pos - 1].r_dev->priority > entry->r_dev->priority) {
+        table->entries[pos] = table->entries[pos - 1];
+        pos--;
+    }
+    table->entries[pos] = *entry;
+}
+
+static void table_index_levels(demod_table_t *table)
+{
+    demod_level_t *level = NULL;
+    table->num_levels = 0;
+    for (unsigned i = 0; i < table->num_entries; ++i) {
+        unsigned priority = table->entries[i].r_dev->priority;
+        if (!level || level->priority != priority) {
+            level = &table->levels[table->num_levels++];
+            level->priority = priority;
+            level->first    = i;
+            level->count    = 0;
+        }
+        level->count++;
+    }
+}
+
+int demod_dispatch_build(demod_dispatch_t *dispatch, list_t const *r_devs)
+{
+    dispatch->ook.num_entries = dispatch->ook.num_levels = 0;
+    dispatch->fsk.num_entries = dispatch->fsk.num_levels = 0;
+
+    unsigned ook_count = 0;
+    unsigned fsk_count = 0;
+    for (void **iter = r_devs->elems; iter && *iter; ++iter) {
+        r_device const *r_dev = *iter;
+        if (!r_dev->slice_follower) {
+            if (r_dev->modulation >= FSK_DEMOD_MIN_VAL)
+                fsk_count++;
+            else
+                ook_count++;
+        }
+    }
+    if (table_reserve(&dispatch->ook, ook_count) || table_reserve(&dispatch->fsk, fsk_count)) {
+        return -1;
+    }
+
+    for (void **iter = r_devs->elems; iter && *iter; ++iter) {
+        r_device *r_dev = *iter;
+        if (r_dev->slice_follower)
+            continue;
+
+        demod_entry_t entry = {r_dev, modulation_slicer(r_dev->modulation), 0};
+        if (!entry.slicer) {
+            fprintf(stderr, "Unknown modulation %u in protocol!\n", r_dev->modulation);
+            continue;
+        }
+        for (r_device *follower = r_dev->slice_next; follower; follower = follower->slice_next)
+            entry.followers++;
+
+        table_insert(r_dev->modulation >= FSK_DEMOD_MIN_VAL ? &dispatch->fsk : &dispatch->ook, &entry);
+    }
+
+    table_index_levels(&dispatch->ook);
+    table_index_levels(&dispatch->fsk);
+    return 0;
+}
+
+void demod_dispatch_free(demod_dispatch_t *dispatch)
+{
+    free(dispatch->ook.entries);
+    free(dispatch->ook.levels);
+    free(dispatch->fsk.entries);
+    free(dispatch->fsk.levels);
+    memset(dispatch, 0, sizeof(*dispatch));
+}
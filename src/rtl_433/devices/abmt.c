@@ -39,7 +39,7 @@ static int abmt_callback(r_device *decoder, bitbuffer_t *bitbuffer)
 {
     int row;
     float temp_c;
-    bitbuffer_t packet_bits = {0};
+    bitbuffer_t *packet_bits = decoder_scratch_bitbuffer(0);
     unsigned int id;
     data_t *data;
     unsigned bitpos = 0;
@@ -62,10 +62,10 @@ static int abmt_callback(r_device *decoder, bitbuffer_t *bitbuffer)
         return DECODE_FAIL_SANITY;
 
     // sync bitstream
-    bitbuffer_manchester_decode(bitbuffer, row, bitpos - SYNC_PATTERN_START_OFF, &packet_bits, 48);
-    bitbuffer_invert(&packet_bits);
+    bitbuffer_manchester_decode(bitbuffer, row, bitpos - SYNC_PATTERN_START_OFF, packet_bits, 48);
+    bitbuffer_invert(packet_bits);
 
-    b      = packet_bits.bb[0];
+    b      = packet_bits->bb[0];
     id     = b[0];
     temp   = bcd2int(b[3]) * 10 + bcd2int(b[4] >> 4);
     temp_c = (float)temp;
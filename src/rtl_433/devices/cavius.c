@@ -59,17 +59,17 @@ static int cavius_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     }
     bit_offset += sizeof(preamble) * 8; // skip sync
 
-    bitbuffer_t databits = {0};
+    bitbuffer_t *databits = decoder_scratch_bitbuffer(0);
 
-    bitbuffer_manchester_decode(bitbuffer, 0, bit_offset, &databits, 11 * 8);
-    bitbuffer_invert(&databits);
+    bitbuffer_manchester_decode(bitbuffer, 0, bit_offset, databits, 11 * 8);
+    bitbuffer_invert(databits);
 
     // we require 11 bytes
-    if (databits.bits_per_row[0] < 11 * 8) {
+    if (databits->bits_per_row[0] < 11 * 8) {
         return DECODE_FAIL_SANITY; // manchester_decode fail
     }
 
-    uint8_t *b = databits.bb[0];
+    uint8_t *b = databits->bb[0];
 
     int crc = crc8le(b, 7, 0x31, 0x0);
     if (crc != 0) {
@@ -69,7 +69,7 @@ static int celsia_czc1_decode(r_device *decoder, bitbuffer_t *bitbuffer)
         return DECODE_ABORT_LENGTH;
     }
 
-    bitbuffer_t decoded_bits = {0};
+    bitbuffer_t *decoded_bits = decoder_scratch_bitbuffer(0);
     //convert raw bits to symbols
 
     uint8_t *bits = bitbuffer->bb[0];
@@ -81,27 +81,27 @@ static int celsia_czc1_decode(r_device *decoder, bitbuffer_t *bitbuffer)
         }
         switch (bits[ipos]) {
         case 0x55:
-            bitbuffer_add_bit(&decoded_bits, 0);
-            bitbuffer_add_bit(&decoded_bits, 0);
+            bitbuffer_add_bit(decoded_bits, 0);
+            bitbuffer_add_bit(decoded_bits, 0);
             break;
         case 0x5a:
-            bitbuffer_add_bit(&decoded_bits, 0);
-            bitbuffer_add_bit(&decoded_bits, 1);
+            bitbuffer_add_bit(decoded_bits, 0);
+            bitbuffer_add_bit(decoded_bits, 1);
             break;
         case 0xa5:
-            bitbuffer_add_bit(&decoded_bits, 1);
-            bitbuffer_add_bit(&decoded_bits, 0);
+            bitbuffer_add_bit(decoded_bits, 1);
+            bitbuffer_add_bit(decoded_bits, 0);
             break;
         case 0xaa:
-            bitbuffer_add_bit(&decoded_bits, 1);
-            bitbuffer_add_bit(&decoded_bits, 1);
+            bitbuffer_add_bit(decoded_bits, 1);
+            bitbuffer_add_bit(decoded_bits, 1);
             break;
         }
         ipos++;
     }
 
-    decoder_log_bitbuffer(decoder, 2, __func__, &decoded_bits, "Extracted data");
-    uint8_t *b = decoded_bits.bb[0];
+    decoder_log_bitbuffer(decoder, 2, __func__, decoded_bits, "Extracted data");
+    uint8_t *b = decoded_bits->bb[0];
 
     uint8_t crc = crc8(b, 8, 0x31, 0xd7);
     if (crc != 0) {
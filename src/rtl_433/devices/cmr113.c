@@ -50,7 +50,7 @@ static int cmr113_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     int start, bit;
     uint8_t buf[4];
     uint8_t b1[COMPARE_BYTES], b2[COMPARE_BYTES];
-    bitbuffer_t b = {0};
+    bitbuffer_t *b = decoder_scratch_bitbuffer(0);
     double current[3];
     data_t *data;
 
@@ -63,16 +63,16 @@ static int cmr113_decode(r_device *decoder, bitbuffer_t *bitbuffer)
 
     start = 0;
     bit = 0;
-    bitbuffer_clear(&b);
+    bitbuffer_clear(b);
     while ((start + 3) < bitbuffer->bits_per_row[0]) {
         bitbuffer_extract_bytes(bitbuffer, 0, start, buf, 3);
         if ((buf[0] >> 6) == 0x00) { // top two bits are 0b00 = no toggle
             start += 2;
-            bitbuffer_add_bit(&b, bit);
+            bitbuffer_add_bit(b, bit);
         } else if ((buf[0] >> 5) == 0x03) { // top two bits are 0b011 = toggle
             start += 3;
             bit = 1 - bit; // toggle
-            bitbuffer_add_bit(&b, bit);
+            bitbuffer_add_bit(b, bit);
         } else if (start == 0)
             start += 1; // first bit doesn't decode
         else
@@ -80,18 +80,18 @@ static int cmr113_decode(r_device *decoder, bitbuffer_t *bitbuffer)
             return DECODE_ABORT_LENGTH;
     }
 
-    if (b.bits_per_row[0] < 2 * COMPARE_BITS + 2)
+    if (b->bits_per_row[0] < 2 * COMPARE_BITS + 2)
         return DECODE_ABORT_LENGTH;
 
     // Compare the repeated section to ensure data integrity
-    bitbuffer_extract_bytes(&b, 0, 0, b1, COMPARE_BITS);
-    bitbuffer_extract_bytes(&b, 0, COMPARE_BITS + 2, b2, COMPARE_BITS);
+    bitbuffer_extract_bytes(b, 0, 0, b1, COMPARE_BITS);
+    bitbuffer_extract_bytes(b, 0, COMPARE_BITS + 2, b2, COMPARE_BITS);
     if (memcmp(b1, b2, COMPARE_BYTES) != 0)
         return DECODE_FAIL_MIC;
 
     // Data is all good, so extract 3 phases of current
     for (int i = 0; i < 3; i++) {
-        bitbuffer_extract_bytes(&b, 0, 36 + i * 10, buf, 10);
+        bitbuffer_extract_bytes(b, 0, 36 + i * 10, buf, 10);
         reflect_bytes(buf, 2);
         current[i] = ((float)buf[0] + ((buf[1] & 0x3) << 8)) * 0.1;
     }
@@ -20,7 +20,7 @@ CurrentCost TX, CurrentCost EnviR current sensors.
 static int current_cost_decode(r_device *decoder, bitbuffer_t *bitbuffer)
 {
     data_t *data;
-    bitbuffer_t packet = {0};
+    bitbuffer_t *packet = decoder_scratch_bitbuffer(0);
     uint8_t *b;
     int is_envir = 0;
     unsigned int start_pos;
@@ -55,13 +55,13 @@ static int current_cost_decode(r_device *decoder, bitbuffer_t *bitbuffer)
         start_pos += 45;
     }
 
-    start_pos = bitbuffer_manchester_decode(bitbuffer, 0, start_pos, &packet, 0);
+    start_pos = bitbuffer_manchester_decode(bitbuffer, 0, start_pos, packet, 0);
 
-    if (packet.bits_per_row[0] < 64) {
+    if (packet->bits_per_row[0] < 64) {
         return DECODE_ABORT_EARLY;
     }
 
-    b = packet.bb[0];
+    b = packet->bb[0];
     // Read data
     // Meter (b[0] = 0000xxxx) bits 5 and 4 are "unknown", but always 0 to date.
     if ((b[0] & 0xf0) == 0) {
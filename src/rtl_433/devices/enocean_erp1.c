@@ -61,22 +61,22 @@ static int enocean_erp1_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     unsigned len = bitbuffer->bits_per_row[0] - start;
     unsigned end = start + len;
 
-    bitbuffer_t bytes = {0};
+    bitbuffer_t *bytes = decoder_scratch_bitbuffer(0);
     uint8_t more      = 0x01;
     do {
-        more = decode_8of12(bitbuffer->bb[0], pos, end, &bytes);
+        more = decode_8of12(bitbuffer->bb[0], pos, end, bytes);
         pos += 12;
     } while (pos < end && more == 0x01);
 
-    if (bytes.bits_per_row[0] < 16)
+    if (bytes->bits_per_row[0] < 16)
         return DECODE_ABORT_LENGTH;
 
-    uint8_t chk = crc8(bytes.bb[0], (bytes.bits_per_row[0] - 1) / 8, 0x07, 0x00);
-    if (chk != bitrow_get_byte(bytes.bb[0], bytes.bits_per_row[0] - 8))
+    uint8_t chk = crc8(bytes->bb[0], (bytes->bits_per_row[0] - 1) / 8, 0x07, 0x00);
+    if (chk != bitrow_get_byte(bytes->bb[0], bytes->bits_per_row[0] - 8))
         return DECODE_FAIL_MIC;
 
     char tstr[256];
-    bitrow_snprint(bytes.bb[0], bytes.bits_per_row[0], tstr, sizeof(tstr));
+    bitrow_snprint(bytes->bb[0], bytes->bits_per_row[0], tstr, sizeof(tstr));
 
     /* clang-format off */
     data_t *data = data_make(
@@ -218,9 +218,9 @@ static int flex_callback(r_device *decoder, bitbuffer_t *bitbuffer)
                 pos += params->preamble_len;
                 // TODO: refactor to bitbuffer_shift_row()
                 unsigned len = bitbuffer->bits_per_row[i] - pos;
-                bitbuffer_t tmp = {0};
-                bitbuffer_extract_bytes(bitbuffer, i, pos, tmp.bb[0], len);
-                memcpy(bitbuffer->bb[i], tmp.bb[0], (len + 7) / 8);
+                bitbuffer_t *tmp = decoder_scratch_bitbuffer(0);
+                bitbuffer_extract_bytes(bitbuffer, i, pos, tmp->bb[0], len);
+                memcpy(bitbuffer->bb[i], tmp->bb[0], (len + 7) / 8);
                 bitbuffer->bits_per_row[i] = len;
             }
         }
@@ -235,10 +235,10 @@ static int flex_callback(r_device *decoder, bitbuffer_t *bitbuffer)
 
         for (i = 0; i < bitbuffer->num_rows; i++) {
             // TODO: refactor to bitbuffer_decode_symbol_row()
-            unsigned len    = bitbuffer->bits_per_row[i];
-            bitbuffer_t tmp = {0};
-            len             = extract_bits_symbols(bitbuffer->bb[i], 0, len, zero, one, sync, tmp.bb[0]);
-            memcpy(bitbuffer->bb[i], tmp.bb[0], len); // safe to write over: can only be shorter
+            unsigned len     = bitbuffer->bits_per_row[i];
+            bitbuffer_t *tmp = decoder_scratch_bitbuffer(0);
+            len              = extract_bits_symbols(bitbuffer->bb[i], 0, len, zero, one, sync, tmp->bb[0]);
+            memcpy(bitbuffer->bb[i], tmp->bb[0], len); // safe to write over: can only be shorter
             bitbuffer->bits_per_row[i] = len;
         }
         // TODO: apply min_bits, max_bits check
@@ -248,9 +248,9 @@ static int flex_callback(r_device *decoder, bitbuffer_t *bitbuffer)
         for (i = 0; i < bitbuffer->num_rows; i++) {
             // TODO: refactor to bitbuffer_decode_uart_row()
             unsigned len = bitbuffer->bits_per_row[i];
-            bitbuffer_t tmp = {0};
-            len = extract_bytes_uart(bitbuffer->bb[i], 0, len, tmp.bb[0]);
-            memcpy(bitbuffer->bb[i], tmp.bb[0], len); // safe to write over: can only be shorter
+            bitbuffer_t *tmp = decoder_scratch_bitbuffer(0);
+            len = extract_bytes_uart(bitbuffer->bb[i], 0, len, tmp->bb[0]);
+            memcpy(bitbuffer->bb[i], tmp->bb[0], len); // safe to write over: can only be shorter
             bitbuffer->bits_per_row[i] = len * 8;
         }
     }
@@ -259,10 +259,10 @@ static int flex_callback(r_device *decoder, bitbuffer_t *bitbuffer)
         for (i = 0; i < bitbuffer->num_rows; i++) {
             // TODO: refactor to bitbuffer_decode_dm_row()
             unsigned len = bitbuffer->bits_per_row[i];
-            bitbuffer_t tmp = {0};
-            bitbuffer_differential_manchester_decode(bitbuffer, i, 0, &tmp, len);
-            len = tmp.bits_per_row[0];
-            memcpy(bitbuffer->bb[i], tmp.bb[0], (len + 7) / 8); // safe to write over: can only be shorter
+            bitbuffer_t *tmp = decoder_scratch_bitbuffer(0);
+            bitbuffer_differential_manchester_decode(bitbuffer, i, 0, tmp, len);
+            len = tmp->bits_per_row[0];
+            memcpy(bitbuffer->bb[i], tmp->bb[0], (len + 7) / 8); // safe to write over: can only be shorter
             bitbuffer->bits_per_row[i] = len;
         }
     }
@@ -61,10 +61,10 @@ static unsigned ge_decode(bitbuffer_t *inbuf, unsigned row, unsigned start, bitb
 static int ge_coloreffects_decode(r_device *decoder, bitbuffer_t *bitbuffer, unsigned row, unsigned start_pos)
 {
     data_t *data;
-    bitbuffer_t packet_bits = {0};
+    bitbuffer_t *packet_bits = decoder_scratch_bitbuffer(0);
 
-    ge_decode(bitbuffer, row, start_pos, &packet_bits);
-    //decoder_log_bitbuffer(decoder, 0, __func__, &packet_bits, "");
+    ge_decode(bitbuffer, row, start_pos, packet_bits);
+    //decoder_log_bitbuffer(decoder, 0, __func__, packet_bits, "");
 
     /* From http://www.deepdarc.com/2010/11/27/hacking-christmas-lights/
      * Decoded frame format is:
@@ -76,10 +76,10 @@ static int ge_coloreffects_decode(r_device *decoder, bitbuffer_t *bitbuffer, uns
      */
 
     // Frame should be 17 decoded bits (not including preamble)
-    if (packet_bits.bits_per_row[0] != 17)
+    if (packet_bits->bits_per_row[0] != 17)
         return DECODE_ABORT_LENGTH;
 
-    uint8_t *b = packet_bits.bb[0];
+    uint8_t *b = packet_bits->bb[0];
 
     // First two bits must be 0
     if (b[0] & 0xc0)
@@ -106,7 +106,7 @@ static int neptune_r900_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     bitbuffer_extract_bytes(bitbuffer, 0, start_pos + preamble_length, bits, 21 * 8);
 
     uint8_t *bb = bitbuffer->bb[0];
-    bitbuffer_t bytes = {0};
+    bitbuffer_t *bytes = decoder_scratch_bitbuffer(0);
     uint8_t base6_dec[21] = {0};
     int count = 0;
 
@@ -136,9 +136,9 @@ static int neptune_r900_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     // convert the base6 integers above into binary bits for decoding data
     // this reduces the 168 bits to 105 bits (104 bits??)
     // the first 80 bits are used in this decoder, the last 24 bits are decoded as extra
-    decode_5to8(&bytes, base6_dec);
+    decode_5to8(bytes, base6_dec);
     uint8_t b[13]; // 104 bits
-    bitbuffer_extract_bytes(&bytes, 0, 0, b, sizeof(b)*8);
+    bitbuffer_extract_bytes(bytes, 0, 0, b, sizeof(b)*8);
 
     // decode the data
 
@@ -37,16 +37,16 @@ static int nexa_callback(r_device *decoder, bitbuffer_t *bitbuffer)
     if (bitbuffer->bits_per_row[0] != 64 && bitbuffer->bits_per_row[0] != 72)
         return DECODE_ABORT_LENGTH;
 
-    bitbuffer_t databits = {0};
+    bitbuffer_t *databits = decoder_scratch_bitbuffer(0);
     // note: not manchester encoded but actually ternary
-    unsigned pos = bitbuffer_manchester_decode(bitbuffer, 0, 0, &databits, 80);
-    bitbuffer_invert(&databits);
+    unsigned pos = bitbuffer_manchester_decode(bitbuffer, 0, 0, databits, 80);
+    bitbuffer_invert(databits);
 
     /* Reject codes when Manchester decoding fails */
     if (pos != 64 && pos != 72)
         return DECODE_ABORT_LENGTH;
 
-    uint8_t *b = databits.bb[0];
+    uint8_t *b = databits->bb[0];
 
     uint32_t id        = (b[0] << 18) | (b[1] << 10) | (b[2] << 2) | (b[3] >> 6); // ID 26 bits
     uint32_t group_cmd = (b[3] >> 5) & 1;
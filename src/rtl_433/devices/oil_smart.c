@@ -57,14 +57,14 @@ Start of frame full preamble is depending on first data bit either
 */
 static int oil_smart_decode(r_device *decoder, bitbuffer_t *bitbuffer, unsigned row, unsigned bitpos)
 {
-    bitbuffer_t databits = {0};
-    bitbuffer_manchester_decode(bitbuffer, row, bitpos, &databits, 64);
+    bitbuffer_t *databits = decoder_scratch_bitbuffer(0);
+    bitbuffer_manchester_decode(bitbuffer, row, bitpos, databits, 64);
 
-    if (databits.bits_per_row[0] < 64) {
+    if (databits->bits_per_row[0] < 64) {
         return 0; // DECODE_ABORT_LENGTH; // TODO: fix calling code to handle negative return values
     }
 
-    uint8_t *b = databits.bb[0];
+    uint8_t *b = databits->bb[0];
 
     if (b[0] != 0x55 || b[1] != 0x58) {
         decoder_log(decoder, 2, __func__, "Couldn't find preamble");
@@ -42,13 +42,13 @@ Start of frame full preamble is depending on first data bit either
 */
 static int oil_standard_decode(r_device *decoder, bitbuffer_t *bitbuffer, unsigned row, unsigned bitpos)
 {
-    bitbuffer_t databits = {0};
-    bitbuffer_manchester_decode(bitbuffer, row, bitpos, &databits, 41);
+    bitbuffer_t *databits = decoder_scratch_bitbuffer(0);
+    bitbuffer_manchester_decode(bitbuffer, row, bitpos, databits, 41);
 
-    if (databits.bits_per_row[0] < 32 || databits.bits_per_row[0] > 40 || (databits.bb[0][4] & 0xfe) != 0)
+    if (databits->bits_per_row[0] < 32 || databits->bits_per_row[0] > 40 || (databits->bb[0][4] & 0xfe) != 0)
         return 0; // TODO: fix calling code to handle negative return values
 
-    uint8_t *b = databits.bb[0];
+    uint8_t *b = databits->bb[0];
 
     // The unit ID changes when you rebind by holding a magnet to the
     // sensor for long enough.
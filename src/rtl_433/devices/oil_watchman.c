@@ -36,12 +36,12 @@ static int oil_watchman_decode(r_device *decoder, bitbuffer_t *bitbuffer)
         // Skip the matched preamble bits to point to the data
         bitpos += 6;
 
-        bitbuffer_t databits = {0};
-        bitpos = bitbuffer_manchester_decode(bitbuffer, 0, bitpos, &databits, 64);
-        if (databits.bits_per_row[0] != 64)
+        bitbuffer_t *databits = decoder_scratch_bitbuffer(0);
+        bitpos = bitbuffer_manchester_decode(bitbuffer, 0, bitpos, databits, 64);
+        if (databits->bits_per_row[0] != 64)
             continue; // DECODE_ABORT_LENGTH
 
-        uint8_t *b = databits.bb[0];
+        uint8_t *b = databits->bb[0];
 
         // Check for postamble, depending on last data bit
         if (bitbuffer_search(bitbuffer, 0, bitpos, &postamble_pattern[b[7] & 1], 2) != bitpos)
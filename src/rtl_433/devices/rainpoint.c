@@ -63,15 +63,15 @@ static int rainpoint_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     }
     start_pos += sizeof (preamble_pattern) * 8 - 2; // keep initial data bit
 
-    bitbuffer_t msg = {0};
-    unsigned len = bitbuffer_manchester_decode(bitbuffer, 0, start_pos, &msg, 12 * 8);
+    bitbuffer_t *msg = decoder_scratch_bitbuffer(0);
+    unsigned len = bitbuffer_manchester_decode(bitbuffer, 0, start_pos, msg, 12 * 8);
     if (len - start_pos != 12 * 2 * 8) {
         decoder_logf(decoder, 2, __func__, "Manchester decode failed, got %u bits", len - start_pos);
         return DECODE_ABORT_LENGTH;
     }
-    bitbuffer_invert(&msg);
+    bitbuffer_invert(msg);
 
-    uint8_t *b = msg.bb[0];
+    uint8_t *b = msg->bb[0];
     reflect_bytes(b, 12);
     decoder_log_bitrow(decoder, 2, __func__, b, 12 * 8, "");
 
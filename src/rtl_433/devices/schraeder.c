@@ -236,15 +236,15 @@ static int schrader_SMD3MA4_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     }
 
     // Check and decode the Manchester bits
-    bitbuffer_t decoded = {0};
+    bitbuffer_t *decoded = decoder_scratch_bitbuffer(0);
     int ret = bitbuffer_manchester_decode(bitbuffer, 0, NUM_BITS_PREAMBLE,
-            &decoded, NUM_BITS_DATA);
+            decoded, NUM_BITS_DATA);
     if (ret != NUM_BITS_TOTAL) {
         decoder_log(decoder, 2, __func__, "invalid Manchester data");
         return DECODE_FAIL_MIC;
     }
-    bitbuffer_invert(&decoded);
-    b = decoded.bb[0];
+    bitbuffer_invert(decoded);
+    b = decoded->bb[0];
 
     // Compute parity
     int parity = xor_bytes(b, 4) ^ (b[4] & 0xe0);
@@ -258,7 +258,7 @@ static int schrader_SMD3MA4_decode(r_device *decoder, bitbuffer_t *bitbuffer)
     int pressure  = ((b[3] & 0x1f) <<  3) | (b[4] >> 5);
     int check     = ((b[4] & 0x18) >> 3);
 
-    decoder_logf_bitbuffer(decoder, 3, __func__, &decoded, "Parity: %d%d Check: %d%d", parity >> 1, parity & 1, check >> 1, check & 1);
+    decoder_logf_bitbuffer(decoder, 3, __func__, decoded, "Parity: %d%d Check: %d%d", parity >> 1, parity & 1, check >> 1, check & 1);
 
     // reject all-zero data
     if (!flags && !serial_id && !pressure) {
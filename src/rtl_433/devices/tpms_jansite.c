@@ -32,7 +32,7 @@ Data layout (nibbles):
 static int tpms_jansite_decode(r_device *decoder, bitbuffer_t *bitbuffer, unsigned row, unsigned bitpos)
 {
     data_t *data;
-    bitbuffer_t packet_bits = {0};
+    bitbuffer_t *packet_bits = decoder_scratch_bitbuffer(0);
     uint8_t *b;
     unsigned id;
     char id_str[7 + 1];
@@ -41,13 +41,13 @@ static int tpms_jansite_decode(r_device *decoder, bitbuffer_t *bitbuffer, unsign
     int temperature;
     char code_str[7 * 2 + 1];
 
-    bitbuffer_manchester_decode(bitbuffer, row, bitpos, &packet_bits, 56);
+    bitbuffer_manchester_decode(bitbuffer, row, bitpos, packet_bits, 56);
 
-    if (packet_bits.bits_per_row[0] < 56) {
+    if (packet_bits->bits_per_row[0] < 56) {
         return DECODE_FAIL_SANITY;
-        // decoder_logf(decoder, 3, __func__, "packet_bits.bits_per_row = %d", packet_bits.bits_per_row[0]);
+        // decoder_logf(decoder, 3, __func__, "packet_bits->bits_per_row = %d", packet_bits->bits_per_row[0]);
     }
-    b = packet_bits.bb[0];
+    b = packet_bits->bb[0];
 
     // TODO: validate checksum
 
@@ -72,14 +72,14 @@ not fit into 8 bits (that is for speeds above 93 kph on my tires).
 
 static int tpms_renault_0435r_decode(r_device *decoder, bitbuffer_t *bitbuffer, unsigned row, unsigned bitpos)
 {
-    bitbuffer_t packet_bits = {0};
+    bitbuffer_t *packet_bits = decoder_scratch_bitbuffer(0);
 
-    bitbuffer_manchester_decode(bitbuffer, row, bitpos, &packet_bits, 160);
+    bitbuffer_manchester_decode(bitbuffer, row, bitpos, packet_bits, 160);
     // require 72 data bits
-    if (packet_bits.bits_per_row[0] < 72) {
+    if (packet_bits->bits_per_row[0] < 72) {
         return DECODE_ABORT_EARLY;
     }
-    uint8_t *b = packet_bits.bb[0];
+    uint8_t *b = packet_bits->bb[0];
 
     // check checksum (checksum8 xor)
     int chk = xor_bytes(b, 9);
@@ -12,30 +12,14 @@
 #include "pulse_analyzer.h"
 #include "pulse_slicer.h"
 #include "util.h"
+#include "fatal.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
 
-#define MAX_HIST_BINS 16
-
-/// Histogram data for single bin
-typedef struct {
-    unsigned count;
-    int sum;
-    int mean;
-    int min;
-    int max;
-} hist_bin_t;
-
-/// Histogram data for all bins
-typedef struct {
-    unsigned bins_count;
-    hist_bin_t bins[MAX_HIST_BINS];
-} histogram_t;
-
 /// Generate a histogram (unsorted)
-static void histogram_sum(histogram_t *hist, int const *data, unsigned len, float tolerance)
+void histogram_sum(histogram_t *hist, int const *data, unsigned len, float tolerance)
 {
     unsigned bin;    // Iterator will be used outside for!
 
@@ -211,15 +195,22 @@ void pulse_analyzer(pulse_data_t *data, int package_type)
 
     double to_ms = 1e3 / data->sample_rate;
     double to_us = 1e6 / data->sample_rate;
-    // Generate pulse period data
+    // Expand the compact widths and generate pulse period data
+    int *pulses = malloc(3 * data->num_pulses * sizeof(int));
+    if (!pulses) {
+        WARN_MALLOC("pulse_analyzer()");
+        return;
+    }
+    int *gaps    = pulses + data->num_pulses;
+    int *periods = gaps + data->num_pulses;
     int pulse_total_period = 0;
-    pulse_data_t pulse_periods = {0};
-    pulse_periods.num_pulses = data->num_pulses;
-    for (unsigned n = 0; n < pulse_periods.num_pulses; ++n) {
-        pulse_periods.pulse[n] = data->pulse[n] + data->gap[n];
-        pulse_total_period += data->pulse[n] + data->gap[n];
+    for (unsigned n = 0; n < data->num_pulses; ++n) {
+        pulses[n]  = pulse_data_pulse(data, n);
+        gaps[n]    = pulse_data_gap(data, n);
+        periods[n] = pulses[n] + gaps[n];
+        pulse_total_period += periods[n];
     }
-    pulse_total_period -= data->gap[pulse_periods.num_pulses - 1];
+    pulse_total_period -= gaps[data->num_pulses - 1];
 
     histogram_t hist_pulses  = {0};
     histogram_t hist_gaps    = {0};
@@ -227,11 +218,12 @@ void pulse_analyzer(pulse_data_t *data, int package_type)
     histogram_t hist_timings = {0};
 
     // Generate statistics
-    histogram_sum(&hist_pulses, data->pulse, data->num_pulses, TOLERANCE);
-    histogram_sum(&hist_gaps, data->gap, data->num_pulses - 1, TOLERANCE);                      // Leave out last gap (end)
-    histogram_sum(&hist_periods, pulse_periods.pulse, pulse_periods.num_pulses - 1, TOLERANCE); // Leave out last gap (end)
-    histogram_sum(&hist_timings, data->pulse, data->num_pulses, TOLERANCE);
-    histogram_sum(&hist_timings, data->gap, data->num_pulses, TOLERANCE);
+    histogram_sum(&hist_pulses, pulses, data->num_pulses, TOLERANCE);
+    histogram_sum(&hist_gaps, gaps, data->num_pulses - 1, TOLERANCE);       // Leave out last gap (end)
+    histogram_sum(&hist_periods, periods, data->num_pulses - 1, TOLERANCE); // Leave out last gap (end)
+    histogram_sum(&hist_timings, pulses, data->num_pulses, TOLERANCE);
+    histogram_sum(&hist_timings, gaps, data->num_pulses, TOLERANCE);
+    free(pulses);
 
     // Fuse overlapping bins
     histogram_fuse_bins(&hist_pulses, TOLERANCE);
@@ -355,8 +347,8 @@ void pulse_analyzer(pulse_data_t *data, int package_type)
                 hexstr_push_word(&hexstr, w < USHRT_MAX ? w : USHRT_MAX);
             }
             for (unsigned i = 0; i < data->num_pulses; ++i) {
-                int p = histogram_find_bin_index(&hist_timings, data->pulse[i]);
-                int g = histogram_find_bin_index(&hist_timings, data->gap[i]);
+                int p = histogram_find_bin_index(&hist_timings, pulse_data_pulse(data, i));
+                int g = histogram_find_bin_index(&hist_timings, pulse_data_gap(data, i));
                 if (p < 0 || g < 0) {
                     fprintf(stderr, "%s: this can't happen\n", __func__);
                     exit(1);
@@ -388,14 +380,14 @@ void pulse_analyzer(pulse_data_t *data, int package_type)
                     hexstr_push_word(hexstr, w < USHRT_MAX ? w : USHRT_MAX);
                 }
                 for (; i < data->num_pulses; ++i) {
-                    int p = histogram_find_bin_index(&hist_timings, data->pulse[i]);
-                    int g = histogram_find_bin_index(&hist_timings, data->gap[i]);
+                    int p = histogram_find_bin_index(&hist_timings, pulse_data_pulse(data, i));
+                    int g = histogram_find_bin_index(&hist_timings, pulse_data_gap(data, i));
                     if (p < 0 || g < 0) {
                         fprintf(stderr, "%s: this can't happen\n", __func__);
                         exit(1);
                     }
                     hexstr_push_byte(hexstr, 0x80 | (p << 4) | g);
-                    if (data->gap[i] >= limit) {
+                    if (pulse_data_gap(data, i) >= limit) {
                         ++i;
                         break;
                     }
@@ -425,7 +417,11 @@ void pulse_analyzer(pulse_data_t *data, int package_type)
     }
 
     // Demodulate (if detected)
-    if (device.modulation) {
+    decode_ctx_t *ctx = device.modulation ? decode_ctx_create() : NULL;
+    if (device.modulation && !ctx) {
+        WARN_MALLOC("pulse_analyzer()");
+    }
+    else if (device.modulation) {
         fprintf(stderr, "Attempting demodulation... short_width: %.0f, long_width: %.0f, reset_limit: %.0f, sync_width: %.0f\n",
                 device.short_width, device.long_width,
                 device.reset_limit, device.sync_width);
@@ -433,39 +429,40 @@ void pulse_analyzer(pulse_data_t *data, int package_type)
         case FSK_PULSE_PCM:
             fprintf(stderr, "Use a flex decoder with -X 'n=name,m=FSK_PCM,s=%.0f,l=%.0f,r=%.0f'\n",
                     device.short_width, device.long_width, device.reset_limit);
-            pulse_slicer_pcm(data, &device);
+            pulse_slicer_pcm(ctx, data, &device);
             break;
         case OOK_PULSE_PPM:
             fprintf(stderr, "Use a flex decoder with -X 'n=name,m=OOK_PPM,s=%.0f,l=%.0f,g=%.0f,r=%.0f'\n",
                     device.short_width, device.long_width,
                     device.gap_limit, device.reset_limit);
-            data->gap[data->num_pulses - 1] = device.reset_limit / to_us + 1; // Be sure to terminate package
-            pulse_slicer_ppm(data, &device);
+            pulse_data_set_gap(data, data->num_pulses - 1, device.reset_limit / to_us + 1); // Be sure to terminate package
+            pulse_slicer_ppm(ctx, data, &device);
             break;
         case OOK_PULSE_PWM:
             fprintf(stderr, "Use a flex decoder with -X 'n=name,m=OOK_PWM,s=%.0f,l=%.0f,r=%.0f,g=%.0f,t=%.0f,y=%.0f'\n",
                     device.short_width, device.long_width, device.reset_limit,
                     device.gap_limit, device.tolerance, device.sync_width);
-            data->gap[data->num_pulses - 1] = device.reset_limit / to_us + 1; // Be sure to terminate package
-            pulse_slicer_pwm(data, &device);
+            pulse_data_set_gap(data, data->num_pulses - 1, device.reset_limit / to_us + 1); // Be sure to terminate package
+            pulse_slicer_pwm(ctx, data, &device);
             break;
         case FSK_PULSE_PWM:
             fprintf(stderr, "Use a flex decoder with -X 'n=name,m=FSK_PWM,s=%.0f,l=%.0f,r=%.0f,g=%.0f,t=%.0f,y=%.0f'\n",
                     device.short_width, device.long_width, device.reset_limit,
                     device.gap_limit, device.tolerance, device.sync_width);
-            data->gap[data->num_pulses - 1] = device.reset_limit / to_us + 1; // Be sure to terminate package
-            pulse_slicer_pwm(data, &device);
+            pulse_data_set_gap(data, data->num_pulses - 1, device.reset_limit / to_us + 1); // Be sure to terminate package
+            pulse_slicer_pwm(ctx, data, &device);
             break;
         case OOK_PULSE_MANCHESTER_ZEROBIT:
             fprintf(stderr, "Use a flex decoder with -X 'n=name,m=OOK_MC_ZEROBIT,s=%.0f,l=%.0f,r=%.0f'\n",
                     device.short_width, device.long_width, device.reset_limit);
-            data->gap[data->num_pulses - 1] = device.reset_limit / to_us + 1; // Be sure to terminate package
-            pulse_slicer_manchester_zerobit(data, &device);
+            pulse_data_set_gap(data, data->num_pulses - 1, device.reset_limit / to_us + 1); // Be sure to terminate package
+            pulse_slicer_manchester_zerobit(ctx, data, &device);
             break;
         default:
             fprintf(stderr, "Unsupported\n");
         }
     }
+    decode_ctx_free(ctx);
 
     fprintf(stderr, "\n");
 }
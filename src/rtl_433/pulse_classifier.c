@@ -0,0 +1,121 @@
+/** @file
+    Pulse train pre-classifier, prunes decoders before slicing.
+
+    A train is reduced to histograms of its pulse and gap widths once, then
+    each decoder is only sliced if a width the modulation relies on appears
+    in the train. Bins keep their min / max, so a match on the bin range is
+    conservative: a decoder is never skipped if a single width fits.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "pulse_classifier.h"
+#include <string.h>
+
+#define FINGERPRINT_BINNING (0.2f) // same binning tolerance as the pulse analyzer
+#define FINGERPRINT_CHUNK   64     // widths expanded per histogram_sum call
+
+int pulse_classifier_enabled = 1;
+
+/// Add the pulse or gap widths of a train to a histogram, returns the number of widths counted
+static unsigned fingerprint_sum(histogram_t *hist, pulse_data_t const *data, int gaps)
+{
+    int widths[FINGERPRINT_CHUNK];
+    unsigned len = 0;
+
+    for (unsigned n = 0; n < data->num_pulses; ++n) {
+        widths[len++] = gaps ? pulse_data_gap(data, n) : pulse_data_pulse(data, n);
+        if (len == FINGERPRINT_CHUNK || n == data->num_pulses - 1) {
+            histogram_sum(hist, widths, len, FINGERPRINT_BINNING);
+            len = 0;
+        }
+    }
+
+    unsigned counted = 0;
+    for (unsigned bin = 0; bin < hist->bins_count; ++bin) {
+        counted += hist->bins[bin].count;
+    }
+    return counted;
+}
+
+void pulse_fingerprint(pulse_fingerprint_t *fp, pulse_classifier_stats_t *stats, pulse_data_t const *data)
+{
+    memset(fp, 0, sizeof(*fp));
+    fp->samples_per_us = data->sample_rate / 1.0e6;
+    fp->complete = fingerprint_sum(&fp->pulses, data, 0) == data->num_pulses
+            && fingerprint_sum(&fp->gaps, data, 1) == data->num_pulses;
+
+    stats->trains++;
+    if (!fp->complete) {
+        stats->unclassified++;
+    }
+}
+
+/// Check for a histogram bin overlapping [lo, hi]
+static int hist_has(histogram_t const *hist, int lo, int hi)
+{
+    for (unsigned bin = 0; bin < hist->bins_count; ++bin) {
+        if (hist->bins[bin].max >= lo && hist->bins[bin].min <= hi) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int pulse_fingerprint_match(pulse_fingerprint_t const *fp, r_device const *r_dev)
+{
+#ifdef RTL_ANALYZE
+    if (r_dev->protocol_num == RTL_ANALYZE) {
+        return 1; // always slice the decoder being analyzed
+    }
+#endif
+    if (!fp->complete) {
+        return 1;
+    }
+
+    int s_short = r_dev->short_width * fp->samples_per_us;
+    int s_long  = r_dev->long_width * fp->samples_per_us;
+    int s_tolerance = r_dev->tolerance * fp->samples_per_us;
+    // without a decoder tolerance the slicers split at the midpoints, allow a wide window
+    int t_short = s_tolerance > 0 ? s_tolerance : s_short * PULSE_CLASSIFIER_TOLERANCE;
+    int t_long  = s_tolerance > 0 ? s_tolerance : s_long * PULSE_CLASSIFIER_TOLERANCE;
+
+    histogram_t const *pulses = &fp->pulses;
+    histogram_t const *gaps   = &fp->gaps;
+
+    switch (r_dev->modulation) {
+    case OOK_PULSE_PCM:
+    case FSK_PULSE_PCM:
+        if (s_short != s_long) {
+            // RZ, every pulse off the nominal pulse width clears the bits
+            return hist_has(pulses, s_short - t_short, s_short + t_short);
+        }
+        // NRZ, some run of one or two bits is needed to sync on
+        return hist_has(pulses, s_short - t_short, 2 * s_short + t_short)
+                || hist_has(gaps, s_short - t_short, 2 * s_short + t_short);
+    case OOK_PULSE_PPM:
+        return hist_has(gaps, s_short - t_short, s_short + t_short)
+                || hist_has(gaps, s_long - t_long, s_long + t_long);
+    case OOK_PULSE_PWM:
+    case FSK_PULSE_PWM:
+        return hist_has(pulses, s_short - t_short, s_short + t_short)
+                || hist_has(pulses, s_long - t_long, s_long + t_long);
+    case OOK_PULSE_MANCHESTER_ZEROBIT:
+    case FSK_PULSE_MANCHESTER_ZEROBIT:
+        // half and full bit periods
+        return hist_has(pulses, s_short - t_short, 2 * s_short + t_short)
+                || hist_has(gaps, s_short - t_short, 2 * s_short + t_short);
+    case OOK_PULSE_DMC:
+    case OOK_PULSE_PIWM_DC:
+        return hist_has(pulses, s_short - t_short, s_short + t_short)
+                || hist_has(gaps, s_short - t_short, s_short + t_short)
+                || hist_has(pulses, s_long - t_long, s_long + t_long)
+                || hist_has(gaps, s_long - t_long, s_long + t_long);
+    default:
+        // PIWM_RAW, NRZS and OSV1 have no fixed symbol set to check
+        return 1;
+    }
+}
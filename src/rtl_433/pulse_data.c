@@ -17,16 +17,70 @@
 #include <stdlib.h>
 #include <string.h>
 
+size_t pulse_data_storage_size(unsigned capacity)
+{
+    size_t size = 2 * capacity * sizeof(uint16_t);
+#ifdef SIGNAL_RSSI
+    size += capacity * sizeof(int8_t);
+#endif
+    return size;
+}
+
+void pulse_data_attach(pulse_data_t *data, void *storage, unsigned capacity)
+{
+    data->capacity = capacity;
+    data->pulse    = (uint16_t *)storage;
+    data->gap      = data->pulse + capacity;
+#ifdef SIGNAL_RSSI
+    data->rssi = (int8_t *)(data->gap + capacity);
+#endif
+}
+
+pulse_data_t *pulse_data_alloc(unsigned capacity)
+{
+    pulse_data_t *data = calloc(1, sizeof(pulse_data_t) + pulse_data_storage_size(capacity));
+    if (data) {
+        pulse_data_attach(data, data + 1, capacity);
+    }
+    return data;
+}
+
+int pulse_data_long_width(pulse_data_t const *data, unsigned entry)
+{
+    for (unsigned i = 0; i < data->num_long; ++i) {
+        if (data->long_index[i] == entry)
+            return data->long_width[i];
+    }
+    return PD_DURATION_ESCAPE;
+}
+
 void pulse_data_clear(pulse_data_t *data)
 {
-    *data = (pulse_data_t const){0};
+    // keep the attached storage, the widths are only valid up to num_pulses
+    pulse_data_t cleared = {0};
+    cleared.capacity = data->capacity;
+    cleared.pulse    = data->pulse;
+    cleared.gap      = data->gap;
+#ifdef SIGNAL_RSSI
+    cleared.rssi = data->rssi;
+#endif
+    *data = cleared;
 }
 
 void pulse_data_shift(pulse_data_t *data)
 {
-    int offs = PD_MAX_PULSES / 2; // shift out half the data
-    memmove(data->pulse, &data->pulse[offs], (PD_MAX_PULSES - offs) * sizeof(*data->pulse));
-    memmove(data->gap, &data->gap[offs], (PD_MAX_PULSES - offs) * sizeof(*data->gap));
+    int offs = data->capacity / 2; // shift out half the data
+    memmove(data->pulse, &data->pulse[offs], (data->capacity - offs) * sizeof(*data->pulse));
+    memmove(data->gap, &data->gap[offs], (data->capacity - offs) * sizeof(*data->gap));
+    // re-index escaped widths, dropping those shifted out
+    unsigned kept = 0;
+    for (unsigned i = 0; i < data->num_long; ++i) {
+        if (data->long_index[i] >= 2 * offs) {
+            data->long_index[kept]   = data->long_index[i] - 2 * offs;
+            data->long_width[kept++] = data->long_width[i];
+        }
+    }
+    data->num_long = kept;
     data->num_pulses -= offs;
     data->offset += offs;
 }
@@ -35,7 +89,9 @@ void pulse_data_print(pulse_data_t const *data)
 {
     fprintf(stderr, "Pulse data: %u pulses\n", data->num_pulses);
     for (unsigned n = 0; n < data->num_pulses; ++n) {
-        fprintf(stderr, "[%3u] Pulse: %4d, Gap: %4d, Period: %4d\n", n, data->pulse[n], data->gap[n], data->pulse[n] + data->gap[n]);
+        int pulse = pulse_data_pulse(data, n);
+        int gap   = pulse_data_gap(data, n);
+        fprintf(stderr, "[%3u] Pulse: %4d, Gap: %4d, Period: %4d\n", n, pulse, gap, pulse + gap);
     }
 }
 
@@ -57,10 +113,10 @@ void pulse_data_dump_raw(uint8_t *buf, unsigned len, uint64_t buf_offset, pulse_
 {
     int64_t pos = data->offset - buf_offset;
     for (unsigned n = 0; n < data->num_pulses; ++n) {
-        bounded_memset(buf, 0x01 | bits, len, pos, data->pulse[n]);
-        pos += data->pulse[n];
-        bounded_memset(buf, 0x01, len, pos, data->gap[n]);
-        pos += data->gap[n];
+        bounded_memset(buf, 0x01 | bits, len, pos, pulse_data_pulse(data, n));
+        pos += pulse_data_pulse(data, n);
+        bounded_memset(buf, 0x01, len, pos, pulse_data_gap(data, n));
+        pos += pulse_data_gap(data, n);
     }
 }
 
@@ -106,9 +162,9 @@ void pulse_data_print_vcd(FILE *file, pulse_data_t const *data, int ch_id)
             chk_ret(fprintf(file, "#%.f 1/ 1%c\n", pos * scale, ch_id));
         else
             chk_ret(fprintf(file, "#%.f 1%c\n", pos * scale, ch_id));
-        pos += data->pulse[n];
+        pos += pulse_data_pulse(data, n);
         chk_ret(fprintf(file, "#%.f 0%c\n", pos * scale, ch_id));
-        pos += data->gap[n];
+        pos += pulse_data_gap(data, n);
     }
     if (data->num_pulses > 0)
         chk_ret(fprintf(file, "#%.f 0/\n", pos * scale));
@@ -118,7 +174,7 @@ void pulse_data_load(FILE *file, pulse_data_t *data, uint32_t sample_rate)
 {
     char s[1024];
     int i    = 0;
-    int size = sizeof(data->pulse) / sizeof(*data->pulse);
+    int size = data->capacity;
 
     pulse_data_clear(data);
     data->sample_rate = sample_rate;
@@ -152,8 +208,8 @@ void pulse_data_load(FILE *file, pulse_data_t *data, uint32_t sample_rate)
         p          = endptr + 1;
         long space = strtol(p, &endptr, 10);
         // fprintf(stderr, "read: mark %ld space %ld\n", mark, space);
-        data->pulse[i] = (int)(to_sample * mark);
-        data->gap[i++] = (int)(to_sample * space);
+        pulse_data_set_pulse(data, i, (unsigned)(to_sample * mark));
+        pulse_data_set_gap(data, i++, (unsigned)(to_sample * space));
     }
     // fprintf(stderr, "read %d pulses\n", i);
     data->num_pulses = i;
@@ -194,7 +250,7 @@ void pulse_data_dump(FILE *file, pulse_data_t const *data)
 
     double to_us = 1e6 / data->sample_rate;
     for (unsigned i = 0; i < data->num_pulses; ++i) {
-        chk_ret(fprintf(file, "%.0f %.0f\n", data->pulse[i] * to_us, data->gap[i] * to_us));
+        chk_ret(fprintf(file, "%.0f %.0f\n", pulse_data_pulse(data, i) * to_us, pulse_data_gap(data, i) * to_us));
     }
     chk_ret(fprintf(file, ";end\n"));
 }
@@ -204,8 +260,8 @@ data_t *pulse_data_print_data(pulse_data_t const *data)
     int pulses[2 * PD_MAX_PULSES];
     double to_us = 1e6 / data->sample_rate;
     for (unsigned i = 0; i < data->num_pulses; ++i) {
-        pulses[i * 2 + 0] = data->pulse[i] * to_us;
-        pulses[i * 2 + 1] = data->gap[i] * to_us;
+        pulses[i * 2 + 0] = pulse_data_pulse(data, i) * to_us;
+        pulses[i * 2 + 1] = pulse_data_gap(data, i) * to_us;
     }
 
     /* clang-format off */
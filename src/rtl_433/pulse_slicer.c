@@ -21,13 +21,13 @@
 
 #include "bitbuffer.h"
 #include "decoder_util.h" // TODO: this should be refactored
+#include "fatal.h"
 #include "logger.h"
 #include "pulse_data.h"
 #include "util.h"
 
-bitbuffer_t bits = {0};
 
-static int account_event(r_device* device, bitbuffer_t* bits, char const* demod_name) {
+static int account_decoder_event(r_device* device, bitbuffer_t* bits, char const* demod_name) {
   // run decoder
   int ret = 0;
   if (device->decode_fn) {
@@ -62,7 +62,54 @@ static int account_event(r_device* device, bitbuffer_t* bits, char const* demod_
   return ret;
 }
 
-int pulse_slicer_pcm(pulse_data_t const* pulses, r_device* device) {
+/// Run the decoders of the slicing group starting at device on the sliced bits
+static int account_event(decode_ctx_t* ctx, r_device* device, bitbuffer_t* bits, char const* demod_name) {
+  int ret = 0;
+  // decoders borrow their scratch bitbuffers from ctx
+  decode_ctx_t* previous = decode_ctx_use(ctx);
+  // decoders may modify the bits, all but the last decoder of a group get a copy
+  // of its rows in use only, the copy is cleared past them
+  if (device->slice_next) {
+    if (!ctx->slice_bits) {
+      ctx->slice_bits = calloc(1, sizeof(*ctx->slice_bits));
+      if (!ctx->slice_bits)
+        FATAL_CALLOC("account_event()");
+    }
+    bitbuffer_copy_used(ctx->slice_bits, bits);
+  }
+  for (; device->slice_next; device = device->slice_next) {
+    ret += account_decoder_event(device, ctx->slice_bits, demod_name);
+    // copied again after each decoder, also restoring the bytes of rows it shortened
+    bitbuffer_copy_used(ctx->slice_bits, bits);
+  }
+  ret += account_decoder_event(device, bits, demod_name);
+  decode_ctx_use(previous);
+  return ret;
+}
+
+/// Bits sliced a pulse at a time, added to the bitbuffer a word at a time
+typedef struct {
+  uint32_t word;
+  unsigned count;
+} pending_bits_t;
+
+static inline void pending_add_bit(bitbuffer_t* bits, pending_bits_t* pending, int bit) {
+  pending->word = pending->word << 1 | bit;
+  if (++pending->count == 32) {
+    bitbuffer_add_bits_word(bits, pending->word, 32);
+    pending->count = 0;
+  }
+}
+
+/// Add the pending bits, before the bitbuffer is read or gets a new row
+static inline void pending_flush(bitbuffer_t* bits, pending_bits_t* pending) {
+  if (pending->count) {
+    bitbuffer_add_bits_word(bits, pending->word, pending->count);
+    pending->count = 0;
+  }
+}
+
+int pulse_slicer_pcm(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
   int s_short = device->short_width * samples_per_us;
   int s_long = device->long_width * samples_per_us;
@@ -82,8 +129,8 @@ int pulse_slicer_pcm(pulse_data_t const* pulses, r_device* device) {
   float f_long = device->long_width > 0.0 ? 1.0 / (device->long_width * samples_per_us) : 0;
 
   int events = 0;
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
 
   int const gap_limit = s_gap ? s_gap : s_reset;
   int const max_zeros = gap_limit / s_long;
@@ -96,9 +143,9 @@ int pulse_slicer_pcm(pulse_data_t const* pulses, r_device* device) {
     int swidth = 0;
     int lwidth = 0;
     int count = 0;
-    while (n < pulses->num_pulses && pulses->pulse[n] >= s_short - s_tolerance && pulses->pulse[n] <= s_short + s_tolerance && pulses->pulse[n] + pulses->gap[n] >= s_long - s_tolerance && pulses->pulse[n] + pulses->gap[n] <= s_long + s_tolerance) {
-      swidth += pulses->pulse[n];
-      lwidth += pulses->pulse[n] + pulses->gap[n];
+    while (n < pulses->num_pulses && pulse_data_pulse(pulses, n) >= s_short - s_tolerance && pulse_data_pulse(pulses, n) <= s_short + s_tolerance && pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n) >= s_long - s_tolerance && pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n) <= s_long + s_tolerance) {
+      swidth += pulse_data_pulse(pulses, n);
+      lwidth += pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n);
       count += 1;
       n++;
     }
@@ -121,9 +168,9 @@ int pulse_slicer_pcm(pulse_data_t const* pulses, r_device* device) {
   int rzl_width = 0;
   int rz_count = 0;
   for (unsigned n = 0; preamble_len == 0 && s_short != s_long && n < pulses->num_pulses; ++n) {
-    if (pulses->pulse[n] >= s_short - s_tolerance && pulses->pulse[n] <= s_short + s_tolerance && pulses->pulse[n] + pulses->gap[n] >= s_long - s_tolerance && pulses->pulse[n] + pulses->gap[n] <= s_long + s_tolerance) {
-      rzs_width += pulses->pulse[n];
-      rzl_width += pulses->pulse[n] + pulses->gap[n];
+    if (pulse_data_pulse(pulses, n) >= s_short - s_tolerance && pulse_data_pulse(pulses, n) <= s_short + s_tolerance && pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n) >= s_long - s_tolerance && pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n) <= s_long + s_tolerance) {
+      rzs_width += pulse_data_pulse(pulses, n);
+      rzl_width += pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n);
       rz_count += 1;
     }
   }
@@ -142,8 +189,8 @@ int pulse_slicer_pcm(pulse_data_t const* pulses, r_device* device) {
   for (unsigned n = 0; s_short == s_long && n < pulses->num_pulses; ++n) {
     int width = 0;
     int count = 0;
-    while (n < pulses->num_pulses && (int)(pulses->pulse[n] * f_short + 0.5) == 1 && (int)(pulses->gap[n] * f_long + 0.5) == 1) {
-      width += pulses->pulse[n] + pulses->gap[n];
+    while (n < pulses->num_pulses && (int)(pulse_data_pulse(pulses, n) * f_short + 0.5) == 1 && (int)(pulse_data_gap(pulses, n) * f_long + 0.5) == 1) {
+      width += pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n);
       count += 2;
       n++;
     }
@@ -163,20 +210,20 @@ int pulse_slicer_pcm(pulse_data_t const* pulses, r_device* device) {
   int nrz_width = 0;
   int nrz_count = 0;
   for (unsigned n = 0; preamble_len == 0 && s_short == s_long && n < pulses->num_pulses; ++n) {
-    if (pulses->pulse[n] >= s_short - s_tolerance && pulses->pulse[n] <= s_short + s_tolerance) {
-      nrz_width += pulses->pulse[n];
+    if (pulse_data_pulse(pulses, n) >= s_short - s_tolerance && pulse_data_pulse(pulses, n) <= s_short + s_tolerance) {
+      nrz_width += pulse_data_pulse(pulses, n);
       nrz_count += 1;
     }
-    if (pulses->pulse[n] >= 2 * s_short - s_tolerance && pulses->pulse[n] <= 2 * s_short + s_tolerance) {
-      nrz_width += pulses->pulse[n];
+    if (pulse_data_pulse(pulses, n) >= 2 * s_short - s_tolerance && pulse_data_pulse(pulses, n) <= 2 * s_short + s_tolerance) {
+      nrz_width += pulse_data_pulse(pulses, n);
       nrz_count += 2;
     }
-    if (pulses->gap[n] >= s_long - s_tolerance && pulses->gap[n] <= s_long + s_tolerance) {
-      nrz_width += pulses->gap[n];
+    if (pulse_data_gap(pulses, n) >= s_long - s_tolerance && pulse_data_gap(pulses, n) <= s_long + s_tolerance) {
+      nrz_width += pulse_data_gap(pulses, n);
       nrz_count += 1;
     }
-    if (pulses->gap[n] >= 2 * s_long - s_tolerance && pulses->gap[n] <= 2 * s_long + s_tolerance) {
-      nrz_width += pulses->gap[n];
+    if (pulse_data_gap(pulses, n) >= 2 * s_long - s_tolerance && pulse_data_gap(pulses, n) <= 2 * s_long + s_tolerance) {
+      nrz_width += pulse_data_gap(pulses, n);
       nrz_count += 2;
     }
   }
@@ -192,51 +239,51 @@ int pulse_slicer_pcm(pulse_data_t const* pulses, r_device* device) {
 
   for (unsigned n = 0; n < pulses->num_pulses; ++n) {
     // Determine number of high bit periods for NRZ coding, where bits may not be separated
-    int highs = (pulses->pulse[n]) * f_short + 0.5;
+    int highs = (pulse_data_pulse(pulses, n)) * f_short + 0.5;
     // Determine number of low bit periods in current gap length (rounded)
     // for RZ subtract the nominal bit-gap
-    int lows = (pulses->gap[n] + s_short - s_long) * f_long + 0.5;
+    int lows = (pulse_data_gap(pulses, n) + s_short - s_long) * f_long + 0.5;
 
     // Add run of ones (1 for RZ, many for NRZ)
-    for (int i = 0; i < highs; ++i) {
-      bitbuffer_add_bit(&bits, 1);
+    if (highs > 0) {
+      bitbuffer_add_bits_run(bits, 1, highs);
     }
     // Add run of zeros, handle possibly negative "lows" gracefully
     lows = MIN(lows, max_zeros); // Don't overflow at end of message
-    for (int i = 0; i < lows; ++i) {
-      bitbuffer_add_bit(&bits, 0);
+    if (lows > 0) {
+      bitbuffer_add_bits_run(bits, 0, lows);
     }
 
     // Validate data
     if ((s_short != s_long) // Only for RZ coding
-        && (abs(pulses->pulse[n] - s_short) > s_tolerance)) { // Pulse must be within tolerance
+        && (abs(pulse_data_pulse(pulses, n) - s_short) > s_tolerance)) { // Pulse must be within tolerance
 
       // Data is corrupt
       if (device->verbose > 3) {
         print_logf(LOG_TRACE, __func__, "bitbuffer cleared at %u: pulse %d, gap %d, period %d",
-                   n, pulses->pulse[n], pulses->gap[n],
-                   pulses->pulse[n] + pulses->gap[n]);
+                   n, pulse_data_pulse(pulses, n), pulse_data_gap(pulses, n),
+                   pulse_data_pulse(pulses, n) + pulse_data_gap(pulses, n));
       }
-      bitbuffer_clear(&bits);
+      bitbuffer_clear(bits);
     }
 
     // Check for new packet in multipacket
-    else if (pulses->gap[n] > gap_limit && pulses->gap[n] <= s_reset) {
-      bitbuffer_add_row(&bits);
+    else if (pulse_data_gap(pulses, n) > gap_limit && pulse_data_gap(pulses, n) <= s_reset) {
+      bitbuffer_add_row(bits);
     }
     // End of Message?
     if (((n == pulses->num_pulses - 1) // No more pulses? (FSK)
-         || (pulses->gap[n] > s_reset)) // Long silence (OOK)
-        && (bits.bits_per_row[0] > 0 || bits.num_rows > 1)) { // Only if data has been accumulated
+         || (pulse_data_gap(pulses, n) > s_reset)) // Long silence (OOK)
+        && (bits->bits_per_row[0] > 0 || bits->num_rows > 1)) { // Only if data has been accumulated
 
-      events += account_event(device, &bits, __func__);
-      bitbuffer_clear(&bits);
+      events += account_event(ctx, device, bits, __func__);
+      bitbuffer_clear(bits);
     }
   } // for
   return events;
 }
 
-int pulse_slicer_ppm(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_ppm(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -253,8 +300,8 @@ int pulse_slicer_ppm(pulse_data_t const* pulses, r_device* device) {
   }
 
   int events = 0;
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
 
   // lower and upper bounds (non inclusive)
   int zero_l, zero_u;
@@ -279,35 +326,39 @@ int pulse_slicer_ppm(pulse_data_t const* pulses, r_device* device) {
     one_u = s_gap ? s_gap : s_reset;
   }
 
+  pending_bits_t pending = {0, 0};
   for (unsigned n = 0; n < pulses->num_pulses; ++n) {
-    if (pulses->gap[n] > zero_l && pulses->gap[n] < zero_u) {
+    if (pulse_data_gap(pulses, n) > zero_l && pulse_data_gap(pulses, n) < zero_u) {
       // Short gap
-      bitbuffer_add_bit(&bits, 0);
-    } else if (pulses->gap[n] > one_l && pulses->gap[n] < one_u) {
+      pending_add_bit(bits, &pending, 0);
+    } else if (pulse_data_gap(pulses, n) > one_l && pulse_data_gap(pulses, n) < one_u) {
       // Long gap
-      bitbuffer_add_bit(&bits, 1);
-    } else if (pulses->gap[n] > sync_l && pulses->gap[n] < sync_u) {
+      pending_add_bit(bits, &pending, 1);
+    } else if (pulse_data_gap(pulses, n) > sync_l && pulse_data_gap(pulses, n) < sync_u) {
       // Sync gap
-      bitbuffer_add_sync(&bits);
+      pending_flush(bits, &pending);
+      bitbuffer_add_sync(bits);
     }
 
     // Check for new packet in multipacket
-    else if (pulses->gap[n] < s_reset) {
-      bitbuffer_add_row(&bits);
+    else if (pulse_data_gap(pulses, n) < s_reset) {
+      pending_flush(bits, &pending);
+      bitbuffer_add_row(bits);
     }
     // End of Message?
     if (((n == pulses->num_pulses - 1) // No more pulses? (FSK)
-         || (pulses->gap[n] >= s_reset)) // Long silence (OOK)
-        && (bits.bits_per_row[0] > 0 || bits.num_rows > 1)) { // Only if data has been accumulated
+         || (pulse_data_gap(pulses, n) >= s_reset)) // Long silence (OOK)
+        && (pending.count || bits->bits_per_row[0] > 0 || bits->num_rows > 1)) { // Only if data has been accumulated
 
-      events += account_event(device, &bits, __func__);
-      bitbuffer_clear(&bits);
+      pending_flush(bits, &pending);
+      events += account_event(ctx, device, bits, __func__);
+      bitbuffer_clear(bits);
     }
   } // for pulses
   return events;
 }
 
-int pulse_slicer_pwm(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_pwm(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -327,8 +378,8 @@ int pulse_slicer_pwm(pulse_data_t const* pulses, r_device* device) {
   }
 
   int events = 0;
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
 
   // lower and upper bounds (non inclusive)
   int one_l, one_u;
@@ -377,38 +428,44 @@ int pulse_slicer_pwm(pulse_data_t const* pulses, r_device* device) {
     sync_u = INT_MAX;
   }
 
+  pending_bits_t pending = {0, 0};
   for (unsigned n = 0; n < pulses->num_pulses; ++n) {
-    if (pulses->pulse[n] > one_l && pulses->pulse[n] < one_u) {
+    if (pulse_data_pulse(pulses, n) > one_l && pulse_data_pulse(pulses, n) < one_u) {
       // 'Short' 1 pulse
-      bitbuffer_add_bit(&bits, 1);
-    } else if (pulses->pulse[n] > zero_l && pulses->pulse[n] < zero_u) {
+      pending_add_bit(bits, &pending, 1);
+    } else if (pulse_data_pulse(pulses, n) > zero_l && pulse_data_pulse(pulses, n) < zero_u) {
       // 'Long' 0 pulse
-      bitbuffer_add_bit(&bits, 0);
-    } else if (pulses->pulse[n] > sync_l && pulses->pulse[n] < sync_u) {
+      pending_add_bit(bits, &pending, 0);
+    } else if (pulse_data_pulse(pulses, n) > sync_l && pulse_data_pulse(pulses, n) < sync_u) {
       // Sync pulse
-      bitbuffer_add_sync(&bits);
-    } else if (pulses->pulse[n] <= one_l) {
+      pending_flush(bits, &pending);
+      bitbuffer_add_sync(bits);
+    } else if (pulse_data_pulse(pulses, n) <= one_l) {
       // Ignore spurious short pulses
     } else {
       // Pulse outside specified timing
-      bitbuffer_add_row(&bits);
+      pending_flush(bits, &pending);
+      bitbuffer_add_row(bits);
     }
 
     // End of Message?
     if (((n == pulses->num_pulses - 1) // No more pulses? (FSK)
-         || (pulses->gap[n] > s_reset)) // Long silence (OOK)
-        && (bits.num_rows > 0)) { // Only if data has been accumulated
-      events += account_event(device, &bits, __func__);
-      bitbuffer_clear(&bits);
-    } else if (s_gap > 0 && pulses->gap[n] > s_gap && bits.num_rows > 0 && bits.bits_per_row[bits.num_rows - 1] > 0) {
+         || (pulse_data_gap(pulses, n) > s_reset)) // Long silence (OOK)
+        && (pending.count || bits->num_rows > 0)) { // Only if data has been accumulated
+      pending_flush(bits, &pending);
+      events += account_event(ctx, device, bits, __func__);
+      bitbuffer_clear(bits);
+    } else if (s_gap > 0 && pulse_data_gap(pulses, n) > s_gap
+               && (pending.count || (bits->num_rows > 0 && bits->bits_per_row[bits->num_rows - 1] > 0))) {
       // New packet in multipacket
-      bitbuffer_add_row(&bits);
+      pending_flush(bits, &pending);
+      bitbuffer_add_row(bits);
     }
   }
   return events;
 }
 
-int pulse_slicer_manchester_zerobit(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_manchester_zerobit(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -426,50 +483,54 @@ int pulse_slicer_manchester_zerobit(pulse_data_t const* pulses, r_device* device
 
   int events = 0;
   int time_since_last = 0;
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
 
   // First rising edge is always counted as a zero (Seems to be hardcoded policy for the Oregon Scientific sensors...)
-  bitbuffer_add_bit(&bits, 0);
+  bitbuffer_add_bit(bits, 0);
 
+  // num_rows is never 0, the bits are flushed before new rows and events
+  pending_bits_t pending = {0, 0};
   for (unsigned n = 0; n < pulses->num_pulses; ++n) {
     // The pulse or gap is too long or too short, thus invalid
-    if (s_tolerance > 0 && (pulses->pulse[n] < s_short - s_tolerance || pulses->pulse[n] > s_short * 2 + s_tolerance || pulses->gap[n] < s_short - s_tolerance || pulses->gap[n] > s_short * 2 + s_tolerance)) {
-      if (pulses->pulse[n] > s_short * 1.5 && pulses->pulse[n] <= s_short * 2 + s_tolerance) {
+    if (s_tolerance > 0 && (pulse_data_pulse(pulses, n) < s_short - s_tolerance || pulse_data_pulse(pulses, n) > s_short * 2 + s_tolerance || pulse_data_gap(pulses, n) < s_short - s_tolerance || pulse_data_gap(pulses, n) > s_short * 2 + s_tolerance)) {
+      if (pulse_data_pulse(pulses, n) > s_short * 1.5 && pulse_data_pulse(pulses, n) <= s_short * 2 + s_tolerance) {
         // Long last pulse means with the gap this is a [1]10 transition, add a one
-        bitbuffer_add_bit(&bits, 1);
+        pending_add_bit(bits, &pending, 1);
       }
-      bitbuffer_add_row(&bits);
-      bitbuffer_add_bit(&bits, 0); // Prepare for new message with hardcoded 0
+      pending_flush(bits, &pending);
+      bitbuffer_add_row(bits);
+      bitbuffer_add_bit(bits, 0); // Prepare for new message with hardcoded 0
       time_since_last = 0;
     }
     // Falling edge is on end of pulse
-    else if (pulses->pulse[n] + time_since_last > (s_short * 1.5)) {
+    else if (pulse_data_pulse(pulses, n) + time_since_last > (s_short * 1.5)) {
       // Last bit was recorded more than short_width*1.5 samples ago
       // so this pulse start must be a data edge (falling data edge means bit = 1)
-      bitbuffer_add_bit(&bits, 1);
+      pending_add_bit(bits, &pending, 1);
       time_since_last = 0;
     } else {
-      time_since_last += pulses->pulse[n];
+      time_since_last += pulse_data_pulse(pulses, n);
     }
 
     // End of Message?
     if (((n == pulses->num_pulses - 1) // No more pulses? (FSK)
-         || (pulses->gap[n] > s_reset)) // Long silence (OOK)
-        && (bits.num_rows > 0)) { // Only if data has been accumulated
-      events += account_event(device, &bits, __func__);
-      bitbuffer_clear(&bits);
-      bitbuffer_add_bit(&bits, 0); // Prepare for new message with hardcoded 0
+         || (pulse_data_gap(pulses, n) > s_reset)) // Long silence (OOK)
+        && (bits->num_rows > 0)) { // Only if data has been accumulated
+      pending_flush(bits, &pending);
+      events += account_event(ctx, device, bits, __func__);
+      bitbuffer_clear(bits);
+      bitbuffer_add_bit(bits, 0); // Prepare for new message with hardcoded 0
       time_since_last = 0;
     }
     // Rising edge is on end of gap
-    else if (pulses->gap[n] + time_since_last > (s_short * 1.5)) {
+    else if (pulse_data_gap(pulses, n) + time_since_last > (s_short * 1.5)) {
       // Last bit was recorded more than short_width*1.5 samples ago
       // so this pulse end is a data edge (rising data edge means bit = 0)
-      bitbuffer_add_bit(&bits, 0);
+      pending_add_bit(bits, &pending, 0);
       time_since_last = 0;
     } else {
-      time_since_last += pulses->gap[n];
+      time_since_last += pulse_data_gap(pulses, n);
     }
   }
   return events;
@@ -477,12 +538,12 @@ int pulse_slicer_manchester_zerobit(pulse_data_t const* pulses, r_device* device
 
 static inline int pulse_slicer_get_symbol(pulse_data_t const* pulses, unsigned int n) {
   if (n % 2 == 0)
-    return pulses->pulse[n / 2];
+    return pulse_data_pulse(pulses, n / 2);
   else
-    return pulses->gap[n / 2];
+    return pulse_data_gap(pulses, n / 2);
 }
 
-int pulse_slicer_dmc(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_dmc(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -498,8 +559,8 @@ int pulse_slicer_dmc(pulse_data_t const* pulses, r_device* device) {
     return 0;
   }
 
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
   int events = 0;
 
   for (unsigned int n = 0; n < pulses->num_pulses * 2; ++n) {
@@ -507,14 +568,14 @@ int pulse_slicer_dmc(pulse_data_t const* pulses, r_device* device) {
 
     if (abs(symbol - s_short) < s_tolerance) {
       // Short - 1
-      bitbuffer_add_bit(&bits, 1);
+      bitbuffer_add_bit(bits, 1);
       symbol = pulse_slicer_get_symbol(pulses, ++n);
       if (abs(symbol - s_short) > s_tolerance) {
         if (symbol >= s_reset - s_tolerance) {
           // Don't expect another short gap at end of message
           n--;
-        } else if (bits.num_rows > 0 && bits.bits_per_row[bits.num_rows - 1] > 0) {
-          bitbuffer_add_row(&bits);
+        } else if (bits->num_rows > 0 && bits->bits_per_row[bits->num_rows - 1] > 0) {
+          bitbuffer_add_row(bits);
           /*
                     print_logf(LOG_WARNING, __func__, "Detected error during pulse_slicer_dmc(): %s",
                             device->name);
@@ -523,17 +584,17 @@ int pulse_slicer_dmc(pulse_data_t const* pulses, r_device* device) {
       }
     } else if (abs(symbol - s_long) < s_tolerance) {
       // Long - 0
-      bitbuffer_add_bit(&bits, 0);
-    } else if (symbol >= s_reset - s_tolerance && bits.num_rows > 0) { // Only if data has been accumulated
+      bitbuffer_add_bit(bits, 0);
+    } else if (symbol >= s_reset - s_tolerance && bits->num_rows > 0) { // Only if data has been accumulated
       //END message ?
-      events += account_event(device, &bits, __func__);
+      events += account_event(ctx, device, bits, __func__);
     }
   }
 
   return events;
 }
 
-int pulse_slicer_piwm_raw(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_piwm_raw(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -554,21 +615,21 @@ int pulse_slicer_piwm_raw(pulse_data_t const* pulses, r_device* device) {
 
   int w;
 
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
   int events = 0;
 
   for (unsigned int n = 0; n < pulses->num_pulses * 2; ++n) {
     int symbol = pulse_slicer_get_symbol(pulses, n);
     w = symbol * f_short + 0.5;
     if (symbol > s_long) {
-      bitbuffer_add_row(&bits);
+      bitbuffer_add_row(bits);
     } else if (abs(symbol - w * s_short) < s_tolerance) {
       // Add w symbols
       for (; w > 0; --w)
-        bitbuffer_add_bit(&bits, 1 - n % 2);
-    } else if (symbol < s_reset && bits.num_rows > 0 && bits.bits_per_row[bits.num_rows - 1] > 0) {
-      bitbuffer_add_row(&bits);
+        bitbuffer_add_bit(bits, 1 - n % 2);
+    } else if (symbol < s_reset && bits->num_rows > 0 && bits->bits_per_row[bits->num_rows - 1] > 0) {
+      bitbuffer_add_row(bits);
       /*
             print_logf(LOG_WARNING, __func__, "Detected error during pulse_slicer_piwm_raw(): %s",
                     device->name);
@@ -577,16 +638,16 @@ int pulse_slicer_piwm_raw(pulse_data_t const* pulses, r_device* device) {
 
     if (((n == pulses->num_pulses * 2 - 1) // No more pulses? (FSK)
          || (symbol > s_reset)) // Long silence (OOK)
-        && (bits.num_rows > 0)) { // Only if data has been accumulated
+        && (bits->num_rows > 0)) { // Only if data has been accumulated
       //END message ?
-      events += account_event(device, &bits, __func__);
+      events += account_event(ctx, device, bits, __func__);
     }
   }
 
   return events;
 }
 
-int pulse_slicer_piwm_dc(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_piwm_dc(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -602,20 +663,20 @@ int pulse_slicer_piwm_dc(pulse_data_t const* pulses, r_device* device) {
     return 0;
   }
 
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
   int events = 0;
 
   for (unsigned int n = 0; n < pulses->num_pulses * 2; ++n) {
     int symbol = pulse_slicer_get_symbol(pulses, n);
     if (abs(symbol - s_short) < s_tolerance) {
       // Short - 1
-      bitbuffer_add_bit(&bits, 1);
+      bitbuffer_add_bit(bits, 1);
     } else if (abs(symbol - s_long) < s_tolerance) {
       // Long - 0
-      bitbuffer_add_bit(&bits, 0);
-    } else if (symbol < s_reset && bits.num_rows > 0 && bits.bits_per_row[bits.num_rows - 1] > 0) {
-      bitbuffer_add_row(&bits);
+      bitbuffer_add_bit(bits, 0);
+    } else if (symbol < s_reset && bits->num_rows > 0 && bits->bits_per_row[bits->num_rows - 1] > 0) {
+      bitbuffer_add_row(bits);
       /*
             print_logf(LOG_WARNING, __func__, "Detected error during pulse_slicer_piwm_dc(): %s",
                     device->name);
@@ -624,16 +685,16 @@ int pulse_slicer_piwm_dc(pulse_data_t const* pulses, r_device* device) {
 
     if (((n == pulses->num_pulses * 2 - 1) // No more pulses? (FSK)
          || (symbol > s_reset)) // Long silence (OOK)
-        && (bits.num_rows > 0)) { // Only if data has been accumulated
+        && (bits->num_rows > 0)) { // Only if data has been accumulated
       //END message ?
-      events += account_event(device, &bits, __func__);
+      events += account_event(ctx, device, bits, __func__);
     }
   }
 
   return events;
 }
 
-int pulse_slicer_nrzs(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_nrzs(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -650,22 +711,22 @@ int pulse_slicer_nrzs(pulse_data_t const* pulses, r_device* device) {
   }
 
   int events = 0;
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
   int limit = s_short;
 
   for (unsigned n = 0; n < pulses->num_pulses; ++n) {
-    if (pulses->pulse[n] > limit) {
-      for (int i = 0; i < (pulses->pulse[n] / limit); i++) {
-        bitbuffer_add_bit(&bits, 1);
+    if (pulse_data_pulse(pulses, n) > limit) {
+      for (int i = 0; i < (pulse_data_pulse(pulses, n) / limit); i++) {
+        bitbuffer_add_bit(bits, 1);
       }
-      bitbuffer_add_bit(&bits, 0);
-    } else if (pulses->pulse[n] < limit) {
-      bitbuffer_add_bit(&bits, 0);
+      bitbuffer_add_bit(bits, 0);
+    } else if (pulse_data_pulse(pulses, n) < limit) {
+      bitbuffer_add_bit(bits, 0);
     }
 
-    if (n == pulses->num_pulses - 1 || pulses->gap[n] >= s_reset) {
-      events += account_event(device, &bits, __func__);
+    if (n == pulses->num_pulses - 1 || pulse_data_gap(pulses, n) >= s_reset) {
+      events += account_event(ctx, device, bits, __func__);
     }
   }
 
@@ -685,7 +746,7 @@ int pulse_slicer_nrzs(pulse_data_t const* pulses, r_device* device) {
  * bit is discarded.
  */
 
-int pulse_slicer_osv1(pulse_data_t const* pulses, r_device* device) {
+int pulse_slicer_osv1(decode_ctx_t* ctx, pulse_data_t const* pulses, r_device* device) {
   float samples_per_us = pulses->sample_rate / 1.0e6;
 
   int s_short = device->short_width * samples_per_us;
@@ -705,76 +766,77 @@ int pulse_slicer_osv1(pulse_data_t const* pulses, r_device* device) {
   int preamble = 0;
   int events = 0;
   int manbit = 0;
-  // bitbuffer_t bits = {0};
-  bitbuffer_clear(&bits);
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
   int halfbit_min = s_short / 2;
   int halfbit_max = s_short * 3 / 2;
   int sync_min = 2 * halfbit_max;
 
   /* preamble */
   for (n = 0; n < pulses->num_pulses; ++n) {
-    if (pulses->pulse[n] > halfbit_min && pulses->gap[n] > halfbit_min) {
+    if (pulse_data_pulse(pulses, n) > halfbit_min && pulse_data_gap(pulses, n) > halfbit_min) {
       preamble++;
-      if (pulses->gap[n] > halfbit_max)
+      if (pulse_data_gap(pulses, n) > halfbit_max)
         break;
     } else
       return events;
   }
   if (preamble != 12) {
     if (device->verbose)
-      print_logf(LOG_WARNING, __func__, "preamble %d  %d %d", preamble, pulses->pulse[0], pulses->gap[0]);
+      print_logf(LOG_WARNING, __func__, "preamble %d  %d %d", preamble, pulse_data_pulse(pulses, 0), pulse_data_gap(pulses, 0));
     return events;
   }
 
   /* sync */
   ++n;
-  if (pulses->pulse[n] < sync_min || pulses->gap[n] < sync_min) {
+  if (pulse_data_pulse(pulses, n) < sync_min || pulse_data_gap(pulses, n) < sync_min) {
     return events;
   }
 
   /* data bits - manchester encoding */
 
   /* sync gap could be part of data when the first bit is 0 */
-  if (pulses->gap[n] > pulses->pulse[n]) {
+  if (pulse_data_gap(pulses, n) > pulse_data_pulse(pulses, n)) {
     manbit ^= 1;
     if (manbit)
-      bitbuffer_add_bit(&bits, 0);
+      bitbuffer_add_bit(bits, 0);
   }
 
   /* remaining data bits */
   for (n++; n < pulses->num_pulses; ++n) {
     manbit ^= 1;
     if (manbit)
-      bitbuffer_add_bit(&bits, 1);
-    if (pulses->pulse[n] > halfbit_max) {
+      bitbuffer_add_bit(bits, 1);
+    if (pulse_data_pulse(pulses, n) > halfbit_max) {
       manbit ^= 1;
       if (manbit)
-        bitbuffer_add_bit(&bits, 1);
+        bitbuffer_add_bit(bits, 1);
     }
-    if ((n == pulses->num_pulses - 1 || pulses->gap[n] > s_reset) && (bits.num_rows > 0)) { // Only if data has been accumulated
+    if ((n == pulses->num_pulses - 1 || pulse_data_gap(pulses, n) > s_reset) && (bits->num_rows > 0)) { // Only if data has been accumulated
       //END message ?
-      events += account_event(device, &bits, __func__);
+      events += account_event(ctx, device, bits, __func__);
       return events;
     }
     manbit ^= 1;
     if (manbit)
-      bitbuffer_add_bit(&bits, 0);
-    if (pulses->gap[n] > halfbit_max) {
+      bitbuffer_add_bit(bits, 0);
+    if (pulse_data_gap(pulses, n) > halfbit_max) {
       manbit ^= 1;
       if (manbit)
-        bitbuffer_add_bit(&bits, 0);
+        bitbuffer_add_bit(bits, 0);
     }
   }
   return events;
 }
 
-int pulse_slicer_string(const char* code, r_device* device) {
+int pulse_slicer_string(decode_ctx_t* ctx, const char* code, r_device* device) {
   int events = 0;
-  bitbuffer_t bits = {0};
+  bitbuffer_t* bits = &ctx->bits;
+  bitbuffer_clear(bits);
 
-  bitbuffer_parse(&bits, code);
+  bitbuffer_parse(bits, code);
 
-  events += account_event(device, &bits, __func__);
+  events += account_event(ctx, device, bits, __func__);
 
   return events;
 }
@@ -19,15 +19,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "pulse_classifier.h"
 #include "pulse_slicer.h"
 #include "r_device.h"
 #include "r_private.h"
 #include "r_util.h"
+#include "unit_convert.h"
 #include "rtl_433.h"
 #include "rtl_433_devices.h"
 // #include "pulse_detect_fsk.h"
 // #include "compat_time.h"
 #include "data.h"
+#include "demod_dispatch.h"
 // #include "data_tag.h"
 #include "fatal.h"
 // #include "http_server.h"
@@ -248,7 +251,56 @@ void r_free_cfg(r_cfg_t *cfg) {
 
 /* device decoder protocols */
 
-void register_protocol(r_cfg_t* cfg, r_device* r_dev, char* arg) {
+/// Check if two decoders slice a pulse train into the same bits in the same priority pass
+static int same_slicing(r_device const* a, r_device const* b) {
+  return a->modulation == b->modulation && a->short_width == b->short_width &&
+         a->long_width == b->long_width && a->reset_limit == b->reset_limit &&
+         a->gap_limit == b->gap_limit && a->sync_width == b->sync_width &&
+         a->tolerance == b->tolerance && a->priority == b->priority;
+}
+
+/// Append the decoder to the slicing group of a decoder with the same timing registered before it
+static void join_slicing_group(r_cfg_t* cfg, r_device* r_dev) {
+  r_dev->slice_next = NULL;
+  r_dev->slice_follower = 0;
+#ifdef RTL_ANALYZE
+  if (r_dev->protocol_num == RTL_ANALYZE)
+    return; // the analyzed decoder runs its own slicer
+#endif
+  for (void** iter = cfg->demod->r_devs.elems; iter && *iter && *iter != r_dev; ++iter) {
+    r_device* leader = *iter;
+    if (leader->slice_follower || !same_slicing(leader, r_dev))
+      continue;
+#ifdef RTL_ANALYZE
+    if (leader->protocol_num == RTL_ANALYZE)
+      continue;
+#endif
+    while (leader->slice_next)
+      leader = leader->slice_next;
+    leader->slice_next = r_dev;
+    r_dev->slice_follower = 1;
+    return;
+  }
+}
+
+/// Form the slicing groups and the dispatch tables again after the registered decoders changed
+static void rebuild_protocols(r_cfg_t* cfg) {
+  for (void** iter = cfg->demod->r_devs.elems; iter && *iter; ++iter) {
+    r_device* r_dev = *iter;
+    r_dev->slice_next = NULL;
+  }
+  for (void** iter = cfg->demod->r_devs.elems; iter && *iter; ++iter) {
+    join_slicing_group(cfg, *iter);
+  }
+  if (demod_dispatch_build(&cfg->demod->dispatch, &cfg->demod->r_devs))
+    FATAL_CALLOC("rebuild_protocols()");
+}
+
+/*
+ * r_dev is the descriptor of the decoder, in flash, the decoder is run on a
+ * copy in RAM that holds its statistics, verbosity and output context
+ */
+void register_protocol(r_cfg_t* cfg, r_device const* r_dev, unsigned protocol_num, char* arg) {
   // use arg of 'v', 'vv', 'vvv' as device verbosity
   int dev_verbose = 0;
   if (arg && *arg == 'v') {
@@ -267,7 +319,7 @@ void register_protocol(r_cfg_t* cfg, r_device* r_dev, char* arg) {
   } else {
     if (arg && *arg) {
       fprintf(stderr, "Protocol [%u] \"%s\" does not take arguments \"%s\"!\n",
-              r_dev->protocol_num, r_dev->name, arg);
+              protocol_num, r_dev->name, arg);
     }
     p = malloc(sizeof(*p));
     if (!p)
@@ -275,6 +327,7 @@ void register_protocol(r_cfg_t* cfg, r_device* r_dev, char* arg) {
     *p = *r_dev; // copy
   }
 
+  p->protocol_num = protocol_num;
   p->verbose = dev_verbose ? dev_verbose : (cfg->verbosity > 4 ? cfg->verbosity - 5 : 0);
 
   p->log_fn = log_device_handler;
@@ -282,37 +335,55 @@ void register_protocol(r_cfg_t* cfg, r_device* r_dev, char* arg) {
   p->output_fn = data_acquired_handler;
   p->output_ctx = cfg;
 
+  unit_convert_register(cfg->conversion_mode, p->fields);
+
+  // keep the decoders in protocol order, a decoder enabled later takes its place
   list_push(&cfg->demod->r_devs, p);
+  void** elems = cfg->demod->r_devs.elems;
+  size_t pos = cfg->demod->r_devs.len - 1;
+  for (; pos > 0 && ((r_device*)elems[pos - 1])->protocol_num > protocol_num; pos--) {
+    elems[pos] = elems[pos - 1];
+  }
+  elems[pos] = p;
+  if (pos + 1 < cfg->demod->r_devs.len) {
+    rebuild_protocols(cfg);
+  } else {
+    join_slicing_group(cfg, p);
+    if (demod_dispatch_build(&cfg->demod->dispatch, &cfg->demod->r_devs))
+      FATAL_CALLOC("register_protocol()");
+  }
 
   if (cfg->verbosity >= LOG_INFO) {
-    fprintf(stderr, "Registering protocol [%u] \"%s\"\n", r_dev->protocol_num,
+    fprintf(stderr, "Registering protocol [%u] \"%s\"\n", protocol_num,
             r_dev->name);
   }
 }
 
-/*
-void free_protocol(r_device *r_dev) {
+void free_protocol(r_device* r_dev) {
   // free(r_dev->name);
   free(r_dev->decode_ctx);
   free(r_dev);
 }
 
-void unregister_protocol(r_cfg_t *cfg, r_device *r_dev) {
-  for (size_t i = 0; i < cfg->demod->r_devs.len;
-       ++i) { // list might contain NULLs
-    r_device *p = cfg->demod->r_devs.elems[i];
-    if (!strcmp(p->name, r_dev->name)) {
+/*
+ * r_dev is a registered decoder, its RAM copy is freed
+ */
+void unregister_protocol(r_cfg_t* cfg, r_device* r_dev) {
+  for (size_t i = 0; i < cfg->demod->r_devs.len; ++i) {
+    if (cfg->demod->r_devs.elems[i] == r_dev) {
       list_remove(&cfg->demod->r_devs, i, (list_elem_free_fn)free_protocol);
-      i--; // so we don't skip the next elem now shifted down
+      rebuild_protocols(cfg);
+      return;
     }
   }
 }
 
+/*
 void register_all_protocols(r_cfg_t *cfg, unsigned disabled) {
   for (int i = 0; i < cfg->num_r_devices; i++) {
     // register all device protocols that are not disabled
-    if (cfg->devices[i].disabled <= disabled) {
-      register_protocol(cfg, &cfg->devices[i], NULL);
+    if (cfg->devices[i]->disabled <= disabled) {
+      register_protocol(cfg, cfg->devices[i], i, NULL);
     }
   }
 }
@@ -510,150 +581,89 @@ char const **determine_csv_fields(r_cfg_t *cfg, char const *const *well_known,
 
 */
 
-int run_ook_demods(list_t* r_devs, pulse_data_t* pulse_data) {
+void start_demods(decode_ctx_t* ctx, pulse_data_t* pulse_data) {
+  ctx->classify = pulse_classifier_enabled;
+  if (ctx->classify) {
+    pulse_fingerprint(&ctx->fingerprint, &ctx->stats, pulse_data);
+  }
+}
+
+int run_demods_pass(decode_ctx_t* ctx, demod_table_t const* table, pulse_data_t* pulse_data,
+                    unsigned priority, unsigned* next_priority) {
   int p_events = 0;
 
-  unsigned next_priority = 0; // next smallest on each loop through decoders
-  // run all decoders of each priority, stop if an event is produced
-  for (unsigned priority = 0; !p_events && priority < UINT_MAX;
-       priority = next_priority) {
-    next_priority = UINT_MAX;
-    for (void** iter = r_devs->elems; iter && *iter; ++iter) {
-      r_device* r_dev = *iter;
-
-      // Find next smallest priority
-      if (r_dev->priority > priority && r_dev->priority < next_priority)
-        next_priority = r_dev->priority;
-      // Run only current priority
-      if (r_dev->priority != priority)
-        continue;
+  // Levels are in ascending priority, find the one to run and the next one
+  demod_level_t const* level = NULL;
+  for (unsigned i = 0; i < table->num_levels; ++i) {
+    if (table->levels[i].priority == priority) {
+      level = &table->levels[i];
+    } else if (table->levels[i].priority > priority) {
+      if (table->levels[i].priority < *next_priority)
+        *next_priority = table->levels[i].priority;
+      break;
+    }
+  }
+  if (!level)
+    return 0;
+
+  demod_entry_t const* end = &table->entries[level->first + level->count];
+  for (demod_entry_t const* entry = &table->entries[level->first]; entry < end; ++entry) {
+    r_device* r_dev = entry->r_dev;
+    // Skip decoders whose timing no width of the train can match
+    if (ctx->classify && !pulse_fingerprint_match(&ctx->fingerprint, r_dev)) {
+      ctx->stats.skipped += 1 + entry->followers;
+      continue;
+    }
+    ctx->stats.runs++;
+    ctx->stats.shared += entry->followers;
 #ifdef RTL_DEBUG
-        // logprintfLn(LOG_DEBUG, "demod(%d) - %s", r_dev->modulation, r_dev->name);
+    // logprintfLn(LOG_DEBUG, "demod(%d) - %s", r_dev->modulation, r_dev->name);
 #endif
 #ifdef RESOURCE_DEBUG
-      int preStack = uxTaskGetStackHighWaterMark(NULL);
+    int preStack = uxTaskGetStackHighWaterMark(NULL);
 #endif
-
-      switch (r_dev->modulation) {
-        case OOK_PULSE_PCM:
-          // case OOK_PULSE_RZ:
-          p_events += pulse_slicer_pcm(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_PPM:
-          p_events += pulse_slicer_ppm(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_PWM:
-          p_events += pulse_slicer_pwm(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_MANCHESTER_ZEROBIT:
-          p_events += pulse_slicer_manchester_zerobit(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_PIWM_RAW:
-          p_events += pulse_slicer_piwm_raw(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_PIWM_DC:
-          p_events += pulse_slicer_piwm_dc(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_DMC:
-          p_events += pulse_slicer_dmc(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_PWM_OSV1:
-          p_events += pulse_slicer_osv1(pulse_data, r_dev);
-          break;
-        case OOK_PULSE_NRZS:
-          p_events += pulse_slicer_nrzs(pulse_data, r_dev);
-          break;
-        // FSK decoders
-        case FSK_PULSE_PCM:
-        case FSK_PULSE_PWM:
-        case FSK_PULSE_MANCHESTER_ZEROBIT:
-          break;
-        default:
-          fprintf(stderr, "Unknown modulation %u in protocol!\n",
-                  r_dev->modulation);
-      }
+    p_events += entry->slicer(ctx, pulse_data, r_dev);
 #ifdef RESOURCE_DEBUG
-      int delta = preStack - uxTaskGetStackHighWaterMark(NULL);
-      if (delta) {
-        logprintfLn(LOG_DEBUG, "Process rtl_433_DecoderTask resource hit demod(%d) - %s, delta %d, stack free: %u", r_dev->modulation, r_dev->name,
-                    delta, uxTaskGetStackHighWaterMark(NULL));
-      }
+    int delta = preStack - uxTaskGetStackHighWaterMark(NULL);
+    if (delta) {
+      logprintfLn(LOG_DEBUG, "Process rtl_433_DecoderTask resource hit demod(%d) - %s, delta %d, stack free: %u", r_dev->modulation, r_dev->name,
+                  delta, uxTaskGetStackHighWaterMark(NULL));
+    }
 #endif
 #ifdef RTL_ANALYZE
-      // logprintfLn(LOG_DEBUG, "RTL_ANALYZE_MODEL %s==%d", r_dev->name, r_dev->protocol_num);
-      if (r_dev->protocol_num == RTL_ANALYZE) {
-        pulse_analyzer(pulse_data, 1);
-      }
-#endif
+    // logprintfLn(LOG_DEBUG, "RTL_ANALYZE_MODEL %s==%d", r_dev->name, r_dev->protocol_num);
+    if (r_dev->protocol_num == RTL_ANALYZE) {
+      pulse_analyzer(pulse_data, 1);
     }
+#endif
   }
 
   return p_events;
 }
 
-int run_fsk_demods(list_t* r_devs, pulse_data_t* fsk_pulse_data) {
+/// Run all decoders of each priority, stop if an event is produced
+static int run_demods(decode_ctx_t* ctx, demod_table_t const* table, pulse_data_t* pulse_data) {
   int p_events = 0;
+  start_demods(ctx, pulse_data);
 
-  unsigned next_priority = 0; // next smallest on each loop through decoders
-  // run all decoders of each priority, stop if an event is produced
+  unsigned next_priority = 0; // next smallest after each pass
   for (unsigned priority = 0; !p_events && priority < UINT_MAX;
        priority = next_priority) {
     next_priority = UINT_MAX;
-    for (void** iter = r_devs->elems; iter && *iter; ++iter) {
-      r_device* r_dev = *iter;
-
-      // Find next smallest priority
-      if (r_dev->priority > priority && r_dev->priority < next_priority)
-        next_priority = r_dev->priority;
-      // Run only current priority
-      if (r_dev->priority != priority)
-        continue;
-
-#ifdef RTL_DEBUG
-        // logprintfLn(LOG_DEBUG, "demod(%d) - %s", r_dev->modulation, r_dev->name);
-#endif
-#ifdef RESOURCE_DEBUG
-      int preStack = uxTaskGetStackHighWaterMark(NULL);
-#endif
-      switch (r_dev->modulation) {
-        // OOK decoders
-        case OOK_PULSE_PCM:
-        // case OOK_PULSE_RZ:
-        case OOK_PULSE_PPM:
-        case OOK_PULSE_PWM:
-        case OOK_PULSE_MANCHESTER_ZEROBIT:
-        case OOK_PULSE_PIWM_RAW:
-        case OOK_PULSE_PIWM_DC:
-        case OOK_PULSE_DMC:
-        case OOK_PULSE_PWM_OSV1:
-        case OOK_PULSE_NRZS:
-          break;
-        case FSK_PULSE_PCM:
-          p_events += pulse_slicer_pcm(fsk_pulse_data, r_dev);
-          break;
-        case FSK_PULSE_PWM:
-          p_events += pulse_slicer_pwm(fsk_pulse_data, r_dev);
-          break;
-        case FSK_PULSE_MANCHESTER_ZEROBIT:
-          p_events += pulse_slicer_manchester_zerobit(fsk_pulse_data, r_dev);
-          break;
-        default:
-          fprintf(stderr, "Unknown modulation %u in protocol!\n",
-                  r_dev->modulation);
-      }
-#ifdef RESOURCE_DEBUG
-      int delta = preStack - uxTaskGetStackHighWaterMark(NULL);
-      if (delta) {
-        logprintfLn(LOG_DEBUG, "Process rtl_433_DecoderTask resource hit demod(%d) - %s, delta %d, stack free: %u", r_dev->modulation, r_dev->name,
-                    delta, uxTaskGetStackHighWaterMark(NULL));
-      }
-#endif
-    }
+    p_events += run_demods_pass(ctx, table, pulse_data, priority, &next_priority);
   }
 
   return p_events;
 }
 
+int run_ook_demods(decode_ctx_t* ctx, demod_dispatch_t const* dispatch, pulse_data_t* pulse_data) {
+  return run_demods(ctx, &dispatch->ook, pulse_data);
+}
+
+int run_fsk_demods(decode_ctx_t* ctx, demod_dispatch_t const* dispatch, pulse_data_t* fsk_pulse_data) {
+  return run_demods(ctx, &dispatch->fsk, fsk_pulse_data);
+}
+
 /* handlers */
 
 /*
@@ -761,160 +771,7 @@ void data_acquired_handler(r_device* r_dev, data_t* data) {
   }
 #endif
 
-  if (cfg->conversion_mode == CONVERT_SI) {
-    for (data_t* d = data; d; d = d->next) {
-      // Convert double type fields ending in _F to _C
-      if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_F")) {
-        d->value.v_dbl = fahrenheit2celsius(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_F", "_C");
-        free(d->key);
-        d->key = new_label;
-        char* pos;
-        if (d->format && (pos = strrchr(d->format, 'F'))) {
-          *pos = 'C';
-        }
-      }
-      // Convert double type fields ending in _mph to _kph
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_mph")) {
-        d->value.v_dbl = mph2kmph(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_mph", "_kph");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "mi/h", "km/h");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _mi_h to _km_h
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_mi_h")) {
-        d->value.v_dbl = mph2kmph(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_mi_h", "_km_h");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "mi/h", "km/h");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _in to _mm
-      else if ((d->type == DATA_DOUBLE) &&
-               (str_endswith(d->key, "_in") || str_endswith(d->key, "_inch"))) {
-        d->value.v_dbl = inch2mm(d->value.v_dbl);
-        // need to free ptr returned from str_replace
-        char* new_label1 = str_replace(d->key, "_inch", "_in");
-        char* new_label2 = str_replace(new_label1, "_in", "_mm");
-        free(new_label1);
-        free(d->key);
-        d->key = new_label2;
-        char* new_format_label = str_replace(d->format, "in", "mm");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _in_h to _mm_h
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_in_h")) {
-        d->value.v_dbl = inch2mm(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_in_h", "_mm_h");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "in/h", "mm/h");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _inHg to _hPa
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_inHg")) {
-        d->value.v_dbl = inhg2hpa(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_inHg", "_hPa");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "inHg", "hPa");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _PSI to _kPa
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_PSI")) {
-        d->value.v_dbl = psi2kpa(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_PSI", "_kPa");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "PSI", "kPa");
-        free(d->format);
-        d->format = new_format_label;
-      }
-    }
-  }
-  if (cfg->conversion_mode == CONVERT_CUSTOMARY) {
-    for (data_t* d = data; d; d = d->next) {
-      // Convert double type fields ending in _C to _F
-      if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_C")) {
-        d->value.v_dbl = celsius2fahrenheit(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_C", "_F");
-        free(d->key);
-        d->key = new_label;
-        char* pos;
-        if (d->format && (pos = strrchr(d->format, 'C'))) {
-          *pos = 'F';
-        }
-      }
-      // Convert double type fields ending in _kph to _mph
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_kph")) {
-        d->value.v_dbl = kmph2mph(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_kph", "_mph");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "km/h", "mi/h");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _km_h to _mi_h
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_km_h")) {
-        d->value.v_dbl = kmph2mph(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_km_h", "_mi_h");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "km/h", "mi/h");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _mm to _inch
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_mm")) {
-        d->value.v_dbl = mm2inch(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_mm", "_in");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "mm", "in");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _mm_h to _in_h
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_mm_h")) {
-        d->value.v_dbl = mm2inch(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_mm_h", "_in_h");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "mm/h", "in/h");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _hPa to _inHg
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_hPa")) {
-        d->value.v_dbl = hpa2inhg(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_hPa", "_inHg");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "hPa", "inHg");
-        free(d->format);
-        d->format = new_format_label;
-      }
-      // Convert double type fields ending in _kPa to _PSI
-      else if ((d->type == DATA_DOUBLE) && str_endswith(d->key, "_kPa")) {
-        d->value.v_dbl = kpa2psi(d->value.v_dbl);
-        char* new_label = str_replace(d->key, "_kPa", "_PSI");
-        free(d->key);
-        d->key = new_label;
-        char* new_format_label = str_replace(d->format, "kPa", "PSI");
-        free(d->format);
-        d->format = new_format_label;
-      }
-    }
-  }
+  unit_convert_data(cfg->conversion_mode, data);
 
   /*
     // prepend "description" if requested
@@ -976,15 +833,38 @@ void data_acquired_handler(r_device* r_dev, data_t* data) {
   data_append(data, "protocol", "", DATA_STRING, r_dev->name, "rssi", "RSSI",
               DATA_INT, cfg->demod->pulse_data.signalRssi, "duration", "",
               DATA_INT, cfg->demod->pulse_data.signalDuration, NULL);
-  data_print_jsons(data, cfg->messageBuffer, cfg->bufferSize);
+  r_output_message(cfg, data);
+  data_free(data);
+}
+
+void r_output_message(r_cfg_t *cfg, data_t *data)
+{
+  size_t size = cfg->bufferSize > 0 ? cfg->bufferSize : 0;
+  size_t len;
+  if (cfg->messageFormat == MESSAGE_CBOR) {
+    len = data_print_cbor(data, (uint8_t *)cfg->messageBuffer, size);
+  } else {
+    len = data_print_jsons(data, cfg->messageBuffer, size);
+    len++; // the terminating NUL
+  }
+  if (len > size) {
+    // a cut off message would not parse, drop it rather than publish it
+    cfg->truncatedMessages++;
+    logprintfLn(LOG_ERR, "ERROR: message of %u bytes exceeds buffer size %u, dropped",
+                (unsigned)len, (unsigned)size);
+    return;
+  }
 #ifdef DEMOD_DEBUG
-  logprintfLn(LOG_INFO, "data_output %s", cfg->messageBuffer);
+  if (cfg->messageFormat == MESSAGE_JSON)
+    logprintfLn(LOG_INFO, "data_output %s", cfg->messageBuffer);
 #endif
 
   // callback to external function that receives message from device (
   // rtl_433_ESPCallBack )
-  (cfg->callback)(cfg->messageBuffer);
-  data_free(data);
+  if (cfg->messageFormat == MESSAGE_CBOR)
+    (cfg->binaryCallback)((const unsigned char *)cfg->messageBuffer, len);
+  else
+    (cfg->callback)(cfg->messageBuffer);
 }
 
 // level 0: do not report (don't call this), 1: report successful devices, 2:
@@ -0,0 +1,159 @@
+/** @file
+    Unit conversion of decoded data to SI or customary units.
+
+    Each conversion is a rule on the key suffix, e.g. "_F" to "_C", which
+    also replaces the unit in the format. The converted keys and formats
+    are interned: the first conversion of a key allocates its new name,
+    every following one just points the data at it. The keys of the
+    declared fields are interned when the decoder is registered.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "unit_convert.h"
+#include "fatal.h"
+#include "list.h"
+#include "r_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    conversion_mode_t mode;
+    char const *suffix;    ///< key suffix converted
+    char const *to_suffix; ///< replacement key suffix
+    char const *unit;      ///< last occurrence replaced in the format
+    char const *to_unit;
+    float (*convert)(float);
+} unit_rule_t;
+
+/// First matching rule applies, as with the former str_endswith() chain
+static unit_rule_t const unit_rules[] = {
+        {CONVERT_SI, "_F", "_C", "F", "C", fahrenheit2celsius},
+        {CONVERT_SI, "_mph", "_kph", "mi/h", "km/h", mph2kmph},
+        {CONVERT_SI, "_mi_h", "_km_h", "mi/h", "km/h", mph2kmph},
+        {CONVERT_SI, "_in", "_mm", "in", "mm", inch2mm},
+        {CONVERT_SI, "_inch", "_mm", "in", "mm", inch2mm},
+        {CONVERT_SI, "_in_h", "_mm_h", "in/h", "mm/h", inch2mm},
+        {CONVERT_SI, "_inHg", "_hPa", "inHg", "hPa", inhg2hpa},
+        {CONVERT_SI, "_PSI", "_kPa", "PSI", "kPa", psi2kpa},
+        {CONVERT_CUSTOMARY, "_C", "_F", "C", "F", celsius2fahrenheit},
+        {CONVERT_CUSTOMARY, "_kph", "_mph", "km/h", "mi/h", kmph2mph},
+        {CONVERT_CUSTOMARY, "_km_h", "_mi_h", "km/h", "mi/h", kmph2mph},
+        {CONVERT_CUSTOMARY, "_mm", "_in", "mm", "in", mm2inch},
+        {CONVERT_CUSTOMARY, "_mm_h", "_in_h", "mm/h", "in/h", mm2inch},
+        {CONVERT_CUSTOMARY, "_hPa", "_inHg", "hPa", "inHg", hpa2inhg},
+        {CONVERT_CUSTOMARY, "_kPa", "_PSI", "kPa", "PSI", kpa2psi},
+};
+
+/// A key or format and its converted string.
+typedef struct {
+    unit_rule_t const *rule;
+    int is_key;
+    char *from;
+    char *to;
+} unit_intern_t;
+
+static list_t unit_interned; // unit_intern_t
+
+static unit_rule_t const *find_rule(conversion_mode_t mode, char const *key)
+{
+    size_t len = strlen(key);
+    for (unsigned i = 0; i < sizeof(unit_rules) / sizeof(*unit_rules); ++i) {
+        unit_rule_t const *rule = &unit_rules[i];
+        size_t suffix_len       = strlen(rule->suffix);
+        if (rule->mode == mode && len >= suffix_len && !strcmp(key + len - suffix_len, rule->suffix))
+            return rule;
+    }
+    return NULL;
+}
+
+/// Replace the last occurrence of rep in orig, NULL if there is none.
+static char *replace_last(char const *orig, char const *rep, char const *with)
+{
+    char const *pos = NULL;
+    for (char const *p = strstr(orig, rep); p; p = strstr(p + 1, rep))
+        pos = p;
+    if (!pos)
+        return NULL;
+
+    size_t head = pos - orig;
+    size_t rep_len  = strlen(rep);
+    size_t with_len = strlen(with);
+    char *result = malloc(strlen(orig) - rep_len + with_len + 1);
+    if (!result) {
+        WARN_MALLOC("replace_last()");
+        return NULL;
+    }
+    memcpy(result, orig, head);
+    memcpy(result + head, with, with_len);
+    strcpy(result + head + with_len, pos + rep_len);
+    return result;
+}
+
+/// Converted key (is_key) or format, NULL if it is left as is.
+static char const *intern(unit_rule_t const *rule, char const *from, int is_key)
+{
+    for (void **iter = unit_interned.elems; iter && *iter; ++iter) {
+        unit_intern_t const *interned = *iter;
+        if (interned->rule == rule && interned->is_key == is_key && !strcmp(interned->from, from))
+            return interned->to;
+    }
+
+    unit_intern_t *interned = calloc(1, sizeof(*interned));
+    if (!interned) {
+        WARN_CALLOC("intern()");
+        return NULL;
+    }
+    interned->rule   = rule;
+    interned->is_key = is_key;
+    interned->from = strdup(from);
+    // a key always ends with the suffix, a format need not contain the unit
+    interned->to = is_key ? replace_last(from, rule->suffix, rule->to_suffix)
+                          : replace_last(from, rule->unit, rule->to_unit);
+    if (!interned->from || (is_key && !interned->to)) {
+        free(interned->from);
+        free(interned->to);
+        free(interned);
+        return NULL;
+    }
+    list_push(&unit_interned, interned);
+    return interned->to;
+}
+
+void unit_convert_register(conversion_mode_t mode, char const *const *fields)
+{
+    for (char const *const *field = fields; field && *field; ++field) {
+        unit_rule_t const *rule = find_rule(mode, *field);
+        if (rule)
+            intern(rule, *field, 1);
+    }
+}
+
+void unit_convert_data(conversion_mode_t mode, data_t *data)
+{
+    if (mode == CONVERT_NATIVE)
+        return;
+
+    for (data_t *d = data; d; d = d->next) {
+        if (d->type != DATA_DOUBLE)
+            continue;
+        unit_rule_t const *rule = find_rule(mode, d->key);
+        if (!rule)
+            continue;
+        char const *key = intern(rule, d->key, 1);
+        if (!key)
+            continue;
+
+        d->value.v_dbl = rule->convert(d->value.v_dbl);
+        data_borrow_key(d, key);
+        if (d->format) {
+            char const *format = intern(rule, d->format, 0);
+            if (format)
+                data_borrow_format(d, format);
+        }
+    }
+}
@@ -10,6 +10,9 @@
 */
 
 #include "util.h"
+#ifdef CRC_TABLES
+#include "crc_table.h"
+#endif
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -156,6 +159,9 @@ unsigned extract_bits_symbols(uint8_t *message, unsigned offset_bits, unsigned n
 
 uint8_t crc4(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
 {
+#ifdef CRC_TABLES
+    return crc4_table(message, nBytes, polynomial, init);
+#endif
     unsigned remainder = init << 4; // LSBs are unused
     unsigned poly = polynomial << 4;
     unsigned bit;
@@ -175,6 +181,9 @@ uint8_t crc4(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8
 
 uint8_t crc7(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
 {
+#ifdef CRC_TABLES
+    return crc7_table(message, nBytes, polynomial, init);
+#endif
     unsigned remainder = init << 1; // LSB is unused
     unsigned poly = polynomial << 1;
     unsigned byte, bit;
@@ -194,6 +203,9 @@ uint8_t crc7(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8
 
 uint8_t crc8(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
 {
+#ifdef CRC_TABLES
+    return crc8_table(message, nBytes, polynomial, init);
+#endif
     uint8_t remainder = init;
     unsigned byte, bit;
 
@@ -212,6 +224,9 @@ uint8_t crc8(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8
 
 uint8_t crc8le(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uint8_t init)
 {
+#ifdef CRC_TABLES
+    return crc8le_table(message, nBytes, polynomial, init);
+#endif
     uint8_t remainder = reverse8(init);
     unsigned byte, bit;
     polynomial = reverse8(polynomial);
@@ -231,6 +246,9 @@ uint8_t crc8le(uint8_t const message[], unsigned nBytes, uint8_t polynomial, uin
 
 uint16_t crc16lsb(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
 {
+#ifdef CRC_TABLES
+    return crc16lsb_table(message, nBytes, polynomial, init);
+#endif
     uint16_t remainder = init;
     unsigned byte, bit;
 
@@ -250,6 +268,9 @@ uint16_t crc16lsb(uint8_t const message[], unsigned nBytes, uint16_t polynomial,
 
 uint16_t crc16(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
 {
+#ifdef CRC_TABLES
+    return crc16_table(message, nBytes, polynomial, init);
+#endif
     uint16_t remainder = init;
     unsigned byte, bit;
 
@@ -269,6 +290,9 @@ uint16_t crc16(uint8_t const message[], unsigned nBytes, uint16_t polynomial, ui
 
 uint8_t lfsr_digest8(uint8_t const message[], unsigned bytes, uint8_t gen, uint8_t key)
 {
+#ifdef CRC_TABLES
+    return lfsr_digest8_table(message, bytes, gen, key);
+#endif
     uint8_t sum = 0;
     for (unsigned k = 0; k < bytes; ++k) {
         uint8_t data = message[k];
@@ -291,6 +315,9 @@ uint8_t lfsr_digest8(uint8_t const message[], unsigned bytes, uint8_t gen, uint8
 
 uint8_t lfsr_digest8_reflect(uint8_t const message[], int bytes, uint8_t gen, uint8_t key)
 {
+#ifdef CRC_TABLES
+    return lfsr_digest8_reflect_table(message, bytes, gen, key);
+#endif
     uint8_t sum = 0;
     // Process message from last byte to first byte (reflected)
     for (int k = bytes - 1; k >= 0; --k) {
@@ -316,6 +343,9 @@ uint8_t lfsr_digest8_reflect(uint8_t const message[], int bytes, uint8_t gen, ui
 
 uint16_t lfsr_digest16(uint8_t const message[], unsigned bytes, uint16_t gen, uint16_t key)
 {
+#ifdef CRC_TABLES
+    return lfsr_digest16_table(message, bytes, gen, key);
+#endif
     uint16_t sum = 0;
     for (unsigned k = 0; k < bytes; ++k) {
         uint8_t data = message[k];
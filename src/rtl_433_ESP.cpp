@@ -26,6 +26,7 @@
 
 #include "receiver.h"
 #include "signalDecoder.h"
+#include "signalReceiver.h"
 
 /*----------------------------- Transceiver SPI Connections -----------------------------*/
 
@@ -65,74 +66,23 @@ Module* _mod = radio.getMod();
 
 /*----------------------------- Initialize variables -----------------------------*/
 
-/**
- * Is the receiver currently receiving a signal
- */
-static bool receiveMode = false;
-
-/**
- * Timestamp in micros for start of current signal
- */
-static unsigned long signalStart = micros();
-
-/**
- * Timestamp in micros for end of most recent message aka start of current gap
- */
-static unsigned long gapStart = micros();
-
-/**
- * Timestamp in micros for end of most recent signal
- *
- */
-static unsigned long signalEnd = micros();
-
-pulse_data_t* _pulseTrains;
-
-int rtl_433_ESP::messageCount = 0;
-int rtl_433_ESP::currentRssi = 0;
-int rtl_433_ESP::signalRssi = 0;
-int rtl_433_ESP::rssiThreshold = MINRSSI;
-bool rtl_433_ESP::_enabledReceiver = false;
-volatile uint8_t rtl_433_ESP::_actualPulseTrain = 0;
-uint8_t rtl_433_ESP::_avaiablePulseTrain = 0;
-volatile unsigned long rtl_433_ESP::_lastChange = 0; // Timestamp of previous edge
 int rtl_433_ESP::rtlVerbose = 0;
-volatile int16_t rtl_433_ESP::_nrpulses;
 
 // Variables for OOK Threshold auto calibrate function
 
-int rtl_433_ESP::totalSignals = 0;
-int rtl_433_ESP::ignoredSignals = 0;
-int rtl_433_ESP::unparsedSignals = 0;
 int signalRatio = 0;
 
-// RSSI Threshold and average calculation
-
-int rtl_433_ESP::averageRssi = 0;
-int rtl_433_ESP::rssiThresholdDelta = RSSI_THRESHOLD;
-
-bool rtl_433_ESP::ookModulation = OOK_MODULATION; // Defaults to true
-
-int _totalRssi = 0;
-int _rssiCount = 0;
-
-int _noiseCount = 0; // Count of ticks while receiver is disabled
-
 #ifdef DEAF_WORKAROUND
 unsigned long _deafWorkaround = millis();
 #endif
 
 int16_t rtl_433_ESP::_interrupt = NOT_AN_INTERRUPT;
-static byte receiverGpio = -1;
 
 static TaskHandle_t rtl_433_ReceiverHandle;
 
 /*----------------------------- End of variable initialization -----------------------------*/
 
-rtl_433_ESP::rtl_433_ESP() {
-  _pulseTrains = (pulse_data_t*)heap_caps_calloc(
-      RECEIVER_BUFFER_SIZE, sizeof(pulse_data_t), MALLOC_CAP_INTERNAL);
-}
+rtl_433_ESP::rtl_433_ESP() {}
 
 /**
  * @brief Initialize Transceiver and rtl_433 decoders
@@ -145,7 +95,10 @@ void rtl_433_ESP::initReceiver(byte inputPin, float receiveFrequency) {
   radio.reset();
 #endif
 
-  receiverGpio = digitalPinToInterrupt(inputPin);
+  if (!_source) {
+    static GpioEdgeSource gpioSource(digitalPinToInterrupt(inputPin), _getRSSI);
+    _source = &gpioSource;
+  }
 #ifdef MEMORY_DEBUG
   logprintfLn(LOG_INFO, "Pre initReceiver: %d", ESP.getFreeHeap());
 #endif
@@ -184,6 +137,43 @@ void rtl_433_ESP::initReceiver(byte inputPin, float receiveFrequency) {
   digitalWrite(ONBOARD_LED, LOW);
 #endif
 
+  configureModulation();
+
+#ifdef MEMORY_DEBUG
+  logprintfLn(LOG_INFO, "Post config receivers: %d", ESP.getFreeHeap());
+#endif
+
+  // Receviers configured, start reception
+
+  startReceive();
+
+#ifdef RESOURCE_DEBUG
+  logprintfLn(LOG_INFO, "rtl_433_ReceiverTask_Stack %d", rtl_433_ReceiverTask_Stack);
+#endif
+
+#ifdef RF_MODULE_INIT_STATUS
+  getModuleStatus();
+#endif
+
+  if (!rtl_433_ReceiverHandle) {
+    xTaskCreatePinnedToCore(
+        rtl_433_ESP::rtl_433_ReceiverTask, /* Function to implement the task */
+        "rtl_433_ReceiverTask", /* Name of the task */
+        rtl_433_ReceiverTask_Stack, /* Stack size in bytes */
+        NULL, /* Task input parameter */
+        rtl_433_ReceiverTask_Priority, /* Priority of the task (set lower than core task) */
+        &rtl_433_ReceiverHandle, /* Task handle. */
+        rtl_433_ReceiverTask_Core); /* Core where the task should run */
+  }
+}
+
+/**
+ * @brief Configure the transceiver for ookModulation, standby or before
+ * reception starts
+ * 
+ */
+void rtl_433_ESP::configureModulation() {
+  int state;
   if (ookModulation) {
     state = radio.setOOK(true);
     RADIOLIB_STATE(state, "setOOK");
@@ -296,150 +286,77 @@ void rtl_433_ESP::initReceiver(byte inputPin, float receiveFrequency) {
   if (ookModulation) {
     state = radio.disableBitSync();
     RADIOLIB_STATE(state, "disableBitSync");
+  } else {
+    state = radio.enableBitSync(); // after an OOK window
+    RADIOLIB_STATE(state, "enableBitSync");
   }
 #endif
-
-#ifdef MEMORY_DEBUG
-  logprintfLn(LOG_INFO, "Post config receivers: %d", ESP.getFreeHeap());
-#endif
-
-  // Receviers configured, start reception
-
-#if defined(RF_SX1276) || defined(RF_SX1278)
-  state = radio.receiveDirect();
-#else
-  state = radio.receiveDirectAsync();
-#endif
-  RADIOLIB_STATE(state, "receiveDirect");
-
-#ifdef RESOURCE_DEBUG
-  logprintfLn(LOG_INFO, "rtl_433_ReceiverTask_Stack %d", rtl_433_ReceiverTask_Stack);
-#endif
-
-#ifdef RF_MODULE_INIT_STATUS
-  getModuleStatus();
-#endif
-
-  if (!rtl_433_ReceiverHandle) {
-    xTaskCreatePinnedToCore(
-        rtl_433_ESP::rtl_433_ReceiverTask, /* Function to implement the task */
-        "rtl_433_ReceiverTask", /* Name of the task */
-        rtl_433_ReceiverTask_Stack, /* Stack size in bytes */
-        NULL, /* Task input parameter */
-        rtl_433_ReceiverTask_Priority, /* Priority of the task (set lower than core task) */
-        &rtl_433_ReceiverHandle, /* Task handle. */
-        rtl_433_ReceiverTask_Core); /* Core where the task should run */
-  }
 }
 
 /**
- * @brief Is a signal available for decoding ?
+ * @brief Start direct reception, the receiver gpio follows the demodulated
+ * signal
  * 
- * @return int - which pulse train
  */
-int rtl_433_ESP::receivePulseTrain() {
-  if (_pulseTrains[_avaiablePulseTrain].num_pulses > 0) {
-    uint8_t _currentTrain = _avaiablePulseTrain;
-    _avaiablePulseTrain = (_avaiablePulseTrain + 1) % RECEIVER_BUFFER_SIZE;
-    return _currentTrain;
-  }
-  return -1;
-}
-
-/**
- * @brief Main pulse receiver logic
- * 
- */
-void ICACHE_RAM_ATTR rtl_433_ESP::interruptHandler() {
-  if (!_enabledReceiver || !receiveMode) {
-    _noiseCount++;
-    return;
-  }
-  volatile pulse_data_t& pulseTrain = _pulseTrains[_actualPulseTrain];
-  volatile int* pulse = pulseTrain.pulse;
-  volatile int* gap = pulseTrain.gap;
-#ifdef SIGNAL_RSSI
-  volatile int* rssi = pulseTrain.rssi;
-#endif
-
-  const unsigned long now = micros();
-  const unsigned int duration = now - _lastChange;
-
-  /* We first do some filtering (same as pilight BPF) */
-
-#ifdef RF_CC1101
-  if (duration > MINIMUM_PULSE_LENGTH && currentRssi > rssiThreshold)
+void rtl_433_ESP::startReceive() {
+#if defined(RF_SX1276) || defined(RF_SX1278)
+  int state = radio.receiveDirect();
 #else
-  if (duration > MINIMUM_PULSE_LENGTH) // SX127X RSSI Value drops for a 0 value,
-  // and the OOK floor compensates for this
-#endif
-  {
-#ifdef SIGNAL_RSSI
-    rssi[_nrpulses] = currentRssi;
+  int state = radio.receiveDirectAsync();
 #endif
-    if (!digitalRead(receiverGpio)) {
-      pulse[_nrpulses] = duration;
-
-      //      _nrpulses = (uint16_t)((_nrpulses + 1) % PD_MAX_PULSES);
-    } else {
-      if (pulse[_nrpulses] > 0) // Did we collect a + pulse ?
-      {
-        gap[_nrpulses] = duration;
-
-        _nrpulses = (uint16_t)((_nrpulses + 1) % PD_MAX_PULSES);
-      } else if (_nrpulses > 1) { // Have we received any data ?
-        // We received a random positive blib
-        gap[_nrpulses - 1] += duration;
-      } else {
-        gap[_nrpulses] = duration;
-
-        _nrpulses = (uint16_t)((_nrpulses + 1) % PD_MAX_PULSES);
-      }
-    }
-    _lastChange = now;
-  }
+  RADIOLIB_STATE(state, "receiveDirect");
 }
 
 /**
- * @brief Reset received signal storage
+ * @brief Retune the receiver to OOK or FSK, the pulse trains received after
+ * are decoded by the decoders of the modulation
  * 
+ * @param ook 
+ * @return true 
  */
-void rtl_433_ESP::resetReceiver() {
-  for (unsigned int i = 0; i < RECEIVER_BUFFER_SIZE; i++) {
-    _pulseTrains[i].num_pulses = 0;
+bool rtl_433_ESP::setModulation(bool ook) {
+  if (ook == ookModulation) {
+    return true;
   }
-  _avaiablePulseTrain = 0;
-  _actualPulseTrain = 0;
-  _nrpulses = 0;
+  int state = radio.standby();
+  RADIOLIB_STATE(state, "standby");
+  ookModulation = ook;
+  configureModulation();
+  startReceive();
+#ifdef DEMOD_DEBUG
+  logprintfLn(LOG_INFO, "Modulation: %s", ook ? "OOK" : "FSK");
+#endif
+  return true;
+}
 
-  receiveMode = false;
-  signalStart = micros();
+bool rtl_433_ESP::setOOKModulation() {
+  return setModulation(true);
 }
 
-/**
- * @brief Enable signal receiver logic
- * 
- * @param inputPin 
- */
-void rtl_433_ESP::enableReceiver() {
-  if (receiverGpio >= 0) {
-    pinMode(receiverGpio, INPUT);
-    attachInterrupt((uint8_t)receiverGpio, interruptHandler, CHANGE);
-    _enabledReceiver = true;
-  }
+bool rtl_433_ESP::setFSKModulation() {
+  return setModulation(false);
 }
 
+#if defined(AUTOOOKFIX) && (defined(RF_SX1276) || defined(RF_SX1278))
 /**
- * @brief Disable receiver logic, and pulse receiver
+ * @brief Raise the OOK floor threshold, too much noise was received between signals
  * 
  */
-void rtl_433_ESP::disableReceiver() {
-  _enabledReceiver = false;
-  detachInterrupt((uint8_t)receiverGpio);
+void rtl_433_ESP::raiseOokFixedThreshold() {
+  OokFixedThreshold = _mod->SPIreadRegister(RADIOLIB_SX127X_REG_OOK_FIX);
+#  ifdef REGOOKFIX_DEBUG
+  logprintfLn(LOG_DEBUG,
+              "RegOokFix Threshold Adjust noise count %d, RegOokFix 0x%.2x",
+              _noiseCount, OokFixedThreshold);
+#  endif
+  int state = radio.setOokFixedOrFloorThreshold(++OokFixedThreshold);
+  RADIOLIB_STATE(state, "OokFixedThreshold");
 }
+#endif
 
 /**
- * @brief watch for completed signals being received, and pass to decoder logic
+ * @brief Receiver housekeeping, completed signals are passed to the decoder
+ * by rtl_433_ReceiverTask
  * 
  */
 void rtl_433_ESP::loop() {
@@ -456,42 +373,6 @@ void rtl_433_ESP::loop() {
     } // workaround for a deaf CC1101
 #endif
 
-    int _receiveTrain = receivePulseTrain();
-    if (_receiveTrain != -1) // Is there anything to receive ?
-    {
-#ifdef MEMORY_DEBUG
-      logprintfLn(LOG_INFO, "Pre copy out of train: %d", ESP.getFreeHeap());
-#endif
-      pulse_data_t* rtl_pulses = (pulse_data_t*)heap_caps_calloc(1, sizeof(pulse_data_t), MALLOC_CAP_INTERNAL);
-      memcpy(rtl_pulses, (char*)&_pulseTrains[_receiveTrain], sizeof(pulse_data_t));
-      _pulseTrains[_receiveTrain].num_pulses = 0; // Make pulse train available for next train
-      for (int x = 0; x < PD_MAX_PULSES; x++) {
-        _pulseTrains[_receiveTrain].pulse[x] = 0;
-        _pulseTrains[_receiveTrain].gap[x] = 0;
-#ifdef SIGNAL_RSSI
-        _pulseTrains[_receiveTrain].rssi[x] = 0;
-#endif
-      }
-#ifdef MEMORY_DEBUG
-      logprintfLn(LOG_INFO, "Post copy out of train: %d", ESP.getFreeHeap());
-#endif
-
-      if (rtl_pulses->num_pulses > PD_MIN_PULSES) {
-        processSignal(rtl_pulses); // send received signal for decoding
-      } else {
-        ignoredSignals++;
-#ifdef MEMORY_DEBUG
-        logprintfLn(LOG_INFO, "Pre free copy out of train: %d",
-                    ESP.getFreeHeap());
-#endif
-        free(rtl_pulses);
-#ifdef MEMORY_DEBUG
-        logprintfLn(LOG_INFO, "Post free copy out of train: %d",
-                    ESP.getFreeHeap());
-#endif
-      }
-    }
-
     // Adjust RegOokFix threshold
 
     if ((totalSignals % 100) == 0 && totalSignals != 0) {
@@ -527,140 +408,6 @@ void rtl_433_ESP::loop() {
   vTaskDelay(1);
 }
 
-/**
- * @brief Background task to monitor RSSI signal level and start / end signal receiving
- * 
- * @param pvParameters 
- */
-void rtl_433_ESP::rtl_433_ReceiverTask(void* pvParameters) {
-  for (;;) {
-    if (_enabledReceiver) {
-      // Calculate average RSSI signal level in environment
-
-      currentRssi = _getRSSI();
-      _rssiCount++;
-      _totalRssi += currentRssi;
-
-      if (_rssiCount > RSSI_SAMPLES) // Adjust RSSI Signal Threshold
-      {
-        averageRssi = _totalRssi / _rssiCount;
-
-#ifdef AUTORSSITHRESHOLD
-        rssiThreshold = averageRssi + rssiThresholdDelta;
-        logprintfLn(LOG_DEBUG,
-                    "Average RSSI Signal %d dbm, adjusted RSSI Threshold %d, "
-                    "samples %d",
-                    averageRssi, rssiThreshold, RSSI_SAMPLES);
-#endif
-
-        _totalRssi = 0;
-        _rssiCount = 0;
-      }
-
-      if (currentRssi > rssiThreshold) // A signal is present
-      {
-        if (!receiveMode) {
-          receiveMode = true;
-          signalStart = micros();
-#ifdef ONBOARD_LED
-          digitalWrite(ONBOARD_LED, HIGH);
-#endif
-          signalRssi = currentRssi;
-          _lastChange = micros();
-
-          if (_noiseCount > 100) {
-#ifdef AUTOOOKFIX
-#  if defined(RF_SX1276) || defined(RF_SX1278)
-            OokFixedThreshold =
-                _mod->SPIreadRegister(RADIOLIB_SX127X_REG_OOK_FIX);
-#    ifdef REGOOKFIX_DEBUG
-            logprintfLn(
-                LOG_DEBUG,
-                "RegOokFix Threshold Adjust noise count %d, RegOokFix 0x%.2x",
-                _noiseCount, OokFixedThreshold);
-#    endif
-            int state = radio.setOokFixedOrFloorThreshold(++OokFixedThreshold);
-            RADIOLIB_STATE(state, "OokFixedThreshold");
-#  endif
-#endif
-            _noiseCount = 0;
-          }
-        }
-        signalEnd = micros();
-      }
-#if defined(RF_SX1276) || defined(RF_SX1278)
-      // If we received a signal but had a minor drop in strength keep the
-      // receiver running for an additional 150,000
-      else if (micros() - signalEnd < MINIMUM_SIGNAL_LENGTH)
-#else
-      // If we received a signal but had a minor drop in strength keep the
-      // receiver running for an additional 40,000
-      else if (micros() - signalEnd < MINIMUM_SIGNAL_LENGTH && micros() - signalStart > 30000)
-      // else if (micros() - signalEnd < PD_MAX_GAP_MS)
-#endif
-      {
-        // skip over signal drop outs
-      } else // A signal is not present
-      {
-        if (receiveMode) // Complete reception of a signal
-        {
-#ifdef ONBOARD_LED
-          digitalWrite(ONBOARD_LED, LOW);
-#endif
-          receiveMode = false;
-          totalSignals++;
-          if ((_nrpulses > PD_MIN_PULSES) &&
-              ((signalEnd - signalStart) >
-               MINIMUM_SIGNAL_LENGTH)) // Minimum signal length of MINIMUM_SIGNAL_LENGTH MS
-          {
-            _pulseTrains[_actualPulseTrain].num_pulses = _nrpulses + 1;
-            _pulseTrains[_actualPulseTrain].signalDuration =
-                signalEnd - signalStart;
-            _pulseTrains[_actualPulseTrain].signalRssi = signalRssi;
-#ifdef DEMOD_DEBUG
-            logprintf(LOG_INFO, "Signal length: %lu",
-                      _pulseTrains[_actualPulseTrain].signalDuration);
-            alogprintf(LOG_INFO, ", Gap length: %lu", signalStart - gapStart);
-            alogprintf(LOG_INFO, ", Signal RSSI: %d",
-                       _pulseTrains[_actualPulseTrain].signalRssi);
-            alogprintf(LOG_INFO, ", train: %d", _actualPulseTrain);
-            alogprintf(LOG_INFO, ", messageCount: %d", messageCount);
-            alogprintfLn(LOG_INFO, ", pulses: %d", _nrpulses);
-#endif
-            messageCount++;
-            gapStart = micros();
-            _actualPulseTrain = (_actualPulseTrain + 1) % RECEIVER_BUFFER_SIZE;
-            _nrpulses = 0;
-          } else {
-            ignoredSignals++;
-#ifdef DEMOD_DEBUG
-            if (micros() - signalStart > 1000) {
-              logprintf(LOG_INFO, "Ignored Signal length: %lu",
-                        signalEnd - signalStart);
-
-              alogprintf(LOG_INFO, ", Time since last bit length: %lu",
-                         micros() - signalEnd);
-              alogprintf(LOG_INFO, ", Gap length: %lu", signalStart - gapStart);
-              alogprintf(LOG_INFO, ", Signal RSSI: %d", signalRssi);
-              alogprintf(LOG_INFO, ", Current RSSI: %d", currentRssi);
-              alogprintf(LOG_INFO, ", pulses: %d", _nrpulses);
-              alogprintfLn(LOG_INFO, ", noise count: %d", _noiseCount);
-              gapStart = micros();
-            }
-#endif
-            _nrpulses = 0;
-          }
-#ifdef MEMORY_DEBUG
-          logprintfLn(LOG_INFO,
-                      "rtl_433_ReceiverTask uxTaskGetStackHighWaterMark: %d", uxTaskGetStackHighWaterMark(NULL));
-#endif
-        }
-      }
-    }
-    vTaskDelay(1);
-  }
-}
-
 /**
  * @brief Client callback to receive decoded signals
  * 
@@ -668,16 +415,14 @@ void rtl_433_ESP::rtl_433_ReceiverTask(void* pvParameters) {
  * @param messageBuffer 
  * @param bufferSize 
  */
-rtl_433_ESPCallBack _callback; // TODO: Use global object
-char* _messageBuffer;
-int _bufferSize;
-
 void rtl_433_ESP::setCallback(rtl_433_ESPCallBack callback, char* messageBuffer,
                               int bufferSize) {
   // logprintfLn(LOG_DEBUG, "rtl_433_ESP::setCallback location: %p", callback);
-  _callback = callback;
-  _messageBuffer = messageBuffer;
-  _bufferSize = bufferSize;
+  _setCallback(callback, messageBuffer, bufferSize);
+}
+
+void rtl_433_ESP::setCallback(rtl_433_ESPBinaryCallBack callback,
+                              uint8_t* messageBuffer, int bufferSize) {
   _setCallback(callback, messageBuffer, bufferSize);
 }
 
@@ -729,10 +474,20 @@ void rtl_433_ESP::setDebug(int debug) {
  * @param status 
  */
 void rtl_433_ESP::getStatus() {
+  pulse_classifier_stats_t decoderStats;
+  getDecoderStats(&decoderStats);
+  unsigned long decodeLatency = rtl_433_DecodeLatency.count
+                                    ? rtl_433_DecodeLatency.total / rtl_433_DecodeLatency.count
+                                    : 0;
+  unsigned long decodeTime = rtl_433_DecodeTime.count
+                                 ? rtl_433_DecodeTime.total / rtl_433_DecodeTime.count
+                                 : 0;
+
   alogprintfLn(LOG_INFO, " ");
   logprintf(LOG_INFO, "Status Message: Gap length: %lu",
-            signalStart - gapStart);
+            (unsigned long)gapLength());
   alogprintf(LOG_INFO, ", Modulation: %s", ookModulation ? "OOK" : "FSK");
+  alogprintf(LOG_INFO, ", modulationSwitches: %lu", modulationSwitches());
   alogprintf(LOG_INFO, ", Signal RSSI: %d", signalRssi);
   alogprintf(LOG_INFO, ", train: %d", _actualPulseTrain);
   alogprintf(LOG_INFO, ", messageCount: %d", messageCount);
@@ -740,6 +495,17 @@ void rtl_433_ESP::getStatus() {
   alogprintf(LOG_INFO, ", signalRatio: %d", signalRatio);
   alogprintf(LOG_INFO, ", ignoredSignals: %d", ignoredSignals);
   alogprintf(LOG_INFO, ", unparsedSignals: %d", unparsedSignals);
+  alogprintf(LOG_INFO, ", decodedSignals: %lu", rtl_433_DecodedSignals);
+  alogprintf(LOG_INFO, ", overwrittenSignals: %lu", rtl_433_OverwrittenSignals);
+  alogprintf(LOG_INFO, ", droppedSignals: %lu", rtl_433_DroppedSignals);
+  alogprintf(LOG_INFO, ", slicerRuns: %u", decoderStats.runs);
+  alogprintf(LOG_INFO, ", slicerSkipped: %u", decoderStats.skipped);
+  alogprintf(LOG_INFO, ", slicesSaved: %u", decoderStats.shared);
+  alogprintf(LOG_INFO, ", decodeLatency: %lu", decodeLatency);
+  alogprintf(LOG_INFO, ", decodeLatencyMax: %lu", rtl_433_DecodeLatency.max);
+  alogprintf(LOG_INFO, ", decoders: %u", (unsigned)g_cfg.demod->r_devs.len);
+  alogprintf(LOG_INFO, ", decodeTime: %lu", decodeTime);
+  alogprintf(LOG_INFO, ", truncatedMessages: %u", g_cfg.truncatedMessages);
   alogprintf(LOG_INFO, ", _enabledReceiver: %d", _enabledReceiver);
   alogprintf(LOG_INFO, ", receiveMode: %d", receiveMode);
   alogprintf(LOG_INFO, ", currentRssi: %d", currentRssi);
@@ -747,7 +513,7 @@ void rtl_433_ESP::getStatus() {
   alogprintf(LOG_INFO, ", StackHWM: %d", uxTaskGetStackHighWaterMark(NULL));
   alogprintf(LOG_INFO, ", RTL_HWM: %d", uxTaskGetStackHighWaterMark(rtl_433_ReceiverHandle));
   alogprintf(LOG_INFO, ", DCD_HWM: %d", uxTaskGetStackHighWaterMark(rtl_433_DecoderHandle));
-  alogprintfLn(LOG_INFO, ", pulses: %d", _nrpulses);
+  alogprintfLn(LOG_INFO, ", pulses: %d", receivedPulses());
 
   data_t* data;
 
@@ -756,6 +522,7 @@ void rtl_433_ESP::getStatus() {
                 "model",          "", DATA_STRING,  "status",
                 "protocol",       "", DATA_STRING,  "rtl_433_ESP status message",
                 "modulation",     "", DATA_STRING,  ookModulation ? "OOK" : "FSK",
+                "modulationSwitches", "", DATA_INT, (int)modulationSwitches(),
                 "RTLRssi",        "", DATA_INT,     currentRssi,
                 "RTLAVGRssi",     "", DATA_INT,     averageRssi,
                 "RTLRssiThresh",  "", DATA_INT,     rssiThreshold,
@@ -771,6 +538,17 @@ void rtl_433_ESP::getStatus() {
                 "signalRatio",    "", DATA_INT, signalRatio,
                 "ignoredSignals", "", DATA_INT, ignoredSignals,
                 "unparsedSignals", "", DATA_INT, unparsedSignals,
+                "decodedSignals", "", DATA_INT, (int)rtl_433_DecodedSignals,
+                "overwrittenSignals", "", DATA_INT, (int)rtl_433_OverwrittenSignals,
+                "droppedSignals", "", DATA_INT, (int)rtl_433_DroppedSignals,
+                "slicerRuns",     "", DATA_INT, decoderStats.runs,
+                "slicerSkipped",  "", DATA_INT, decoderStats.skipped,
+                "slicesSaved",    "", DATA_INT, decoderStats.shared,
+                "decodeLatency",  "", DATA_INT, (int)decodeLatency,
+                "decodeLatencyMax", "", DATA_INT, (int)rtl_433_DecodeLatency.max,
+                "decoders",       "", DATA_INT, (int)g_cfg.demod->r_devs.len,
+                "decodeTime",     "", DATA_INT, (int)decodeTime,
+                "truncatedMessages", "", DATA_INT, g_cfg.truncatedMessages,
                 "StackHWM",       "", DATA_INT, uxTaskGetStackHighWaterMark(NULL),
                 "RTL_HWM",        "", DATA_INT, uxTaskGetStackHighWaterMark(rtl_433_ReceiverHandle),
                 "DCD_HWM",        "", DATA_INT, uxTaskGetStackHighWaterMark(rtl_433_DecoderHandle),
@@ -782,8 +560,7 @@ void rtl_433_ESP::getStatus() {
   getModuleStatus();
 #endif
 
-  data_print_jsons(data, _messageBuffer, _bufferSize);
-  (_callback)(_messageBuffer);
+  r_output_message(&g_cfg, data);
   data_free(data);
 }
 
@@ -30,7 +30,9 @@
 
 #include <functional>
 
+#include "edgeSource.h"
 #include "log.h"
+#include "noiseFloor.h"
 #include "tools/aprintf.h"
 
 // ESP32 doesn't define ICACHE_RAM_ATTR
@@ -59,7 +61,8 @@
 #  define DEAF_WORKAROUND
 #endif
 
-// Number of rssi results to collect for average calculation
+// Number of rssi results to collect for average calculation, and between
+// logging of the RSSI Signal threshold
 #ifndef RSSI_SAMPLES
 #  define RSSI_SAMPLES 50000
 #endif
@@ -74,26 +77,77 @@
 #  define AUTORSSITHRESHOLD true
 #endif
 
+// Noise floor estimate the RSSI Signal threshold is based on, see noiseFloor.h
+#define NOISE_FLOOR_BLOCK    0 // Average of RSSI_SAMPLES
+#define NOISE_FLOOR_EWMA     1 // Moving average, ignores signals
+#define NOISE_FLOOR_QUANTILE 2 // 30th percentile of 2 second windows
+#define NOISE_FLOOR_MIN      3 // Minimum, rising 1 dB per second
+#ifndef NOISE_FLOOR
+#  define NOISE_FLOOR NOISE_FLOOR_MIN
+#endif
+
 // #define AUTOOOKFIX true      // Has shown to be problematic
 
-// Pulse train buffer count
-#define RECEIVER_BUFFER_SIZE 2
+// Pulse train buffer count, shared between the receiver and the decoder queue,
+// at most RECEIVER_BUFFER_MAX, see setReceiverBuffers
+#ifndef RECEIVER_BUFFER_SIZE
+#  define RECEIVER_BUFFER_SIZE 4
+#endif
+#define RECEIVER_BUFFER_MAX 32
+
+// Pulse trains waiting for the decoder, at most RECEIVER_BUFFER_SIZE
+#ifndef DECODER_QUEUE_DEPTH
+#  define DECODER_QUEUE_DEPTH RECEIVER_BUFFER_SIZE
+#endif
+
+// Signal shed when no pulse train is free or the decoder queue is full, see
+// setShedPolicy
+#define SHED_DROP_NEWEST    0 // Discard the new signal
+#define SHED_DROP_OLDEST    1 // Overwrite the longest waiting pulse train
+#define SHED_KEEP_STRONGEST 2 // Discard the weakest signalRssi, new or waiting
+#ifndef SHED_POLICY
+#  define SHED_POLICY SHED_DROP_NEWEST
+#endif
 
 // #define MAXPULSESTREAMLENGTH 750 // Pulse train buffer size
 
+// Receiver edges queued between the interrupt handler and the receiver task,
+// a power of two, the task drains the queue every tick
+#ifndef EDGE_RING_SIZE
+#  define EDGE_RING_SIZE 256
+#endif
+
 // Set to false to enable FSK demodulators ( Experimental )
 #ifndef OOK_MODULATION
 #  define OOK_MODULATION true
 #endif
 
+// Register both the OOK and the FSK demodulators, and alternate the receiver
+// between OOK_WINDOW and FSK_WINDOW milliseconds of each, starting with
+// OOK_MODULATION. See setModulationSchedule
+#ifndef DUAL_MODULATION
+#  define DUAL_MODULATION false
+#endif
+#ifndef OOK_WINDOW
+#  define OOK_WINDOW 5000
+#endif
+#ifndef FSK_WINDOW
+#  define FSK_WINDOW 5000
+#endif
+
 // signals shorter than this are ignored in interrupt handler
 
+#define OOK_MINIMUM_PULSE_LENGTH  50
+#define OOK_MINIMUM_SIGNAL_LENGTH 40000
+#define FSK_MINIMUM_PULSE_LENGTH  30
+#define FSK_MINIMUM_SIGNAL_LENGTH 500
+
 #if OOK_MODULATION
-#  define MINIMUM_PULSE_LENGTH  50
-#  define MINIMUM_SIGNAL_LENGTH 40000
+#  define MINIMUM_PULSE_LENGTH  OOK_MINIMUM_PULSE_LENGTH
+#  define MINIMUM_SIGNAL_LENGTH OOK_MINIMUM_SIGNAL_LENGTH
 #else
-#  define MINIMUM_PULSE_LENGTH  30
-#  define MINIMUM_SIGNAL_LENGTH 500
+#  define MINIMUM_PULSE_LENGTH  FSK_MINIMUM_PULSE_LENGTH
+#  define MINIMUM_SIGNAL_LENGTH FSK_MINIMUM_SIGNAL_LENGTH
 #endif
 
 // SX127X OOK Reception Floor
@@ -227,6 +281,13 @@
  */
 typedef void (*rtl_433_ESPCallBack)(char* message);
 
+/**
+ * message - CBOR (RFC 8949) encoded message from device
+ * length  - length of the encoded message
+ */
+typedef void (*rtl_433_ESPBinaryCallBack)(const uint8_t* message,
+                                          size_t length);
+
 typedef std::function<void(const uint16_t* pulses, size_t length)>
     PulseTrainCallBack;
 
@@ -257,6 +318,19 @@ public:
   void setCallback(rtl_433_ESPCallBack callback, char* messageBuffer,
                    int bufferSize);
 
+  /**
+   * Set binary message received callback function, messages are encoded as
+   * CBOR maps with the same fields as the JSON messages
+   *
+   * callback function signature
+   *
+   * (const uint8_t *message, size_t length)
+   * message - CBOR encoded message from device
+   * length  - length of the encoded message
+   */
+  void setCallback(rtl_433_ESPBinaryCallBack callback, uint8_t* messageBuffer,
+                   int bufferSize);
+
   /**
    * Set minimum RSSI value for receiver
    */
@@ -289,6 +363,67 @@ public:
    */
   static void disableReceiver();
 
+  /**
+   * Receive edges and signal strength from source instead of the receiver
+   * gpio and the transceiver RSSI, see edgeSource.h. Set before initReceiver
+   * to replace the gpio source.
+   */
+  static void setEdgeSource(EdgeSource* source);
+
+  /**
+   * Estimate the RSSI noise floor, the base of the RSSI Signal threshold, with
+   * estimator instead of the NOISE_FLOOR ones, one for each modulation,
+   * nullptr restores them. See noiseFloor.h.
+   */
+  static void setNoiseFloor(NoiseFloor* estimator);
+
+  /**
+   * Number of pulse trains and depth of the decoder queue, set before
+   * initReceiver. Defaults to RECEIVER_BUFFER_SIZE and DECODER_QUEUE_DEPTH.
+   */
+  static void setReceiverBuffers(int trains, int queueDepth);
+
+  /**
+   * Signal to shed when a signal starts with every pulse train waiting for the
+   * decoder, or ends with the decoder queue full, SHED_DROP_NEWEST,
+   * SHED_DROP_OLDEST or SHED_KEEP_STRONGEST.
+   */
+  static void setShedPolicy(int policy);
+
+  /**
+   * Alternate the receiver between ookMillis of OOK and fskMillis of FSK
+   * reception, a modulation with 0 is not received. Receiving the modulation
+   * not selected by ookModulation needs dualModulation.
+   */
+  static void setModulationSchedule(uint32_t ookMillis, uint32_t fskMillis);
+
+  /**
+   * Enable or disable the decoders whose name contains name, ignoring case,
+   * "" for all, without a restart. Decoders disabled by default are only
+   * enabled by setDecoder. Returns the number of decoders changed, -1 before
+   * initReceiver. The decode time of the status message starts over.
+   */
+  static int setDecoders(const char* name, bool enabled);
+
+  /**
+   * Enable or disable the decoder with protocol number protocolNum, its
+   * position in rtl_433_Devices ( see RTL_VERBOSE )
+   */
+  static int setDecoder(unsigned protocolNum, bool enabled);
+
+  /**
+   * Enable or disable the decoders of a modulation, e.g. OOK_PULSE_PWM, see
+   * r_device.h
+   */
+  static int setModulationDecoders(unsigned modulation, bool enabled);
+
+  /**
+   * One tick of the receiver task: poll the edge source, follow the signal
+   * strength and pass completed signals to the decoder. Called by the
+   * receiver task, or directly to drive the receiver in virtual time.
+   */
+  static void receiverTick();
+
   /**
    * For SX127x transceiver module, Optimizing the OOK Floor Threshold
    */
@@ -359,9 +494,9 @@ public:
 
   static uint8_t OokFixedThreshold;
 
-  /*----------------------------- Future features -----------------------------*/
   /**
- * @brief OOK/FSK Modulation
+ * @brief OOK/FSK Modulation the receiver is tuned to, set before initReceiver
+ * for the initial one
  * true = OOK
  * false = FSK
  * 
@@ -369,15 +504,23 @@ public:
   static bool ookModulation;
 
   /**
-   * @brief change receiver to OOK Modulation
-   * Experimental feature, currently not functional
+   * @brief Register the OOK and the FSK decoders, set before initReceiver.
+   * Defaults to DUAL_MODULATION. Each pulse train is decoded by the decoders
+   * of the modulation it was received with.
+   */
+  static bool dualModulation;
+
+  /**
+   * @brief change receiver to OOK Modulation, normally done by the modulation
+   * schedule. The OOK decoders are registered unless ookModulation was false
+   * at initReceiver without dualModulation.
    */
   static bool setOOKModulation();
 
   /**
-   * @brief change receiver to FSK Modulation
-   * Experimental feature, currently not functional
-   *
+   * @brief change receiver to FSK Modulation, normally done by the modulation
+   * schedule. The FSK decoders are registered if ookModulation was false at
+   * initReceiver or with dualModulation.
    */
   static bool setFSKModulation();
 
@@ -385,12 +528,15 @@ private:
   int8_t _outputPin;
 
   /**
-   * interruptHandler is called on every change in the input
-   * signal. If RcPilight::initReceiver is called with interrupt <0,
-   * you have to call interruptHandler() yourself. (Or use
-   * InterruptChain)
+   * receiveEdge is called by the edge source on every change in the input
+   * signal, from the gpio interrupt or from EdgeSource::poll()
+   */
+  static void receiveEdge(uint32_t time, bool level);
+
+  /**
+   * Assemble the edges queued by receiveEdge into the pulse train
    */
-  static void interruptHandler();
+  static void drainEdges();
 
   /**
    * interruptHandler used to calibrate OOK floor threshold
@@ -406,22 +552,34 @@ private:
 
   static int _getRSSI();
 
+#if defined(AUTOOOKFIX) && (defined(RF_SX1276) || defined(RF_SX1278))
+  static void raiseOokFixedThreshold();
+#endif
+
+  static void configureModulation();
+  static void startReceive();
+  static bool setModulation(bool ook);
+
+  /**
+   * Source of the receiver edges and signal strength
+   */
+  static EdgeSource* _source;
+
   /**
-   * Get last received PulseTrain.
-   * Returns: last PulseTrain or 0 if not available
+   * Noise floor estimate of the RSSI of every tick
    */
-  static int receivePulseTrain();
+  static NoiseFloor* _noiseFloor;
 
   /**
    * _enabledReceiver: If true, monitoring and decoding is enabled.
-   * If false, interruptHandler will return immediately.
+   * If false, receiveEdge will return immediately.
    */
   static bool _enabledReceiver;
   // static volatile pulse_data_t _pulseTrains[];
-  static volatile uint8_t _actualPulseTrain;
-  static uint8_t _avaiablePulseTrain;
-  static volatile unsigned long _lastChange;
-  static volatile int16_t _nrpulses;
+  /**
+   * Pulse train slot being received into, -1 when no slot is held
+   */
+  static volatile int8_t _actualPulseTrain;
   static int16_t _interrupt;
 
   static void rtl_433_ReceiverTask(void* pvParameters);
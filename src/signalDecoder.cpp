@@ -25,6 +25,9 @@
 
 #include "signalDecoder.h"
 
+#include <ctype.h>
+#include <limits.h>
+
 /*----------------------------- rtl_433_ESP Internals -----------------------------*/
 
 #ifndef rtl_433_Decoder_Stack
@@ -33,7 +36,7 @@
 #  elif defined(RTL_VERBOSE) || defined(RTL_DEBUG)
 #    define rtl_433_Decoder_Stack 30000
 #  else
-#    if OOK_MODULATION
+#    if OOK_MODULATION && !DUAL_MODULATION
 #      define rtl_433_Decoder_Stack 11500
 #    else
 #      define rtl_433_Decoder_Stack 20000
@@ -44,14 +47,687 @@
 #define rtl_433_Decoder_Priority 2
 #define rtl_433_Decoder_Core     1
 
+#define rtl_433_Helper_Priority 1 // below the receiver task sharing core 0
+#define rtl_433_Helper_Core     0
+
 /*----------------------------- rtl_433_ESP Internals -----------------------------*/
 
 int rtlVerbose = 0;
 
 r_cfg_t g_cfg; // Global config object
 
+/**
+ * Pulse train slots, filled by the receiver and decoded in place. Ownership of
+ * a slot is passed by index, rtl_433_Queue holds slots waiting to be decoded
+ * and rtl_433_FreeQueue the slots available for reception.
+ */
+pulse_data_t* rtl_433_PulseTrains;
+
+/**
+ * Scratch state of the decoder task, slicer bitbuffer and slicer counters
+ */
+decode_ctx_t* rtl_433_DecodeCtx;
+
 TaskHandle_t rtl_433_DecoderHandle;
 static QueueHandle_t rtl_433_Queue;
+static QueueHandle_t rtl_433_FreeQueue;
+
+/**
+ * End of signal to first callback latency of the decoded pulse trains
+ */
+decodeLatency_t rtl_433_DecodeLatency;
+
+/**
+ * Time in the decoders per pulse train, starts over when decoders are
+ * enabled or disabled
+ */
+decodeLatency_t rtl_433_DecodeTime;
+
+/**
+ * Held by the decoder task while it decodes a pulse train, and while the
+ * registered decoders change
+ */
+static SemaphoreHandle_t rtl_433_DecoderLock;
+
+/**
+ * Number of pulse trains and depth of rtl_433_Queue, fixed by rtlSetup
+ */
+uint8_t rtl_433_ReceiverBuffers = RECEIVER_BUFFER_SIZE;
+uint8_t rtl_433_QueueDepth = DECODER_QUEUE_DEPTH;
+
+/**
+ * Signal shed when no pulse train is free or rtl_433_Queue is full
+ */
+volatile uint8_t rtl_433_ShedPolicy = SHED_POLICY;
+
+/**
+ * Pulse trains placed on rtl_433_Queue, and decoded by rtl_433_DecoderTask or
+ * taken back from the queue for another signal. Queued equals decoded plus
+ * overwritten when the decoder is idle. Dropped signals were never queued.
+ */
+volatile unsigned long rtl_433_QueuedSignals = 0;
+volatile unsigned long rtl_433_DecodedSignals = 0;
+volatile unsigned long rtl_433_OverwrittenSignals = 0;
+volatile unsigned long rtl_433_DroppedSignals = 0;
+static rtl_433_ESPCallBack rtl_433_UserCallback;
+static rtl_433_ESPBinaryCallBack rtl_433_UserBinaryCallback;
+static pulse_data_t* rtl_433_LatencyTrain; // train waiting for its first callback
+
+static void recordLatency() {
+  if (rtl_433_LatencyTrain) {
+    unsigned long latency = micros() - rtl_433_LatencyTrain->signalEnd;
+    rtl_433_DecodeLatency.count++;
+    rtl_433_DecodeLatency.total += latency;
+    if (latency > rtl_433_DecodeLatency.max) {
+      rtl_433_DecodeLatency.max = latency;
+    }
+    rtl_433_LatencyTrain = NULL;
+  }
+}
+
+static void latencyCallback(char* message) {
+  recordLatency();
+  rtl_433_UserCallback(message);
+}
+
+static void latencyBinaryCallback(const uint8_t* message, size_t length) {
+  recordLatency();
+  rtl_433_UserBinaryCallback(message, length);
+}
+
+#ifdef PARALLEL_DECODE
+/**
+ * Parallel decode, the registered decoders are split between the decoder task
+ * and a helper task on the other core. For every priority pass both tasks run
+ * their half against the same read-only pulse train, the decoder task then
+ * merges the events and the next priority, so a lower priority pass still only
+ * runs if no events were produced. The messages of both tasks are held until
+ * the pass is merged and output from the decoder task, in the order the
+ * decoders run without PARALLEL_DECODE.
+ */
+typedef struct {
+  r_device* r_dev;
+  data_t* data;
+} deferredOutput_t;
+
+/**
+ * Messages of one task in the current pass, in the order its decoders run.
+ * There is an entry per decoder of the task, grown only for a pass with more
+ * messages than that.
+ */
+typedef struct {
+  deferredOutput_t* entries;
+  unsigned count;
+  unsigned size;
+} deferredOutputs_t;
+
+static list_t rtl_433_DecoderDevices; // run by the decoder task
+static list_t rtl_433_HelperDevices; // run by the helper task
+static demod_dispatch_t rtl_433_DecoderDispatch;
+static demod_dispatch_t rtl_433_HelperDispatch;
+static deferredOutputs_t rtl_433_DecoderOutput;
+static deferredOutputs_t rtl_433_HelperOutput;
+static unsigned* rtl_433_OutputOrder; // by protocol number, the run order without PARALLEL_DECODE
+static unsigned rtl_433_OutputOrderSize;
+static decode_ctx_t* rtl_433_HelperCtx;
+static SemaphoreHandle_t rtl_433_HelperStart;
+static SemaphoreHandle_t rtl_433_HelperDone;
+TaskHandle_t rtl_433_HelperHandle;
+
+static struct {
+  pulse_data_t* train;
+  unsigned priority;
+  unsigned nextPriority;
+  int events;
+} rtl_433_HelperPass;
+
+static void deferOutput(deferredOutputs_t* outputs, r_device* r_dev, data_t* data) {
+  if (!rtl_433_HelperPass.train) {
+    // decoder run directly, outside of a parallel decode
+    data_acquired_handler(r_dev, data);
+    return;
+  }
+  if (outputs->count == outputs->size) {
+    unsigned size = outputs->size ? outputs->size * 2 : 1;
+    deferredOutput_t* entries = (deferredOutput_t*)realloc(outputs->entries, size * sizeof(deferredOutput_t));
+    if (!entries) {
+      WARN_REALLOC("deferOutput()");
+      data_free(data);
+      return;
+    }
+    outputs->entries = entries;
+    outputs->size = size;
+  }
+  outputs->entries[outputs->count].r_dev = r_dev;
+  outputs->entries[outputs->count].data = data;
+  outputs->count++;
+}
+
+static void deferDecoderOutput(r_device* r_dev, data_t* data) {
+  deferOutput(&rtl_433_DecoderOutput, r_dev, data);
+}
+
+static void deferHelperOutput(r_device* r_dev, data_t* data) {
+  deferOutput(&rtl_433_HelperOutput, r_dev, data);
+}
+
+static unsigned outputOrder(r_device* r_dev) {
+  return r_dev->protocol_num < rtl_433_OutputOrderSize ? rtl_433_OutputOrder[r_dev->protocol_num] : UINT_MAX;
+}
+
+/**
+ * Output the messages of both tasks merged by the order of their decoders
+ */
+static void flushDeferredOutput() {
+  deferredOutputs_t* outputs[2] = {&rtl_433_DecoderOutput, &rtl_433_HelperOutput};
+  unsigned next[2] = {0, 0};
+  while (next[0] < outputs[0]->count || next[1] < outputs[1]->count) {
+    int from;
+    if (next[0] == outputs[0]->count) {
+      from = 1;
+    } else if (next[1] == outputs[1]->count) {
+      from = 0;
+    } else {
+      from = outputOrder(outputs[1]->entries[next[1]].r_dev) <
+                     outputOrder(outputs[0]->entries[next[0]].r_dev)
+                 ? 1
+                 : 0;
+    }
+    deferredOutput_t* output = &outputs[from]->entries[next[from]++];
+    data_acquired_handler(output->r_dev, output->data);
+  }
+  outputs[0]->count = 0;
+  outputs[1]->count = 0;
+}
+
+/**
+ * Keep an entry per decoder of a task for its messages of a pass
+ */
+static void reserveDeferredOutput(deferredOutputs_t* outputs, unsigned size) {
+  if (size <= outputs->size) {
+    return;
+  }
+  deferredOutput_t* entries = (deferredOutput_t*)realloc(outputs->entries, size * sizeof(deferredOutput_t));
+  if (!entries) {
+    FATAL_REALLOC("reserveDeferredOutput()");
+  }
+  outputs->entries = entries;
+  outputs->size = size;
+}
+
+/**
+ * Split the registered decoders round robin between the two tasks, a slicing
+ * group stays together on the task of its leader
+ */
+static void partitionDecoders(r_cfg_t* cfg) {
+  list_clear(&rtl_433_DecoderDevices, NULL);
+  list_clear(&rtl_433_HelperDevices, NULL);
+  if (!rtl_433_OutputOrder) {
+    rtl_433_OutputOrder = (unsigned*)calloc(cfg->num_r_devices, sizeof(unsigned));
+    if (!rtl_433_OutputOrder) {
+      FATAL_CALLOC("partitionDecoders()");
+    }
+    rtl_433_OutputOrderSize = cfg->num_r_devices;
+  }
+  int next = 0;
+  unsigned order = 0;
+  for (void** iter = cfg->demod->r_devs.elems; iter && *iter; ++iter) {
+    r_device* r_dev = (r_device*)*iter;
+    if (r_dev->slice_follower) {
+      continue;
+    }
+    bool helper = next++ % 2;
+    for (r_device* member = r_dev; member; member = member->slice_next) {
+      list_push(helper ? &rtl_433_HelperDevices : &rtl_433_DecoderDevices,
+                member);
+      member->output_fn = helper ? deferHelperOutput : deferDecoderOutput;
+      // a group is decoded with its leader, so its messages follow those of the leader
+      if (member->protocol_num < rtl_433_OutputOrderSize) {
+        rtl_433_OutputOrder[member->protocol_num] = order++;
+      }
+    }
+  }
+  reserveDeferredOutput(&rtl_433_DecoderOutput, rtl_433_DecoderDevices.len);
+  reserveDeferredOutput(&rtl_433_HelperOutput, rtl_433_HelperDevices.len);
+  if (demod_dispatch_build(&rtl_433_DecoderDispatch, &rtl_433_DecoderDevices) ||
+      demod_dispatch_build(&rtl_433_HelperDispatch, &rtl_433_HelperDevices))
+    FATAL_CALLOC("partitionDecoders()");
+}
+
+static int runDemodsPass(decode_ctx_t* ctx, demod_dispatch_t* dispatch,
+                         pulse_data_t* rtl_pulses, unsigned priority,
+                         unsigned* nextPriority) {
+  return run_demods_pass(ctx,
+                         rtl_pulses->fskModulation ? &dispatch->fsk
+                                                   : &dispatch->ook,
+                         rtl_pulses, priority, nextPriority);
+}
+
+void rtl_433_HelperTask(void* pvParameters) {
+  decode_ctx_t* ctx = (decode_ctx_t*)pvParameters;
+  data_arena_use(&ctx->arena);
+  for (;;) {
+    xSemaphoreTake(rtl_433_HelperStart, portMAX_DELAY);
+    if (rtl_433_HelperPass.priority == 0) {
+      start_demods(ctx, rtl_433_HelperPass.train);
+    }
+    rtl_433_HelperPass.nextPriority = UINT_MAX;
+    rtl_433_HelperPass.events =
+        runDemodsPass(ctx, &rtl_433_HelperDispatch, rtl_433_HelperPass.train,
+                      rtl_433_HelperPass.priority,
+                      &rtl_433_HelperPass.nextPriority);
+    xSemaphoreGive(rtl_433_HelperDone);
+  }
+}
+#endif
+
+/**
+ * Run the registered decoders against rtl_pulses, on both cores with
+ * PARALLEL_DECODE
+ */
+static int runDemods(decode_ctx_t* ctx, pulse_data_t* rtl_pulses) {
+#ifdef PARALLEL_DECODE
+  int events = 0;
+  start_demods(ctx, rtl_pulses);
+  rtl_433_HelperPass.train = rtl_pulses;
+  for (unsigned priority = 0; !events && priority < UINT_MAX;) {
+    rtl_433_HelperPass.priority = priority;
+    xSemaphoreGive(rtl_433_HelperStart);
+    unsigned nextPriority = UINT_MAX;
+    events += runDemodsPass(ctx, &rtl_433_DecoderDispatch, rtl_pulses, priority,
+                            &nextPriority);
+    xSemaphoreTake(rtl_433_HelperDone, portMAX_DELAY);
+    events += rtl_433_HelperPass.events;
+    priority = nextPriority < rtl_433_HelperPass.nextPriority
+                   ? nextPriority
+                   : rtl_433_HelperPass.nextPriority;
+    flushDeferredOutput();
+  }
+  rtl_433_HelperPass.train = NULL;
+  data_arena_reset(&rtl_433_HelperCtx->arena); // helper messages were output
+  return events;
+#else
+  r_cfg_t* cfg = &g_cfg;
+  if (rtl_pulses->fskModulation) {
+    return run_fsk_demods(ctx, &cfg->demod->dispatch, rtl_pulses);
+  }
+  return run_ook_demods(ctx, &cfg->demod->dispatch, rtl_pulses);
+#endif
+}
+
+void getDecoderStats(pulse_classifier_stats_t* stats) {
+  *stats = rtl_433_DecodeCtx->stats;
+#ifdef PARALLEL_DECODE
+  // a train is fingerprinted by both tasks, count it once
+  stats->runs += rtl_433_HelperCtx->stats.runs;
+  stats->skipped += rtl_433_HelperCtx->stats.skipped;
+  stats->shared += rtl_433_HelperCtx->stats.shared;
+#endif
+}
+
+/**
+ * Descriptors of the device decoders, in flash. The OOK decoders come first,
+ * then the FSK ones, rtlSetup registers the part of the modulation received.
+ */
+#ifndef MY_DEVICES
+
+// This is a generated fragment from tools/update_rtl_433_devices.sh
+
+static constexpr r_device const* rtl_433_Devices[] = {
+    // OOK
+    &abmt,
+    &acurite_rain_896,
+    &acurite_th,
+    &acurite_txr,
+    &acurite_986,
+    &acurite_606,
+    &acurite_00275rm,
+    &acurite_590tx,
+    &acurite_01185m,
+    &akhan_100F14,
+    &alectov1,
+    &ambient_weather,
+    &ambientweather_tx8300,
+    &atech_ws308,
+    &auriol_4ld5661,
+    &auriol_aft77b2,
+    &auriol_afw2a1,
+    &auriol_ahfl,
+    &auriol_hg02832,
+    &baldr_rain,
+    &blyss,
+    &brennenstuhl_rcs_2044,
+    &bresser_3ch,
+    &bt_rain,
+    &burnhardbbq,
+    &calibeur_RF104,
+    &cardin,
+    &celsia_czc1,
+    &chuango,
+    &cmr113,
+    &companion_wtr001,
+    &cotech_36_7959,
+    &digitech_xc0324,
+    &dish_remote_6_3,
+    &dsc_security,
+    &dsc_security_ws4945,
+    &ecowitt,
+    &eurochron_efth800,
+    &elro_db286a,
+    &elv_em1000,
+    &elv_ws2000,
+    &emos_e6016,
+    &emos_e6016_rain,
+    &enocean_erp1,
+    &ert_idm,
+    &ert_netidm,
+    &ert_scm,
+    &esa_energy,
+    &esperanza_ews,
+    &eurochron,
+    &fineoffset_WH2,
+    &fineoffset_WH0530,
+    &fineoffset_wh1050,
+    &fineoffset_wh1080,
+    &fordremote,
+    &fs20,
+    &ft004b,
+    &funkbus_remote,
+    &gasmate_ba1008,
+    &generic_motion,
+    &generic_remote,
+    &generic_temperature_sensor,
+    &govee,
+    &govee_h5054,
+    &gt_tmbbq05,
+    &gt_wt_02,
+    &gt_wt_03,
+    &hcs200,
+    &hideki_ts04,
+    &honeywell,
+    &honeywell_wdb,
+    &ht680,
+    &ibis_beacon,
+    &infactory,
+    &kw9015b,
+    &interlogix,
+    &intertechno,
+    &jasco,
+    &kedsum,
+    &kerui,
+    &klimalogg,
+    &lacrossetx,
+    &lacrosse_tx141x,
+    &lacrosse_ws7000,
+    &lacrossews,
+    &lightwave_rf,
+    &markisol,
+    &maverick_et73,
+    &maverick_et73x,
+    &mebus433,
+    &megacode,
+    &missil_ml0757,
+    &neptune_r900,
+    &new_template,
+    &newkaku,
+    &nexa,
+    &nexus,
+    &nice_flor_s,
+    &norgo,
+    &oil_standard_ask,
+    &opus_xt300,
+    &oregon_scientific,
+    &oregon_scientific_sl109h,
+    &oregon_scientific_v1,
+    &philips_aj3650,
+    &philips_aj7010,
+    &proflame2,
+    &prologue,
+    &proove,
+    &quhwa,
+    &radiohead_ask,
+    &sensible_living,
+    &rainpoint,
+    &regency_fan,
+    &revolt_nc5462,
+    &rftech,
+    &rubicson,
+    &rubicson_48659,
+    &rubicson_pool_48942,
+    &s3318p,
+    &schraeder,
+    &schrader_EG53MA4,
+    &schrader_SMD3MA4,
+    &scmplus,
+    &secplus_v1,
+    &silvercrest,
+    &ss_sensor,
+    &skylink_motion,
+    &smoke_gs558,
+    &solight_te44,
+    &somfy_rts,
+    &springfield,
+    &telldus_ft0385r,
+    &tfa_30_3221,
+    &tfa_drop_303233,
+    &tfa_pool_thermometer,
+    &tfa_twin_plus_303049,
+    &thermopro_tp11,
+    &thermopro_tp12,
+    &thermopro_tx2,
+    &tpms_eezrv,
+    &tpms_tyreguard400,
+    &ts_ft002,
+    &ttx201,
+    &vaillant_vrt340f,
+    &vauno_en8822c,
+    &visonic_powercode,
+    &waveman,
+    &wec2103,
+    &wg_pb12v1,
+    &ws2032,
+    &wssensor,
+    &wt1024,
+    &wt450,
+    &X10_RF,
+    &x10_sec,
+    &yale_hsa,
+    // FSK
+    &ambientweather_wh31e,
+    &ant_antplus,
+    &archos_tbh,
+    &badger_orion,
+    &bresser_5in1,
+    &bresser_6in1,
+    &bresser_7in1,
+    &cavius,
+    &ced7000,
+    &current_cost,
+    &danfoss_CFR,
+    &directv,
+    &ecodhome,
+    &efergy_e2_classic,
+    &efergy_optical,
+    &emax,
+    &emontx,
+    &esic_emt7110,
+    &fineoffset_WH25,
+    &fineoffset_WH51,
+    &fineoffset_wh1080_fsk,
+    &fineoffset_wh31l,
+    &fineoffset_wh45,
+    &fineoffset_wn34,
+    &fineoffset_ws80,
+    &flowis,
+    &ge_coloreffects,
+    &geo_minim,
+    &hcs200_fsk,
+    &holman_ws5029pcm,
+    &holman_ws5029pwm,
+    &hondaremote,
+    &honeywell_cm921,
+    &honeywell_wdb_fsk,
+    &ikea_sparsnas,
+    &inkbird_ith20r,
+    &insteon,
+    &lacrosse_breezepro,
+    &lacrosse_r1,
+    &lacrosse_th3,
+    &lacrosse_tx31u,
+    &lacrosse_tx34,
+    &lacrosse_tx29,
+    &lacrosse_tx35,
+    &lacrosse_wr1,
+    &m_bus_mode_c_t,
+    &m_bus_mode_c_t_downlink,
+    &m_bus_mode_s,
+    &m_bus_mode_r,
+    &m_bus_mode_f,
+    &marlec_solar,
+    &maverick_xr30,
+    &oil_smart,
+    &oil_standard,
+    &oil_watchman,
+    &oil_watchman_advanced,
+    &rojaflex,
+    &sharp_spc775,
+    &simplisafe_gen3,
+    &somfy_iohc,
+    &srsmith_pool_srs_2c_tx,
+    &steelmate,
+    &tfa_14_1504_v2,
+    &tfa_303196,
+    &tfa_marbella,
+    &tpms_abarth124,
+    &tpms_ave,
+    &tpms_citroen,
+    &tpms_elantra2012,
+    &tpms_ford,
+    &tpms_hyundai_vdo,
+    &tpms_jansite,
+    &tpms_jansite_solar,
+    &tpms_kia,
+    &tpms_pmv107j,
+    &tpms_porsche,
+    &tpms_renault,
+    &tpms_renault_0435r,
+    &tpms_toyota,
+    &tpms_truck,
+};
+
+// end of fragment
+
+#else
+static constexpr r_device const* rtl_433_Devices[] = {
+    &lacrosse_tx141x,
+};
+#endif
+
+static_assert(sizeof(rtl_433_Devices) / sizeof(rtl_433_Devices[0]) ==
+                  NUMOF_OOK_DEVICES + NUMOF_FSK_DEVICES,
+              "rtl_433_Devices does not match include/rtl_433_devices.h");
+
+#ifndef RTL_VERBOSE
+#  define RTL_VERBOSE -1
+#endif
+
+/**
+ * Register the decoder of cfg->devices[protocolNum]
+ */
+static void registerDecoder(r_cfg_t* cfg, int protocolNum) {
+  char* arg = NULL;
+  char verbose[4] = "vvv";
+  if (RTL_VERBOSE && protocolNum == RTL_VERBOSE) {
+    arg = verbose;
+  }
+  register_protocol(cfg, cfg->devices[protocolNum], protocolNum, arg);
+}
+
+/**
+ * Registered copy of the decoder of cfg->devices[protocolNum], NULL if it is
+ * not enabled
+ */
+static r_device* registeredDecoder(r_cfg_t* cfg, int protocolNum) {
+  for (void** iter = cfg->demod->r_devs.elems; iter && *iter; ++iter) {
+    r_device* r_dev = (r_device*)*iter;
+    if (r_dev->protocol_num == (unsigned)protocolNum) {
+      return r_dev;
+    }
+  }
+  return NULL;
+}
+
+static bool nameContains(const char* name, const char* part) {
+  for (; *name; name++) {
+    size_t i = 0;
+    while (part[i] && tolower((unsigned char)name[i]) == tolower((unsigned char)part[i])) {
+      i++;
+    }
+    if (!part[i]) {
+      return true;
+    }
+  }
+  return !*part;
+}
+
+/**
+ * Register or unregister the decoders of cfg->devices with name in their
+ * name, protocolNum or modulation, -1 matches any. A decoder disabled by
+ * default is only enabled by its protocol number.
+ */
+static int setDecodersEnabled(const char* name, int protocolNum, int modulation,
+                              bool enabled) {
+  r_cfg_t* cfg = &g_cfg;
+  if (!rtl_433_DecoderLock) {
+    logprintfLn(LOG_ERR, "ERROR: decoders can only be enabled or disabled after initReceiver");
+    return -1;
+  }
+  if (protocolNum >= cfg->num_r_devices) {
+    logprintfLn(LOG_ERR, "ERROR: no decoder %d", protocolNum);
+    return -1;
+  }
+  xSemaphoreTake(rtl_433_DecoderLock, portMAX_DELAY);
+  int changed = 0;
+  for (int i = 0; i < cfg->num_r_devices; i++) {
+    r_device const* r_dev = cfg->devices[i];
+    if ((name && !nameContains(r_dev->name, name)) ||
+        (protocolNum >= 0 && i != protocolNum) ||
+        (modulation >= 0 && r_dev->modulation != (unsigned)modulation)) {
+      continue;
+    }
+    r_device* registered = registeredDecoder(cfg, i);
+    if (enabled && !registered &&
+        (protocolNum >= 0 ? r_dev->disabled <= 1 : r_dev->disabled <= 0)) {
+      registerDecoder(cfg, i);
+      changed++;
+    } else if (!enabled && registered) {
+      unregister_protocol(cfg, registered);
+      changed++;
+    }
+  }
+  if (changed) {
+#ifdef PARALLEL_DECODE
+    partitionDecoders(cfg);
+#endif
+    rtl_433_DecodeTime = {};
+  }
+  xSemaphoreGive(rtl_433_DecoderLock);
+  logprintfLn(LOG_INFO, "%s %d decoders, %u enabled", enabled ? "Enabled" : "Disabled",
+              changed, (unsigned)cfg->demod->r_devs.len);
+  return changed;
+}
+
+int rtl_433_ESP::setDecoders(const char* name, bool enabled) {
+  return setDecodersEnabled(name ? name : "", -1, -1, enabled);
+}
+
+int rtl_433_ESP::setDecoder(unsigned protocolNum, bool enabled) {
+  return setDecodersEnabled(NULL, protocolNum, -1, enabled);
+}
+
+int rtl_433_ESP::setModulationDecoders(unsigned modulation, bool enabled) {
+  return setDecodersEnabled(NULL, -1, modulation, enabled);
+}
 
 void rtlSetup() {
   r_cfg_t* cfg = &g_cfg;
@@ -68,270 +744,18 @@ void rtlSetup() {
                 ESP.getFreeHeap());
 #endif
     cfg->conversion_mode = CONVERT_SI; // Default all output to Celsius
-    if (rtl_433_ESP::ookModulation) {
-      cfg->num_r_devices = NUMOF_OOK_DEVICES;
-    } else {
-      cfg->num_r_devices = NUMOF_FSK_DEVICES;
-    }
-    cfg->devices = (r_device*)calloc(cfg->num_r_devices, sizeof(r_device));
-    if (!cfg->devices)
-      FATAL_CALLOC("cfg->devices");
+    // the decoders of the receiver modulation, or both sets
+    const bool ookDecoders = rtl_433_ESP::ookModulation || rtl_433_ESP::dualModulation;
+    const bool fskDecoders = !rtl_433_ESP::ookModulation || rtl_433_ESP::dualModulation;
+    cfg->devices = &rtl_433_Devices[ookDecoders ? 0 : NUMOF_OOK_DEVICES];
+    cfg->num_r_devices = (ookDecoders ? NUMOF_OOK_DEVICES : 0) +
+                         (fskDecoders ? NUMOF_FSK_DEVICES : 0);
 
 #ifdef MEMORY_DEBUG
     logprintfLn(LOG_DEBUG, "sizeof(cfg) %d, heap %d", sizeof(cfg),
                 ESP.getFreeHeap());
 #endif
 
-#ifndef MY_DEVICES
-    // This is a generated fragment from tools/update_rtl_433_devices.sh
-
-    if (rtl_433_ESP::ookModulation) {
-      memcpy(&cfg->devices[0], &abmt, sizeof(r_device));
-      memcpy(&cfg->devices[1], &acurite_rain_896, sizeof(r_device));
-      memcpy(&cfg->devices[2], &acurite_th, sizeof(r_device));
-      memcpy(&cfg->devices[3], &acurite_txr, sizeof(r_device));
-      memcpy(&cfg->devices[4], &acurite_986, sizeof(r_device));
-      memcpy(&cfg->devices[5], &acurite_606, sizeof(r_device));
-      memcpy(&cfg->devices[6], &acurite_00275rm, sizeof(r_device));
-      memcpy(&cfg->devices[7], &acurite_590tx, sizeof(r_device));
-      memcpy(&cfg->devices[8], &acurite_01185m, sizeof(r_device));
-      memcpy(&cfg->devices[9], &akhan_100F14, sizeof(r_device));
-      memcpy(&cfg->devices[10], &alectov1, sizeof(r_device));
-      memcpy(&cfg->devices[11], &ambient_weather, sizeof(r_device));
-      memcpy(&cfg->devices[12], &ambientweather_tx8300, sizeof(r_device));
-      memcpy(&cfg->devices[13], &atech_ws308, sizeof(r_device));
-      memcpy(&cfg->devices[14], &auriol_4ld5661, sizeof(r_device));
-      memcpy(&cfg->devices[15], &auriol_aft77b2, sizeof(r_device));
-      memcpy(&cfg->devices[16], &auriol_afw2a1, sizeof(r_device));
-      memcpy(&cfg->devices[17], &auriol_ahfl, sizeof(r_device));
-      memcpy(&cfg->devices[18], &auriol_hg02832, sizeof(r_device));
-      memcpy(&cfg->devices[19], &baldr_rain, sizeof(r_device));
-      memcpy(&cfg->devices[20], &blyss, sizeof(r_device));
-      memcpy(&cfg->devices[21], &brennenstuhl_rcs_2044, sizeof(r_device));
-      memcpy(&cfg->devices[22], &bresser_3ch, sizeof(r_device));
-      memcpy(&cfg->devices[23], &bt_rain, sizeof(r_device));
-      memcpy(&cfg->devices[24], &burnhardbbq, sizeof(r_device));
-      memcpy(&cfg->devices[25], &calibeur_RF104, sizeof(r_device));
-      memcpy(&cfg->devices[26], &cardin, sizeof(r_device));
-      memcpy(&cfg->devices[27], &celsia_czc1, sizeof(r_device));
-      memcpy(&cfg->devices[28], &chuango, sizeof(r_device));
-      memcpy(&cfg->devices[29], &cmr113, sizeof(r_device));
-      memcpy(&cfg->devices[30], &companion_wtr001, sizeof(r_device));
-      memcpy(&cfg->devices[31], &cotech_36_7959, sizeof(r_device));
-      memcpy(&cfg->devices[32], &digitech_xc0324, sizeof(r_device));
-      memcpy(&cfg->devices[33], &dish_remote_6_3, sizeof(r_device));
-      memcpy(&cfg->devices[34], &dsc_security, sizeof(r_device));
-      memcpy(&cfg->devices[35], &dsc_security_ws4945, sizeof(r_device));
-      memcpy(&cfg->devices[36], &ecowitt, sizeof(r_device));
-      memcpy(&cfg->devices[37], &eurochron_efth800, sizeof(r_device));
-      memcpy(&cfg->devices[38], &elro_db286a, sizeof(r_device));
-      memcpy(&cfg->devices[39], &elv_em1000, sizeof(r_device));
-      memcpy(&cfg->devices[40], &elv_ws2000, sizeof(r_device));
-      memcpy(&cfg->devices[41], &emos_e6016, sizeof(r_device));
-      memcpy(&cfg->devices[42], &emos_e6016_rain, sizeof(r_device));
-      memcpy(&cfg->devices[43], &enocean_erp1, sizeof(r_device));
-      memcpy(&cfg->devices[44], &ert_idm, sizeof(r_device));
-      memcpy(&cfg->devices[45], &ert_netidm, sizeof(r_device));
-      memcpy(&cfg->devices[46], &ert_scm, sizeof(r_device));
-      memcpy(&cfg->devices[47], &esa_energy, sizeof(r_device));
-      memcpy(&cfg->devices[48], &esperanza_ews, sizeof(r_device));
-      memcpy(&cfg->devices[49], &eurochron, sizeof(r_device));
-      memcpy(&cfg->devices[50], &fineoffset_WH2, sizeof(r_device));
-      memcpy(&cfg->devices[51], &fineoffset_WH0530, sizeof(r_device));
-      memcpy(&cfg->devices[52], &fineoffset_wh1050, sizeof(r_device));
-      memcpy(&cfg->devices[53], &fineoffset_wh1080, sizeof(r_device));
-      memcpy(&cfg->devices[54], &fordremote, sizeof(r_device));
-      memcpy(&cfg->devices[55], &fs20, sizeof(r_device));
-      memcpy(&cfg->devices[56], &ft004b, sizeof(r_device));
-      memcpy(&cfg->devices[57], &funkbus_remote, sizeof(r_device));
-      memcpy(&cfg->devices[58], &gasmate_ba1008, sizeof(r_device));
-      memcpy(&cfg->devices[59], &generic_motion, sizeof(r_device));
-      memcpy(&cfg->devices[60], &generic_remote, sizeof(r_device));
-      memcpy(&cfg->devices[61], &generic_temperature_sensor, sizeof(r_device));
-      memcpy(&cfg->devices[62], &govee, sizeof(r_device));
-      memcpy(&cfg->devices[63], &govee_h5054, sizeof(r_device));
-      memcpy(&cfg->devices[64], &gt_tmbbq05, sizeof(r_device));
-      memcpy(&cfg->devices[65], &gt_wt_02, sizeof(r_device));
-      memcpy(&cfg->devices[66], &gt_wt_03, sizeof(r_device));
-      memcpy(&cfg->devices[67], &hcs200, sizeof(r_device));
-      memcpy(&cfg->devices[68], &hideki_ts04, sizeof(r_device));
-      memcpy(&cfg->devices[69], &honeywell, sizeof(r_device));
-      memcpy(&cfg->devices[70], &honeywell_wdb, sizeof(r_device));
-      memcpy(&cfg->devices[71], &ht680, sizeof(r_device));
-      memcpy(&cfg->devices[72], &ibis_beacon, sizeof(r_device));
-      memcpy(&cfg->devices[73], &infactory, sizeof(r_device));
-      memcpy(&cfg->devices[74], &kw9015b, sizeof(r_device));
-      memcpy(&cfg->devices[75], &interlogix, sizeof(r_device));
-      memcpy(&cfg->devices[76], &intertechno, sizeof(r_device));
-      memcpy(&cfg->devices[77], &jasco, sizeof(r_device));
-      memcpy(&cfg->devices[78], &kedsum, sizeof(r_device));
-      memcpy(&cfg->devices[79], &kerui, sizeof(r_device));
-      memcpy(&cfg->devices[80], &klimalogg, sizeof(r_device));
-      memcpy(&cfg->devices[81], &lacrossetx, sizeof(r_device));
-      memcpy(&cfg->devices[82], &lacrosse_tx141x, sizeof(r_device));
-      memcpy(&cfg->devices[83], &lacrosse_ws7000, sizeof(r_device));
-      memcpy(&cfg->devices[84], &lacrossews, sizeof(r_device));
-      memcpy(&cfg->devices[85], &lightwave_rf, sizeof(r_device));
-      memcpy(&cfg->devices[86], &markisol, sizeof(r_device));
-      memcpy(&cfg->devices[87], &maverick_et73, sizeof(r_device));
-      memcpy(&cfg->devices[88], &maverick_et73x, sizeof(r_device));
-      memcpy(&cfg->devices[89], &mebus433, sizeof(r_device));
-      memcpy(&cfg->devices[90], &megacode, sizeof(r_device));
-      memcpy(&cfg->devices[91], &missil_ml0757, sizeof(r_device));
-      memcpy(&cfg->devices[92], &neptune_r900, sizeof(r_device));
-      memcpy(&cfg->devices[93], &new_template, sizeof(r_device));
-      memcpy(&cfg->devices[94], &newkaku, sizeof(r_device));
-      memcpy(&cfg->devices[95], &nexa, sizeof(r_device));
-      memcpy(&cfg->devices[96], &nexus, sizeof(r_device));
-      memcpy(&cfg->devices[97], &nice_flor_s, sizeof(r_device));
-      memcpy(&cfg->devices[98], &norgo, sizeof(r_device));
-      memcpy(&cfg->devices[99], &oil_standard_ask, sizeof(r_device));
-      memcpy(&cfg->devices[100], &opus_xt300, sizeof(r_device));
-      memcpy(&cfg->devices[101], &oregon_scientific, sizeof(r_device));
-      memcpy(&cfg->devices[102], &oregon_scientific_sl109h, sizeof(r_device));
-      memcpy(&cfg->devices[103], &oregon_scientific_v1, sizeof(r_device));
-      memcpy(&cfg->devices[104], &philips_aj3650, sizeof(r_device));
-      memcpy(&cfg->devices[105], &philips_aj7010, sizeof(r_device));
-      memcpy(&cfg->devices[106], &proflame2, sizeof(r_device));
-      memcpy(&cfg->devices[107], &prologue, sizeof(r_device));
-      memcpy(&cfg->devices[108], &proove, sizeof(r_device));
-      memcpy(&cfg->devices[109], &quhwa, sizeof(r_device));
-      memcpy(&cfg->devices[110], &radiohead_ask, sizeof(r_device));
-      memcpy(&cfg->devices[111], &sensible_living, sizeof(r_device));
-      memcpy(&cfg->devices[112], &rainpoint, sizeof(r_device));
-      memcpy(&cfg->devices[113], &regency_fan, sizeof(r_device));
-      memcpy(&cfg->devices[114], &revolt_nc5462, sizeof(r_device));
-      memcpy(&cfg->devices[115], &rftech, sizeof(r_device));
-      memcpy(&cfg->devices[116], &rubicson, sizeof(r_device));
-      memcpy(&cfg->devices[117], &rubicson_48659, sizeof(r_device));
-      memcpy(&cfg->devices[118], &rubicson_pool_48942, sizeof(r_device));
-      memcpy(&cfg->devices[119], &s3318p, sizeof(r_device));
-      memcpy(&cfg->devices[120], &schraeder, sizeof(r_device));
-      memcpy(&cfg->devices[121], &schrader_EG53MA4, sizeof(r_device));
-      memcpy(&cfg->devices[122], &schrader_SMD3MA4, sizeof(r_device));
-      memcpy(&cfg->devices[123], &scmplus, sizeof(r_device));
-      memcpy(&cfg->devices[124], &secplus_v1, sizeof(r_device));
-      memcpy(&cfg->devices[125], &silvercrest, sizeof(r_device));
-      memcpy(&cfg->devices[126], &ss_sensor, sizeof(r_device));
-      memcpy(&cfg->devices[127], &skylink_motion, sizeof(r_device));
-      memcpy(&cfg->devices[128], &smoke_gs558, sizeof(r_device));
-      memcpy(&cfg->devices[129], &solight_te44, sizeof(r_device));
-      memcpy(&cfg->devices[130], &somfy_rts, sizeof(r_device));
-      memcpy(&cfg->devices[131], &springfield, sizeof(r_device));
-      memcpy(&cfg->devices[132], &telldus_ft0385r, sizeof(r_device));
-      memcpy(&cfg->devices[133], &tfa_30_3221, sizeof(r_device));
-      memcpy(&cfg->devices[134], &tfa_drop_303233, sizeof(r_device));
-      memcpy(&cfg->devices[135], &tfa_pool_thermometer, sizeof(r_device));
-      memcpy(&cfg->devices[136], &tfa_twin_plus_303049, sizeof(r_device));
-      memcpy(&cfg->devices[137], &thermopro_tp11, sizeof(r_device));
-      memcpy(&cfg->devices[138], &thermopro_tp12, sizeof(r_device));
-      memcpy(&cfg->devices[139], &thermopro_tx2, sizeof(r_device));
-      memcpy(&cfg->devices[140], &tpms_eezrv, sizeof(r_device));
-      memcpy(&cfg->devices[141], &tpms_tyreguard400, sizeof(r_device));
-      memcpy(&cfg->devices[142], &ts_ft002, sizeof(r_device));
-      memcpy(&cfg->devices[143], &ttx201, sizeof(r_device));
-      memcpy(&cfg->devices[144], &vaillant_vrt340f, sizeof(r_device));
-      memcpy(&cfg->devices[145], &vauno_en8822c, sizeof(r_device));
-      memcpy(&cfg->devices[146], &visonic_powercode, sizeof(r_device));
-      memcpy(&cfg->devices[147], &waveman, sizeof(r_device));
-      memcpy(&cfg->devices[148], &wec2103, sizeof(r_device));
-      memcpy(&cfg->devices[149], &wg_pb12v1, sizeof(r_device));
-      memcpy(&cfg->devices[150], &ws2032, sizeof(r_device));
-      memcpy(&cfg->devices[151], &wssensor, sizeof(r_device));
-      memcpy(&cfg->devices[152], &wt1024, sizeof(r_device));
-      memcpy(&cfg->devices[153], &wt450, sizeof(r_device));
-      memcpy(&cfg->devices[154], &X10_RF, sizeof(r_device));
-      memcpy(&cfg->devices[155], &x10_sec, sizeof(r_device));
-      memcpy(&cfg->devices[156], &yale_hsa, sizeof(r_device));
-    } else {
-      memcpy(&cfg->devices[0], &ambientweather_wh31e, sizeof(r_device));
-      memcpy(&cfg->devices[1], &ant_antplus, sizeof(r_device));
-      memcpy(&cfg->devices[2], &archos_tbh, sizeof(r_device));
-      memcpy(&cfg->devices[3], &badger_orion, sizeof(r_device));
-      memcpy(&cfg->devices[4], &bresser_5in1, sizeof(r_device));
-      memcpy(&cfg->devices[5], &bresser_6in1, sizeof(r_device));
-      memcpy(&cfg->devices[6], &bresser_7in1, sizeof(r_device));
-      memcpy(&cfg->devices[7], &cavius, sizeof(r_device));
-      memcpy(&cfg->devices[8], &ced7000, sizeof(r_device));
-      memcpy(&cfg->devices[9], &current_cost, sizeof(r_device));
-      memcpy(&cfg->devices[10], &danfoss_CFR, sizeof(r_device));
-      memcpy(&cfg->devices[11], &directv, sizeof(r_device));
-      memcpy(&cfg->devices[12], &ecodhome, sizeof(r_device));
-      memcpy(&cfg->devices[13], &efergy_e2_classic, sizeof(r_device));
-      memcpy(&cfg->devices[14], &efergy_optical, sizeof(r_device));
-      memcpy(&cfg->devices[15], &emax, sizeof(r_device));
-      memcpy(&cfg->devices[16], &emontx, sizeof(r_device));
-      memcpy(&cfg->devices[17], &esic_emt7110, sizeof(r_device));
-      memcpy(&cfg->devices[18], &fineoffset_WH25, sizeof(r_device));
-      memcpy(&cfg->devices[19], &fineoffset_WH51, sizeof(r_device));
-      memcpy(&cfg->devices[20], &fineoffset_wh1080_fsk, sizeof(r_device));
-      memcpy(&cfg->devices[21], &fineoffset_wh31l, sizeof(r_device));
-      memcpy(&cfg->devices[22], &fineoffset_wh45, sizeof(r_device));
-      memcpy(&cfg->devices[23], &fineoffset_wn34, sizeof(r_device));
-      memcpy(&cfg->devices[24], &fineoffset_ws80, sizeof(r_device));
-      memcpy(&cfg->devices[25], &flowis, sizeof(r_device));
-      memcpy(&cfg->devices[26], &ge_coloreffects, sizeof(r_device));
-      memcpy(&cfg->devices[27], &geo_minim, sizeof(r_device));
-      memcpy(&cfg->devices[28], &hcs200_fsk, sizeof(r_device));
-      memcpy(&cfg->devices[29], &holman_ws5029pcm, sizeof(r_device));
-      memcpy(&cfg->devices[30], &holman_ws5029pwm, sizeof(r_device));
-      memcpy(&cfg->devices[31], &hondaremote, sizeof(r_device));
-      memcpy(&cfg->devices[32], &honeywell_cm921, sizeof(r_device));
-      memcpy(&cfg->devices[33], &honeywell_wdb_fsk, sizeof(r_device));
-      memcpy(&cfg->devices[34], &ikea_sparsnas, sizeof(r_device));
-      memcpy(&cfg->devices[35], &inkbird_ith20r, sizeof(r_device));
-      memcpy(&cfg->devices[36], &insteon, sizeof(r_device));
-      memcpy(&cfg->devices[37], &lacrosse_breezepro, sizeof(r_device));
-      memcpy(&cfg->devices[38], &lacrosse_r1, sizeof(r_device));
-      memcpy(&cfg->devices[39], &lacrosse_th3, sizeof(r_device));
-      memcpy(&cfg->devices[40], &lacrosse_tx31u, sizeof(r_device));
-      memcpy(&cfg->devices[41], &lacrosse_tx34, sizeof(r_device));
-      memcpy(&cfg->devices[42], &lacrosse_tx29, sizeof(r_device));
-      memcpy(&cfg->devices[43], &lacrosse_tx35, sizeof(r_device));
-      memcpy(&cfg->devices[44], &lacrosse_wr1, sizeof(r_device));
-      memcpy(&cfg->devices[45], &m_bus_mode_c_t, sizeof(r_device));
-      memcpy(&cfg->devices[46], &m_bus_mode_c_t_downlink, sizeof(r_device));
-      memcpy(&cfg->devices[47], &m_bus_mode_s, sizeof(r_device));
-      memcpy(&cfg->devices[48], &m_bus_mode_r, sizeof(r_device));
-      memcpy(&cfg->devices[49], &m_bus_mode_f, sizeof(r_device));
-      memcpy(&cfg->devices[50], &marlec_solar, sizeof(r_device));
-      memcpy(&cfg->devices[51], &maverick_xr30, sizeof(r_device));
-      memcpy(&cfg->devices[52], &oil_smart, sizeof(r_device));
-      memcpy(&cfg->devices[53], &oil_standard, sizeof(r_device));
-      memcpy(&cfg->devices[54], &oil_watchman, sizeof(r_device));
-      memcpy(&cfg->devices[55], &oil_watchman_advanced, sizeof(r_device));
-      memcpy(&cfg->devices[56], &rojaflex, sizeof(r_device));
-      memcpy(&cfg->devices[57], &sharp_spc775, sizeof(r_device));
-      memcpy(&cfg->devices[58], &simplisafe_gen3, sizeof(r_device));
-      memcpy(&cfg->devices[59], &somfy_iohc, sizeof(r_device));
-      memcpy(&cfg->devices[60], &srsmith_pool_srs_2c_tx, sizeof(r_device));
-      memcpy(&cfg->devices[61], &steelmate, sizeof(r_device));
-      memcpy(&cfg->devices[62], &tfa_14_1504_v2, sizeof(r_device));
-      memcpy(&cfg->devices[63], &tfa_303196, sizeof(r_device));
-      memcpy(&cfg->devices[64], &tfa_marbella, sizeof(r_device));
-      memcpy(&cfg->devices[65], &tpms_abarth124, sizeof(r_device));
-      memcpy(&cfg->devices[66], &tpms_ave, sizeof(r_device));
-      memcpy(&cfg->devices[67], &tpms_citroen, sizeof(r_device));
-      memcpy(&cfg->devices[68], &tpms_elantra2012, sizeof(r_device));
-      memcpy(&cfg->devices[69], &tpms_ford, sizeof(r_device));
-      memcpy(&cfg->devices[70], &tpms_hyundai_vdo, sizeof(r_device));
-      memcpy(&cfg->devices[71], &tpms_jansite, sizeof(r_device));
-      memcpy(&cfg->devices[72], &tpms_jansite_solar, sizeof(r_device));
-      memcpy(&cfg->devices[73], &tpms_kia, sizeof(r_device));
-      memcpy(&cfg->devices[74], &tpms_pmv107j, sizeof(r_device));
-      memcpy(&cfg->devices[75], &tpms_porsche, sizeof(r_device));
-      memcpy(&cfg->devices[76], &tpms_renault, sizeof(r_device));
-      memcpy(&cfg->devices[77], &tpms_renault_0435r, sizeof(r_device));
-      memcpy(&cfg->devices[78], &tpms_toyota, sizeof(r_device));
-      memcpy(&cfg->devices[79], &tpms_truck, sizeof(r_device));
-    }
-
-    // end of fragment
-
-#else
-    memcpy(&cfg->devices[0], &lacrosse_tx141x, sizeof(r_device));
-#endif
-
 #ifdef RTL_FLEX
     // This option is non-functional. The flex decoder is too resource intensive
     // for an ESP32, and needs the ESP32 stack set to 32768 in order for the
@@ -341,8 +765,7 @@ void rtlSetup() {
 
     r_device* flex_device;
     flex_device = flex_create_device(RTL_FLEX);
-    memcpy(&cfg->devices[101], &flex_device, sizeof(r_device));
-    register_protocol(cfg, flex_device, NULL);
+    register_protocol(cfg, flex_device, cfg->num_r_devices, NULL);
     alogprintfLn(LOG_INFO, "Flex Decoder enabled: %s", RTL_FLEX);
 #endif
 
@@ -358,8 +781,6 @@ void rtlSetup() {
 #ifdef DEMOD_DEBUG
     logprintfLn(LOG_INFO, "# of device(s) configured %d", cfg->num_r_devices);
     logprintfLn(LOG_INFO, "ssizeof(r_device): %d", sizeof(r_device));
-    logprintfLn(LOG_INFO, "cfg->devices size: %d",
-                sizeof(r_device) * cfg->num_r_devices);
 #endif
 #ifdef RTL_DEBUG
     cfg->verbosity = RTL_DEBUG + 5; // 0=normal, 1=verbose, 2=verbose decoders,
@@ -378,33 +799,25 @@ void rtlSetup() {
     // register_all_protocols(cfg, 0);
 
     for (int i = 0; i < cfg->num_r_devices; i++) {
-      // register all device protocols that are not disabled
-      cfg->devices[i].protocol_num = i;
+      // register all device protocols that are not disabled, only those get
+      // a copy of their descriptor in RAM
 #ifdef MEMORY_DEBUG
       logprintfLn(LOG_DEBUG, "Pre register_protocol %d %s, heap %d", i,
-                  cfg->devices[i].name, ESP.getFreeHeap());
+                  cfg->devices[i]->name, ESP.getFreeHeap());
 #endif
 #ifdef RESOURCE_DEBUG
       int preStack = uxTaskGetStackHighWaterMark(NULL);
       int preHeap = ESP.getFreeHeap();
 #endif
 
-      char* arg = NULL;
-      char verbose[4] = "vvv";
-#ifndef RTL_VERBOSE
-#  define RTL_VERBOSE -1
-#endif
-      if (RTL_VERBOSE && i == RTL_VERBOSE) {
-        arg = verbose;
-      }
-      if (cfg->devices[i].disabled <= 0) {
-        register_protocol(cfg, &cfg->devices[i], arg);
+      if (cfg->devices[i]->disabled <= 0) {
+        registerDecoder(cfg, i);
       }
 #ifdef RESOURCE_DEBUG
       int deltaStack = preStack - uxTaskGetStackHighWaterMark(NULL);
       int deltaHeap = preHeap - ESP.getFreeHeap();
       if (deltaStack || (deltaHeap > 200)) {
-        logprintfLn(LOG_DEBUG, "Process rtl_433_DecoderTask resource hit %s, deltaStack: %d, stack: %u, deltaHeap: %d, heap: %d", cfg->devices[i].name,
+        logprintfLn(LOG_DEBUG, "Process rtl_433_DecoderTask resource hit %s, deltaStack: %d, stack: %u, deltaHeap: %d, heap: %d", cfg->devices[i]->name,
                     deltaStack, uxTaskGetStackHighWaterMark(NULL), deltaHeap, ESP.getFreeHeap());
       }
 #endif
@@ -413,7 +826,41 @@ void rtlSetup() {
 #ifdef MEMORY_DEBUG
     logprintfLn(LOG_DEBUG, "Pre xQueueCreate heap %d", ESP.getFreeHeap());
 #endif
-    rtl_433_Queue = xQueueCreate(5, sizeof(pulse_data_t*));
+    if (rtl_433_ReceiverBuffers < 1)
+      rtl_433_ReceiverBuffers = 1;
+    if (rtl_433_ReceiverBuffers > RECEIVER_BUFFER_MAX)
+      rtl_433_ReceiverBuffers = RECEIVER_BUFFER_MAX;
+    if (rtl_433_QueueDepth < 1 || rtl_433_QueueDepth > rtl_433_ReceiverBuffers)
+      rtl_433_QueueDepth = rtl_433_ReceiverBuffers;
+    rtl_433_PulseTrains = (pulse_data_t*)heap_caps_calloc(
+        rtl_433_ReceiverBuffers, sizeof(pulse_data_t), MALLOC_CAP_INTERNAL);
+    uint8_t* storage = (uint8_t*)heap_caps_calloc(
+        rtl_433_ReceiverBuffers, pulse_data_storage_size(PD_MAX_PULSES),
+        MALLOC_CAP_INTERNAL);
+    if (!rtl_433_PulseTrains || !storage)
+      FATAL_CALLOC("rtl_433_PulseTrains");
+    for (int train = 0; train < rtl_433_ReceiverBuffers; train++) {
+      pulse_data_attach(&rtl_433_PulseTrains[train],
+                        storage + train * pulse_data_storage_size(PD_MAX_PULSES),
+                        PD_MAX_PULSES);
+    }
+    rtl_433_DecodeCtx = decode_ctx_create();
+    if (!rtl_433_DecodeCtx)
+      FATAL_CALLOC("rtl_433_DecodeCtx");
+#ifdef PARALLEL_DECODE
+    rtl_433_HelperCtx = decode_ctx_create();
+    if (!rtl_433_HelperCtx)
+      FATAL_CALLOC("rtl_433_HelperCtx");
+    partitionDecoders(cfg);
+    rtl_433_HelperStart = xSemaphoreCreateBinary();
+    rtl_433_HelperDone = xSemaphoreCreateBinary();
+#endif
+    rtl_433_DecoderLock = xSemaphoreCreateMutex();
+    rtl_433_Queue = xQueueCreate(rtl_433_QueueDepth, sizeof(uint8_t));
+    rtl_433_FreeQueue = xQueueCreate(rtl_433_ReceiverBuffers, sizeof(uint8_t));
+    for (uint8_t train = 0; train < rtl_433_ReceiverBuffers; train++) {
+      xQueueSend(rtl_433_FreeQueue, &train, 0);
+    }
 
 #ifdef MEMORY_DEBUG
     logprintfLn(LOG_DEBUG, "Pre xTaskCreatePinnedToCore heap %d",
@@ -427,10 +874,20 @@ void rtlSetup() {
         rtl_433_DecoderTask, /* Function to implement the task */
         "rtl_433_DecoderTask", /* Name of the task */
         rtl_433_Decoder_Stack, /* Stack size in bytes */
-        NULL, /* Task input parameter */
+        rtl_433_DecodeCtx, /* Task input parameter */
         rtl_433_Decoder_Priority, /* Priority of the task (set lower than core task) */
         &rtl_433_DecoderHandle, /* Task handle. */
         rtl_433_Decoder_Core); /* Core where the task should run */
+#ifdef PARALLEL_DECODE
+    xTaskCreatePinnedToCore(
+        rtl_433_HelperTask, /* Function to implement the task */
+        "rtl_433_HelperTask", /* Name of the task */
+        rtl_433_Decoder_Stack, /* Stack size in bytes */
+        rtl_433_HelperCtx, /* Task input parameter */
+        rtl_433_Helper_Priority, /* Priority of the task (set lower than receiver task) */
+        &rtl_433_HelperHandle, /* Task handle. */
+        rtl_433_Helper_Core); /* Core where the task should run */
+#endif
   }
 }
 
@@ -439,9 +896,21 @@ void _setCallback(rtl_433_ESPCallBack callback, char* messageBuffer,
   // logprintfLn(LOG_DEBUG, "_setCallback location: %p", callback);
 
   r_cfg_t* cfg = &g_cfg;
-  cfg->callback = callback;
+  rtl_433_UserCallback = callback;
+  cfg->callback = latencyCallback;
   cfg->messageBuffer = messageBuffer;
   cfg->bufferSize = bufferSize;
+  cfg->messageFormat = MESSAGE_JSON;
+}
+
+void _setCallback(rtl_433_ESPBinaryCallBack callback, uint8_t* messageBuffer,
+                  int bufferSize) {
+  r_cfg_t* cfg = &g_cfg;
+  rtl_433_UserBinaryCallback = callback;
+  cfg->binaryCallback = latencyBinaryCallback;
+  cfg->messageBuffer = (char*)messageBuffer;
+  cfg->bufferSize = bufferSize;
+  cfg->messageFormat = MESSAGE_CBOR;
 }
 
 void _setDebug(int debug) {
@@ -451,69 +920,72 @@ void _setDebug(int debug) {
 
 // ---------------------------------------------------------------------------------------------------------
 
-void rtl_433_DecoderTask(void* pvParameters) {
-  pulse_data_t* rtl_pulses = nullptr;
-  for (;;) {
-    // logprintfLn(LOG_DEBUG, "rtl_433_DecoderTask awaiting signal");
-    xQueueReceive(rtl_433_Queue, &rtl_pulses, portMAX_DELAY);
-    // logprintfLn(LOG_DEBUG, "rtl_433_DecoderTask signal received");
+// Run the registered decoders against one pulse train using the scratch state
+// in ctx, returns the number of decoded events. Ownership of rtl_pulses stays
+// with the caller.
+int decodeSignal(decode_ctx_t* ctx, pulse_data_t* rtl_pulses) {
 #ifdef MEMORY_DEBUG
-    unsigned long signalProcessingStart = micros();
+  unsigned long signalProcessingStart = micros();
 #endif
 
 #ifdef RAW_SIGNAL_DEBUG
-    logprintf(LOG_INFO, "RAW (%lu): ", rtl_pulses->signalDuration);
-    for (int i = 0; i < rtl_pulses->num_pulses; i++) {
-      alogprintf(LOG_INFO, "+%d", rtl_pulses->pulse[i]);
-      alogprintf(LOG_INFO, "-%d", rtl_pulses->gap[i]);
+  logprintf(LOG_INFO, "RAW (%lu): ", rtl_pulses->signalDuration);
+  for (int i = 0; i < rtl_pulses->num_pulses; i++) {
+    alogprintf(LOG_INFO, "+%d", pulse_data_pulse(rtl_pulses, i));
+    alogprintf(LOG_INFO, "-%d", pulse_data_gap(rtl_pulses, i));
 #  ifdef SIGNAL_RSSI
-      alogprintf(LOG_INFO, "(%d)", rtl_pulses->rssi[i]);
+    alogprintf(LOG_INFO, "(%d)", rtl_pulses->rssi[i]);
 #  endif
-    }
-    alogprintfLn(LOG_INFO, " ");
+  }
+  alogprintfLn(LOG_INFO, " ");
 #endif
 #ifdef MEMORY_DEBUG
-    logprintfLn(LOG_INFO, "Pre run_%s_demods: %d", rtl_433_ESP::ookModulation ? "OOK" : "FSK", ESP.getFreeHeap());
+  logprintfLn(LOG_INFO, "Pre run_%s_demods: %d", rtl_pulses->fskModulation ? "FSK" : "OOK", ESP.getFreeHeap());
 #endif
-    rtl_pulses->sample_rate = 1.0e6;
-    r_cfg_t* cfg = &g_cfg;
-    cfg->demod->pulse_data = *rtl_pulses;
-    int events = 0;
-
-    if (rtl_433_ESP::ookModulation) {
-      events = run_ook_demods(&cfg->demod->r_devs, rtl_pulses);
-    } else {
-      events = run_fsk_demods(&cfg->demod->r_devs, rtl_pulses);
-    }
-    if (events == 0) {
+  rtl_pulses->sample_rate = 1.0e6;
+  // messages are built in the arena of ctx and released after their callback
+  data_arena_t* previousArena = data_arena_use(&ctx->arena);
+  r_cfg_t* cfg = &g_cfg;
+  cfg->demod->pulse_data = *rtl_pulses;
+  rtl_433_LatencyTrain = rtl_pulses;
+  unsigned long decodeStart = micros();
+  int events = runDemods(ctx, rtl_pulses);
+  unsigned long decodeTime = micros() - decodeStart;
+  rtl_433_DecodeTime.count++;
+  rtl_433_DecodeTime.total += decodeTime;
+  if (decodeTime > rtl_433_DecodeTime.max) {
+    rtl_433_DecodeTime.max = decodeTime;
+  }
+  rtl_433_LatencyTrain = NULL;
+  if (events == 0) {
 #ifdef RTL_ANALYZER
-      pulse_analyzer(rtl_pulses, rtl_433_ESP::ookModulation ? 1 : 2);
+    pulse_analyzer(rtl_pulses, rtl_pulses->fskModulation ? 2 : 1);
 #endif
-      rtl_433_ESP::unparsedSignals++;
+    rtl_433_ESP::unparsedSignals++;
 #ifdef PUBLISH_UNPARSED
-      logprintf(LOG_INFO, "Unparsed Signal length: %lu",
-                rtl_pulses->signalDuration);
-      alogprintf(LOG_INFO, ", Signal RSSI: %d", rtl_pulses->signalRssi);
-      //      alogprintf(LOG_INFO, ", train: %d", _actualPulseTrain);
-      //      alogprintf(LOG_INFO, ", messageCount: %d", messageCount);
-      alogprintfLn(LOG_INFO, ", pulses: %d", rtl_pulses->num_pulses);
-
-      logprintf(LOG_INFO, "RAW (%lu): ", rtl_pulses->signalDuration);
+    logprintf(LOG_INFO, "Unparsed Signal length: %lu",
+              rtl_pulses->signalDuration);
+    alogprintf(LOG_INFO, ", Signal RSSI: %d", rtl_pulses->signalRssi);
+    //      alogprintf(LOG_INFO, ", train: %d", _actualPulseTrain);
+    //      alogprintf(LOG_INFO, ", messageCount: %d", messageCount);
+    alogprintfLn(LOG_INFO, ", pulses: %d", rtl_pulses->num_pulses);
+
+    logprintf(LOG_INFO, "RAW (%lu): ", rtl_pulses->signalDuration);
 #  ifndef RAW_SIGNAL_DEBUG
-      for (int i = 0; i < rtl_pulses->num_pulses; i++) {
-        alogprintf(LOG_INFO, "+%d", rtl_pulses->pulse[i]);
-        alogprintf(LOG_INFO, "-%d", rtl_pulses->gap[i]);
+    for (int i = 0; i < rtl_pulses->num_pulses; i++) {
+      alogprintf(LOG_INFO, "+%d", pulse_data_pulse(rtl_pulses, i));
+      alogprintf(LOG_INFO, "-%d", pulse_data_gap(rtl_pulses, i));
 #    ifdef SIGNAL_RSSI
-        alogprintf(LOG_INFO, "(%d)", rtl_pulses->rssi[i]);
+      alogprintf(LOG_INFO, "(%d)", rtl_pulses->rssi[i]);
 #    endif
-      }
-      alogprintfLn(LOG_INFO, " ");
+    }
+    alogprintfLn(LOG_INFO, " ");
 #  endif
 
-      // Send a note saying unparsed signal signal received
-      data_t* data;
-      /* clang-format off */
-  data = data_make(
+    // Send a note saying unparsed signal signal received
+    data_t* data;
+    /* clang-format off */
+    data = data_make(
                 "model", "",      DATA_STRING,  "undecoded signal",
                 "protocol", "",   DATA_STRING,  "signal parsing failed",
                 "duration", "",   DATA_INT,     rtl_pulses->signalDuration,
@@ -526,55 +998,133 @@ void rtl_433_DecoderTask(void* pvParameters) {
 //                "currentRssi", "", DATA_INT,    currentRssi,
 //                "rssiThreshold", "", DATA_INT,    rssiThreshold,
                 NULL);
-      /* clang-format on */
+    /* clang-format on */
 
-      r_cfg_t* cfg = &g_cfg;
-      data_print_jsons(data, cfg->messageBuffer, cfg->bufferSize);
-      (cfg->callback)(cfg->messageBuffer);
-      data_free(data);
+    r_output_message(&g_cfg, data);
+    data_free(data);
 
 #endif
-    }
+  }
 
 #ifdef MEMORY_DEBUG
-    logprintfLn(LOG_INFO, "Signal processing time: %lu",
-                micros() - signalProcessingStart);
-    logprintfLn(LOG_INFO, "Post run_ook_demods memory %d", ESP.getFreeHeap());
+  logprintfLn(LOG_INFO, "Signal processing time: %lu",
+              micros() - signalProcessingStart);
+  logprintfLn(LOG_INFO, "Post run_ook_demods memory %d", ESP.getFreeHeap());
 #endif
 #ifdef DEMOD_DEBUG
-    logprintfLn(LOG_INFO, "# of messages decoded %d", events);
+  logprintfLn(LOG_INFO, "# of messages decoded %d", events);
 #endif
-    if (events > 0) {
-      // alogprintfLn(LOG_INFO, " ");
-    }
+  data_arena_use(previousArena);
+  data_arena_reset(&ctx->arena);
+  if (events > 0) {
+    // alogprintfLn(LOG_INFO, " ");
+  }
 #if defined(MEMORY_DEBUG)
-    else {
-      logprintfLn(LOG_DEBUG, "Process rtl_433_DecoderTask stack free: %u",
-                  uxTaskGetStackHighWaterMark(rtl_433_DecoderHandle));
-      alogprintfLn(LOG_INFO, " ");
-    }
-#endif
-#ifdef MEMORY_DEBUG
-    logprintfLn(LOG_INFO, "Pre free rtl_433_DecoderTask: %d",
-                ESP.getFreeHeap());
+  else {
+    logprintfLn(LOG_DEBUG, "Process rtl_433_DecoderTask stack free: %u",
+                uxTaskGetStackHighWaterMark(rtl_433_DecoderHandle));
+    alogprintfLn(LOG_INFO, " ");
+  }
 #endif
-    free(rtl_pulses);
+  return events;
+}
+
+void rtl_433_DecoderTask(void* pvParameters) {
+  decode_ctx_t* ctx = (decode_ctx_t*)pvParameters;
+  uint8_t train;
+  for (;;) {
+    // logprintfLn(LOG_DEBUG, "rtl_433_DecoderTask awaiting signal");
+    xQueueReceive(rtl_433_Queue, &train, portMAX_DELAY);
+    // logprintfLn(LOG_DEBUG, "rtl_433_DecoderTask signal received");
+    xSemaphoreTake(rtl_433_DecoderLock, portMAX_DELAY);
+    decodeSignal(ctx, &rtl_433_PulseTrains[train]);
+    xSemaphoreGive(rtl_433_DecoderLock);
+    releasePulseTrain(train);
+    rtl_433_DecodedSignals++;
 #ifdef MEMORY_DEBUG
-    logprintfLn(LOG_INFO, "Post free rtl_433_DecoderTask: %d",
-                ESP.getFreeHeap());
     logprintfLn(LOG_INFO, "rtl_433_DecoderTask uxTaskGetStackHighWaterMark: %d",
                 uxTaskGetStackHighWaterMark(NULL));
 #endif
   }
 }
 
-void processSignal(pulse_data_t* rtl_pulses) {
+/**
+ * Take the pulse train to shed for a new signal of strength rssi off
+ * rtl_433_Queue, as rtl_433_ShedPolicy says. -1 to shed the new signal.
+ */
+static int shedQueuedTrain(int rssi) {
+  uint8_t train;
+  switch (rtl_433_ShedPolicy) {
+    case SHED_DROP_OLDEST:
+      if (xQueueReceive(rtl_433_Queue, &train, 0) == pdTRUE) {
+        return train;
+      }
+      return -1;
+    case SHED_KEEP_STRONGEST: {
+      // empty the queue, and put back all but the weakest in order
+      uint8_t queued[RECEIVER_BUFFER_MAX];
+      int count = 0;
+      int weakest = -1;
+      while (count < RECEIVER_BUFFER_MAX &&
+             xQueueReceive(rtl_433_Queue, &queued[count], 0) == pdTRUE) {
+        if (weakest < 0 || rtl_433_PulseTrains[queued[count]].signalRssi <
+                               rtl_433_PulseTrains[queued[weakest]].signalRssi) {
+          weakest = count;
+        }
+        count++;
+      }
+      if (weakest >= 0 && rtl_433_PulseTrains[queued[weakest]].signalRssi >= rssi) {
+        weakest = -1; // the new signal is the weakest
+      }
+      for (int i = 0; i < count; i++) {
+        if (i != weakest) {
+          xQueueSend(rtl_433_Queue, &queued[i], 0);
+        }
+      }
+      return weakest >= 0 ? queued[weakest] : -1;
+    }
+    default:
+      return -1;
+  }
+}
+
+/**
+ * Free pulse train for a signal starting with strength rssi, or one shed from
+ * rtl_433_Queue. -1 if the new signal is shed.
+ */
+int acquirePulseTrain(int rssi) {
+  uint8_t train;
+  if (xQueueReceive(rtl_433_FreeQueue, &train, 0) == pdTRUE) {
+    return train;
+  }
+  int shed = shedQueuedTrain(rssi);
+  if (shed < 0) {
+    rtl_433_DroppedSignals++;
+  } else {
+    rtl_433_OverwrittenSignals++;
+  }
+  return shed;
+}
+
+void releasePulseTrain(uint8_t train) {
+  xQueueSend(rtl_433_FreeQueue, &train, 0);
+}
+
+void processSignal(uint8_t train) {
   // logprintfLn(LOG_DEBUG, "processSignal() about to place signal on
   // rtl_433_Queue");
-  if (xQueueSend(rtl_433_Queue, &rtl_pulses, 0) != pdTRUE) {
-    logprintfLn(LOG_ERR, "ERROR: rtl_433_Queue full, discarding signal");
-    free(rtl_pulses);
-  } else {
-    // logprintfLn(LOG_DEBUG, "processSignal() signal placed on rtl_433_Queue");
+  if (xQueueSend(rtl_433_Queue, &train, 0) != pdTRUE) {
+    int shed = shedQueuedTrain(rtl_433_PulseTrains[train].signalRssi);
+    if (shed < 0) {
+      logprintfLn(LOG_ERR, "ERROR: rtl_433_Queue full, discarding signal");
+      releasePulseTrain(train);
+      rtl_433_DroppedSignals++;
+      return;
+    }
+    releasePulseTrain(shed);
+    rtl_433_OverwrittenSignals++;
+    xQueueSend(rtl_433_Queue, &train, 0); // room made, the receiver is the only sender
   }
+  // logprintfLn(LOG_DEBUG, "processSignal() signal placed on rtl_433_Queue");
+  rtl_433_QueuedSignals++;
 }
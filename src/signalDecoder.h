@@ -30,9 +30,11 @@
 
 extern "C" {
 #include "bitbuffer.h"
+#include "decode_ctx.h"
 #include "fatal.h"
 #include "list.h"
 #include "pulse_analyzer.h"
+#include "pulse_classifier.h"
 #include "pulse_detect.h"
 #include "r_api.h"
 #include "r_private.h"
@@ -43,14 +45,45 @@ extern "C" {
 #include "log.h"
 #include "tools/aprintf.h"
 
+/**
+ * Count, total and maximum of a time in microseconds, see
+ * rtl_433_DecodeLatency and rtl_433_DecodeTime
+ */
+typedef struct {
+  unsigned long count; // decoded pulse trains
+  unsigned long total;
+  unsigned long max;
+} decodeLatency_t;
+
 /*----------------------------- functions -----------------------------*/
 
 void rtlSetup();
 void _setCallback(rtl_433_ESPCallBack callback, char* messageBuffer,
                   int bufferSize);
+void _setCallback(rtl_433_ESPBinaryCallBack callback, uint8_t* messageBuffer,
+                  int bufferSize);
 void _setDebug(int debug);
-void processSignal(pulse_data_t* rtl_pulses);
+int acquirePulseTrain(int rssi);
+void releasePulseTrain(uint8_t train);
+void processSignal(uint8_t train);
+int decodeSignal(decode_ctx_t* ctx, pulse_data_t* rtl_pulses);
 void rtl_433_DecoderTask(void* pvParameters);
 extern TaskHandle_t rtl_433_DecoderHandle;
+extern pulse_data_t* rtl_433_PulseTrains;
+extern r_cfg_t g_cfg;
+extern decode_ctx_t* rtl_433_DecodeCtx;
+extern decodeLatency_t rtl_433_DecodeLatency;
+extern decodeLatency_t rtl_433_DecodeTime;
+extern volatile unsigned long rtl_433_QueuedSignals;
+extern volatile unsigned long rtl_433_DecodedSignals;
+extern volatile unsigned long rtl_433_OverwrittenSignals;
+extern volatile unsigned long rtl_433_DroppedSignals;
+extern uint8_t rtl_433_ReceiverBuffers;
+extern uint8_t rtl_433_QueueDepth;
+extern volatile uint8_t rtl_433_ShedPolicy;
+void getDecoderStats(pulse_classifier_stats_t* stats);
+#ifdef PARALLEL_DECODE
+extern TaskHandle_t rtl_433_HelperHandle;
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+*/
+
+#include "signalGate.h"
+
+SignalGate::SignalGate(int rssiThreshold, uint32_t holdover,
+                       uint32_t holdoverAfter, uint32_t minSignalLength,
+                       int minPulses)
+    : rssiThreshold(rssiThreshold),
+      holdover(holdover),
+      holdoverAfter(holdoverAfter),
+      minSignalLength(minSignalLength),
+      minPulses(minPulses),
+      _receiving(false),
+      _signalStart(0),
+      _signalEnd(0),
+      _signalRssi(0) {}
+
+void SignalGate::reset(uint32_t time) {
+  _receiving = false;
+  _signalStart = time;
+}
+
+SignalGate::Decision SignalGate::update(uint32_t time, int rssi, int pulses) {
+  if (rssi > rssiThreshold) { // A signal is present
+    _signalEnd = time;
+    if (!_receiving) {
+      _receiving = true;
+      _signalStart = time;
+      _signalRssi = rssi;
+      return START;
+    }
+    return NONE;
+  }
+  if (time - _signalEnd < holdover && time - _signalStart > holdoverAfter) {
+    return NONE; // skip over signal drop outs
+  }
+  if (!_receiving) {
+    return NONE;
+  }
+  _receiving = false; // Complete reception of a signal
+  if (pulses > minPulses && signalLength() > minSignalLength) {
+    return COMMIT;
+  }
+  return DISCARD;
+}
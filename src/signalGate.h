@@ -0,0 +1,95 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  signalGate - start and end of signal decisions from the signal strength
+
+  The receiver task feeds the gate the time, the RSSI and the pulses received
+  so far on every tick. The gate starts a signal when the RSSI crosses the
+  threshold, holds it over short drops in strength, and decides at the end
+  whether the pulse train is committed to the decoder or discarded. It does
+  not depend on the Arduino core, see host/gate_bench.cpp.
+
+*/
+
+#ifndef rtl_433_SIGNALGATE_H
+#define rtl_433_SIGNALGATE_H
+
+#include <stdint.h>
+
+class SignalGate {
+public:
+  enum Decision {
+    NONE, ///< nothing changed
+    START, ///< a signal started, receive its edges into a pulse train
+    COMMIT, ///< the signal ended, pass the pulse train to the decoder
+    DISCARD, ///< the signal ended, too short or too few pulses to decode
+  };
+
+  SignalGate(int rssiThreshold, uint32_t holdover, uint32_t holdoverAfter,
+             uint32_t minSignalLength, int minPulses);
+
+  /**
+   * One receiver tick, time in microseconds, pulses the pulses received
+   * since START
+   */
+  Decision update(uint32_t time, int rssi, int pulses);
+
+  /**
+   * Drop the current signal, time is the new start of signal
+   */
+  void reset(uint32_t time);
+
+  bool receiving() const { return _receiving; }
+  uint32_t signalStart() const { return _signalStart; }
+  /**
+   * Time of the most recent tick above the threshold
+   */
+  uint32_t signalEnd() const { return _signalEnd; }
+  uint32_t signalLength() const { return _signalEnd - _signalStart; }
+  /**
+   * RSSI at the start of the signal
+   */
+  int signalRssi() const { return _signalRssi; }
+
+  /**
+   * A signal is present above this RSSI
+   */
+  int rssiThreshold;
+  /**
+   * A signal ends once the RSSI is below the threshold for this long
+   */
+  uint32_t holdover;
+  /**
+   * Drops in strength are only held over once the signal is this long
+   */
+  uint32_t holdoverAfter;
+  /**
+   * Shorter signals are discarded
+   */
+  uint32_t minSignalLength;
+  /**
+   * Signals with this many pulses or fewer are discarded
+   */
+  int minPulses;
+
+private:
+  bool _receiving;
+  uint32_t _signalStart;
+  uint32_t _signalEnd;
+  int _signalRssi;
+};
+
+#endif
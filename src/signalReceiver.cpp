@@ -0,0 +1,410 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+
+  signalReceiver - edges from the EdgeSource to pulse trains for the decoder
+
+  The receiver task watches the signal strength of the EdgeSource to find the
+  start and end of each signal, and assembles the edges of a signal into a
+  pulse train for the decoder task. Times are in the time base of the source,
+  with a timed source the receiver runs in virtual time.
+
+*/
+
+#include "signalReceiver.h"
+
+#include "modulationScheduler.h"
+#include "pulseAssembler.h"
+#include "signalDecoder.h"
+#include "signalGate.h"
+
+#if defined(RF_SX1276) || defined(RF_SX1278)
+// If we received a signal but had a minor drop in strength keep the
+// receiver running for an additional MINIMUM_SIGNAL_LENGTH
+#  define SIGNAL_HOLDOVER_AFTER 0
+#else
+// If we received a signal but had a minor drop in strength keep the
+// receiver running for an additional MINIMUM_SIGNAL_LENGTH, once the signal
+// is longer than 30,000
+#  define SIGNAL_HOLDOVER_AFTER 30000
+#endif
+
+/*----------------------------- Initialize variables -----------------------------*/
+
+bool receiveMode = false;
+
+/**
+ * Source time for end of most recent message aka start of current gap
+ */
+static uint32_t gapStart = 0;
+
+/**
+ * Start and end of signal from the RSSI
+ */
+static SignalGate signalGate(MINRSSI, MINIMUM_SIGNAL_LENGTH,
+                             SIGNAL_HOLDOVER_AFTER, MINIMUM_SIGNAL_LENGTH,
+                             PD_MIN_PULSES);
+
+/**
+ * OOK and FSK windows of reception with DUAL_MODULATION
+ */
+static ModulationScheduler modulationScheduler(DUAL_MODULATION ? OOK_WINDOW * 1000UL : 0,
+                                               DUAL_MODULATION ? FSK_WINDOW * 1000UL : 0);
+
+bool rtl_433_ESP::ookModulation = OOK_MODULATION; // Defaults to true
+bool rtl_433_ESP::dualModulation = DUAL_MODULATION;
+int rtl_433_ESP::messageCount = 0;
+int rtl_433_ESP::currentRssi = 0;
+int rtl_433_ESP::signalRssi = 0;
+int rtl_433_ESP::rssiThreshold = MINRSSI;
+bool rtl_433_ESP::_enabledReceiver = false;
+volatile int8_t rtl_433_ESP::_actualPulseTrain = -1;
+EdgeSource* rtl_433_ESP::_source = nullptr;
+
+/**
+ * Edges of the signal being received, pushed by receiveEdge and assembled
+ * into the pulse train by the receiver task
+ */
+static EdgeRing<EDGE_RING_SIZE> edgeRing;
+static PulseAssembler pulseAssembler(MINIMUM_PULSE_LENGTH);
+
+// Variables for OOK Threshold auto calibrate function
+
+int rtl_433_ESP::totalSignals = 0;
+int rtl_433_ESP::ignoredSignals = 0;
+int rtl_433_ESP::unparsedSignals = 0;
+
+// RSSI Threshold and average calculation
+
+int rtl_433_ESP::averageRssi = 0;
+int rtl_433_ESP::rssiThresholdDelta = RSSI_THRESHOLD;
+
+// The noise floor differs with the receiver bandwidth, one for each modulation
+#if NOISE_FLOOR == NOISE_FLOOR_BLOCK
+static BlockAverageNoiseFloor ookNoiseFloor(RSSI_SAMPLES), fskNoiseFloor(RSSI_SAMPLES);
+#elif NOISE_FLOOR == NOISE_FLOOR_EWMA
+static EwmaNoiseFloor ookNoiseFloor, fskNoiseFloor;
+#elif NOISE_FLOOR == NOISE_FLOOR_QUANTILE
+static QuantileNoiseFloor ookNoiseFloor, fskNoiseFloor;
+#else
+static MinNoiseFloor ookNoiseFloor, fskNoiseFloor;
+#endif
+NoiseFloor* rtl_433_ESP::_noiseFloor = nullptr; // nullptr for the NOISE_FLOOR ones
+
+int _rssiCount = 0;
+
+int _noiseCount = 0; // Count of edges while not receiving a signal
+
+/*----------------------------- End of variable initialization -----------------------------*/
+
+int receivedPulses() {
+  return pulseAssembler.pulses();
+}
+
+uint32_t gapLength() {
+  return signalGate.signalStart() - gapStart;
+}
+
+unsigned long modulationSwitches() {
+  return modulationScheduler.switches();
+}
+
+/**
+ * Signal and pulse lengths of the modulation the receiver is tuned to
+ */
+static void applyModulation(bool ook) {
+  signalGate.holdover = ook ? OOK_MINIMUM_SIGNAL_LENGTH : FSK_MINIMUM_SIGNAL_LENGTH;
+  signalGate.minSignalLength = signalGate.holdover;
+  pulseAssembler.setMinPulseLength(ook ? OOK_MINIMUM_PULSE_LENGTH : FSK_MINIMUM_PULSE_LENGTH);
+}
+
+/**
+ * @brief Main pulse receiver logic, edges are queued for the receiver task
+ * 
+ */
+void ICACHE_RAM_ATTR rtl_433_ESP::receiveEdge(uint32_t time, bool level) {
+  if (!_enabledReceiver || !receiveMode) {
+    _noiseCount++;
+    return;
+  }
+  edgeRing.push(time, level);
+}
+
+/**
+ * @brief Assemble the queued edges into the pulse train
+ * 
+ */
+void rtl_433_ESP::drainEdges() {
+#ifdef RF_CC1101
+  pulseAssembler.drain(edgeRing, currentRssi, currentRssi > rssiThreshold);
+#else
+  pulseAssembler.drain(edgeRing, currentRssi); // SX127X RSSI Value drops for a 0 value,
+  // and the OOK floor compensates for this
+#endif
+}
+
+/**
+ * @brief Reset received signal storage
+ * 
+ */
+void rtl_433_ESP::resetReceiver() {
+  receiveMode = false;
+  if (_actualPulseTrain >= 0) {
+    releasePulseTrain(_actualPulseTrain);
+    _actualPulseTrain = -1;
+  }
+  edgeRing.clear();
+
+  const uint32_t now = _source ? _source->now() : 0;
+  signalGate.reset(now);
+  applyModulation(ookModulation);
+  modulationScheduler.reset(now, ookModulation);
+}
+
+/**
+ * @brief Replace the source of edges and signal strength, the receiver GPIO
+ * and radio RSSI unless set before initReceiver
+ * 
+ * @param source 
+ */
+void rtl_433_ESP::setEdgeSource(EdgeSource* source) {
+  bool enabled = _enabledReceiver;
+  if (enabled) {
+    disableReceiver();
+  }
+  _source = source;
+  resetReceiver();
+  if (enabled) {
+    enableReceiver();
+  }
+}
+
+/**
+ * @brief Replace the noise floor estimator, nullptr for the NOISE_FLOOR one
+ * 
+ * @param estimator 
+ */
+void rtl_433_ESP::setNoiseFloor(NoiseFloor* estimator) {
+  _noiseFloor = estimator;
+}
+
+/**
+ * @brief Set the number of pulse trains and the decoder queue depth, before
+ * initReceiver allocates them
+ * 
+ * @param trains 
+ * @param queueDepth 
+ */
+void rtl_433_ESP::setReceiverBuffers(int trains, int queueDepth) {
+  if (rtl_433_PulseTrains) {
+    logprintfLn(LOG_ERR, "ERROR: setReceiverBuffers after initReceiver, ignored");
+    return;
+  }
+  rtl_433_ReceiverBuffers = trains < 1 ? 1 : trains > RECEIVER_BUFFER_MAX ? RECEIVER_BUFFER_MAX : trains;
+  rtl_433_QueueDepth = queueDepth < 1 || queueDepth > rtl_433_ReceiverBuffers
+                           ? rtl_433_ReceiverBuffers
+                           : queueDepth;
+}
+
+/**
+ * @brief Select the signal shed when the pulse trains or the decoder queue
+ * are full
+ * 
+ * @param policy SHED_DROP_NEWEST, SHED_DROP_OLDEST or SHED_KEEP_STRONGEST
+ */
+void rtl_433_ESP::setShedPolicy(int policy) {
+  rtl_433_ShedPolicy = policy;
+}
+
+/**
+ * @brief Alternate the receiver between OOK and FSK reception
+ * 
+ * @param ookMillis OOK window, 0 for no OOK reception
+ * @param fskMillis FSK window, 0 for no FSK reception
+ */
+void rtl_433_ESP::setModulationSchedule(uint32_t ookMillis, uint32_t fskMillis) {
+  if (!dualModulation && (ookModulation ? fskMillis : ookMillis)) {
+    logprintfLn(LOG_ERR, "ERROR: setModulationSchedule, the %s decoders need dualModulation",
+                ookModulation ? "FSK" : "OOK");
+    return;
+  }
+  modulationScheduler.ookWindow = ookMillis * 1000UL;
+  modulationScheduler.fskWindow = fskMillis * 1000UL;
+}
+
+/**
+ * @brief Enable signal receiver logic
+ * 
+ */
+void rtl_433_ESP::enableReceiver() {
+  if (_source) {
+    _source->begin(receiveEdge);
+    _enabledReceiver = true;
+  }
+}
+
+/**
+ * @brief Disable receiver logic, and pulse receiver
+ * 
+ */
+void rtl_433_ESP::disableReceiver() {
+  _enabledReceiver = false;
+  if (_source) {
+    _source->end();
+  }
+}
+
+/**
+ * @brief Monitor RSSI signal level and start / end signal receiving, one tick
+ * of the receiver task
+ * 
+ */
+void rtl_433_ESP::receiverTick() {
+  if (_enabledReceiver) {
+    _source->poll();
+    const uint32_t now = _source->now();
+
+    // Estimate the RSSI noise floor in environment
+
+    currentRssi = _source->rssi();
+    if (receiveMode) {
+      drainEdges();
+    }
+    NoiseFloor* noiseFloor = _noiseFloor ? _noiseFloor
+                             : ookModulation ? (NoiseFloor*)&ookNoiseFloor
+                                             : &fskNoiseFloor;
+    noiseFloor->add(currentRssi);
+
+    if (noiseFloor->ready()) // Adjust RSSI Signal Threshold
+    {
+      averageRssi = noiseFloor->estimate();
+#ifdef AUTORSSITHRESHOLD
+      rssiThreshold = averageRssi + rssiThresholdDelta;
+#endif
+    }
+    if (++_rssiCount > RSSI_SAMPLES) {
+      logprintfLn(LOG_DEBUG,
+                  "Average RSSI Signal %d dbm, adjusted RSSI Threshold %d, "
+                  "estimator %s",
+                  averageRssi, rssiThreshold, noiseFloor->name());
+      _rssiCount = 0;
+    }
+
+    if (modulationScheduler.update(now, signalGate.receiving())) {
+      // between signals, edges from the retune are dropped
+      if (modulationScheduler.ook() ? setOOKModulation() : setFSKModulation()) {
+        applyModulation(ookModulation);
+      }
+      edgeRing.clear();
+      signalGate.reset(now);
+    }
+
+    signalGate.rssiThreshold = rssiThreshold;
+    SignalGate::Decision decision =
+        signalGate.update(now, currentRssi, pulseAssembler.pulses());
+    if (decision == SignalGate::START) {
+      if (_actualPulseTrain < 0) {
+        // -1 if all are waiting for the decoder and the new signal is shed
+        _actualPulseTrain = acquirePulseTrain(currentRssi);
+      }
+      if (_actualPulseTrain >= 0) {
+        edgeRing.clear();
+        pulseAssembler.start(&rtl_433_PulseTrains[_actualPulseTrain], now);
+        receiveMode = true;
+#ifdef ONBOARD_LED
+        digitalWrite(ONBOARD_LED, HIGH);
+#endif
+        signalRssi = currentRssi;
+
+        if (_noiseCount > 100) {
+#if defined(AUTOOOKFIX) && (defined(RF_SX1276) || defined(RF_SX1278))
+          raiseOokFixedThreshold();
+#endif
+          _noiseCount = 0;
+        }
+      }
+    } else if (decision != SignalGate::NONE && _actualPulseTrain < 0) {
+      // End of a signal shed at its start, nothing was received
+    } else if (decision != SignalGate::NONE) // Complete reception of a signal
+    {
+#ifdef ONBOARD_LED
+      digitalWrite(ONBOARD_LED, LOW);
+#endif
+      receiveMode = false;
+      drainEdges();
+      int nrpulses = pulseAssembler.pulses();
+      const uint32_t signalStart = signalGate.signalStart();
+      const uint32_t signalEnd = signalGate.signalEnd();
+      totalSignals++;
+      if (decision == SignalGate::COMMIT) // Minimum signal length of MINIMUM_SIGNAL_LENGTH MS and PD_MIN_PULSES
+      {
+        pulse_data_t* pulseTrain = &rtl_433_PulseTrains[_actualPulseTrain];
+        pulseTrain->num_pulses = nrpulses + 1;
+        pulseTrain->signalDuration = signalEnd - signalStart;
+        pulseTrain->signalEnd = micros() - (now - signalEnd); // latency in micros()
+        pulseTrain->signalRssi = signalRssi;
+        pulseTrain->fskModulation = !ookModulation;
+#ifdef DEMOD_DEBUG
+        logprintf(LOG_INFO, "Signal length: %lu",
+                  pulseTrain->signalDuration);
+        alogprintf(LOG_INFO, ", Gap length: %lu", signalStart - gapStart);
+        alogprintf(LOG_INFO, ", Signal RSSI: %d",
+                   pulseTrain->signalRssi);
+        alogprintf(LOG_INFO, ", train: %d", _actualPulseTrain);
+        alogprintf(LOG_INFO, ", messageCount: %d", messageCount);
+        alogprintfLn(LOG_INFO, ", pulses: %d", nrpulses);
+#endif
+        messageCount++;
+        gapStart = now;
+        processSignal(_actualPulseTrain); // send received signal for decoding
+        _actualPulseTrain = -1;
+      } else {
+        ignoredSignals++;
+#ifdef DEMOD_DEBUG
+        if (now - signalStart > 1000) {
+          logprintf(LOG_INFO, "Ignored Signal length: %lu",
+                    signalEnd - signalStart);
+
+          alogprintf(LOG_INFO, ", Time since last bit length: %lu",
+                     now - signalEnd);
+          alogprintf(LOG_INFO, ", Gap length: %lu", signalStart - gapStart);
+          alogprintf(LOG_INFO, ", Signal RSSI: %d", signalRssi);
+          alogprintf(LOG_INFO, ", Current RSSI: %d", currentRssi);
+          alogprintf(LOG_INFO, ", pulses: %d", nrpulses);
+          alogprintfLn(LOG_INFO, ", noise count: %d", _noiseCount);
+          gapStart = now;
+        }
+#endif
+      }
+#ifdef MEMORY_DEBUG
+      logprintfLn(LOG_INFO,
+                  "rtl_433_ReceiverTask uxTaskGetStackHighWaterMark: %d", uxTaskGetStackHighWaterMark(NULL));
+#endif
+    }
+  }
+}
+
+/**
+ * @brief Background task to monitor RSSI signal level and start / end signal receiving
+ * 
+ * @param pvParameters 
+ */
+void rtl_433_ESP::rtl_433_ReceiverTask(void* pvParameters) {
+  for (;;) {
+    receiverTick();
+    vTaskDelay(1);
+  }
+}
+
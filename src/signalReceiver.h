@@ -0,0 +1,54 @@
+/*
+  rtl_433_ESP - 433.92 MHz protocols library for ESP32
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with library. If not, see <http://www.gnu.org/licenses/>
+
+*/
+
+#ifndef rtl_433_SIGNALRECEIVER_H
+#define rtl_433_SIGNALRECEIVER_H
+
+#include "edgeSource.h"
+#include "rtl_433_ESP.h"
+
+/*----------------------------- variables -----------------------------*/
+
+/**
+ * Is the receiver currently receiving a signal
+ */
+extern bool receiveMode;
+
+/**
+ * Edges received while no signal is received
+ */
+extern int _noiseCount;
+
+/*----------------------------- functions -----------------------------*/
+
+/**
+ * Pulses assembled into the current pulse train
+ */
+int receivedPulses();
+
+/**
+ * Time between the end of the most recent message and the start of the
+ * current signal
+ */
+uint32_t gapLength();
+
+/**
+ * Retunes between OOK and FSK by the modulation schedule
+ */
+unsigned long modulationSwitches();
+
+#endif
@@ -36,11 +36,10 @@ echo "Contrib decoders updated"
 
 # remove non-functional device decoders
 
-# device decoders that place a bitbuffer_t on the stack is causing an overflow or large memory usage
+# device decoders that place a bitbuffer_t on the stack cause an overflow of the decoder task stack
 # ie bitbuffer_t databits = {0};
 # ie blueline.c - approx 64000 bytes of memory used
-
-# newkaku.c nexa.c proove.c cavius.c current_cost.c ge_coloreffects.c insteon.c m_bus.c oil_standard.c oil_watchman.c tpms_abarth124.c tpms_citroen.c tpms_elantra2012.c tpms_ford.c tpms_jansite.c tpms_jansite_solar.c tpms_pmv107j.c tpms_renault.c tpms_toyota.c
+# the copies in contrib borrow it instead, ie bitbuffer_t *databits = decoder_scratch_bitbuffer(0);
 
 for i in blueline.c secplus_v2.c
 do
@@ -49,6 +48,14 @@ done
 
 echo "Problematic decoders removed"
 
+for i in `cd ../src/rtl_433/devices ; egrep -l "bitbuffer_t [a-z_]+ *= *\{ *0 *\};" *.c`
+do
+    if [ ! -f ../contrib/$i ]
+    then
+        echo "Please move the stack bitbuffer of "$i" to decoder_scratch_bitbuffer() in contrib"
+    fi
+done
+
 # create include/rtl_433_devices.h
 
 ( cd ../src/rtl_433/devices ; egrep "\.name|\.modulation|\.decode_fn|^r_device " *.c ) > devices.list
@@ -71,25 +78,26 @@ cat rtl_433_devices.pre rtl_433_devices.fragment rtl_433_devices.post > ../inclu
 
 echo "rtl_433_devices.h created"
 
-# create src/decoder.cpp fragment
+# create src/signalDecoder.cpp fragment, the registry of the decoder descriptors
 
-echo "  // This is a generated fragment from tools/update_rtl_433_devices.sh" > decoder.fragment
+echo "// This is a generated fragment from tools/update_rtl_433_devices.sh" > decoder.fragment
 
 echo "" >> decoder.fragment
 
-echo "if (rtl_433_ESP::ookModulation) {" >> decoder.fragment
+echo "static constexpr r_device const* rtl_433_Devices[] = {" >> decoder.fragment
+echo "    // OOK" >> decoder.fragment
 
 cat devices.list | awk -f device.awk | egrep ${OOK_MODULATION} | awk -F\" '{ print $3 }' | \
-    awk -F, '{ print $3 }' | awk '{ print "  memcpy(&cfg->devices["NR-1"], &"$1", sizeof(r_device));" }' >> decoder.fragment
+    awk -F, '{ print $3 }' | awk '{ print "    &"$1"," }' >> decoder.fragment
 
-echo "} else {" >> decoder.fragment
+echo "    // FSK" >> decoder.fragment
 
 cat devices.list | awk -f device.awk | egrep ${FSK_MODULATION} | awk -F\" '{ print $3 }' | \
-    awk -F, '{ print $3 }' | awk '{ print "  memcpy(&cfg->devices["NR-1"], &"$1", sizeof(r_device));" }' >> decoder.fragment
+    awk -F, '{ print $3 }' | awk '{ print "    &"$1"," }' >> decoder.fragment
 
-echo "}" >> decoder.fragment
+echo "};" >> decoder.fragment
 echo "" >> decoder.fragment
-echo "  // end of fragment" >> decoder.fragment
+echo "// end of fragment" >> decoder.fragment
 
 echo
 echo "Please update src/signalDecoder.cpp with decoder.fragment"